@@ -0,0 +1,52 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmArena.h"
+
+#include <cstdint>
+
+namespace {
+char* AlignUp(char* p, std::size_t align)
+{
+  std::uintptr_t const u = reinterpret_cast<std::uintptr_t>(p);
+  return p + (((u + align - 1) & ~(std::uintptr_t(align) - 1)) - u);
+}
+}
+
+cmArena::cmArena(std::size_t blockSize)
+  : BlockSize(blockSize)
+{
+}
+
+cmArena::~cmArena()
+{
+  for (Cleanup* c = this->Cleanups; c; c = c->Previous) {
+    c->Destroy(c->Object);
+  }
+  while (Block* b = this->Blocks) {
+    this->Blocks = b->Previous;
+    delete[] reinterpret_cast<char*>(b);
+  }
+}
+
+void* cmArena::Allocate(std::size_t size, std::size_t align)
+{
+  char* p = this->Next ? AlignUp(this->Next, align) : nullptr;
+  if (!p || size > static_cast<std::size_t>(this->End - p)) {
+    // Start a new block.  Large requests get a block of their own.
+    std::size_t const header = sizeof(Block) + alignof(std::max_align_t);
+    std::size_t blockSize = header + size + align;
+    if (blockSize < this->BlockSize) {
+      blockSize = this->BlockSize;
+    }
+    char* mem = new char[blockSize];
+    this->BytesReserved += blockSize;
+    Block* b = reinterpret_cast<Block*>(mem);
+    b->Previous = this->Blocks;
+    this->Blocks = b;
+    this->Next = mem + sizeof(Block);
+    this->End = mem + blockSize;
+    p = AlignUp(this->Next, align);
+  }
+  this->Next = p + size;
+  return p;
+}
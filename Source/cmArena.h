@@ -0,0 +1,85 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmArena_h
+#define cmArena_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/** \class cmArena
+ * \brief Monotonic allocator for objects sharing one lifetime.
+ *
+ * Objects are constructed in large blocks and are never freed
+ * individually.  They are destroyed in reverse order of creation,
+ * and their memory released, when the arena is destroyed.  The
+ * bookkeeping lives in the blocks themselves so an arena whose
+ * objects fit in its first block costs a single heap allocation.
+ */
+class cmArena
+{
+public:
+  /** Create an arena whose blocks hold at least the given size.  */
+  explicit cmArena(std::size_t blockSize = 4096);
+  ~cmArena();
+
+  cmArena(cmArena const&) = delete;
+  cmArena& operator=(cmArena const&) = delete;
+
+  /** Construct an object in the arena.  */
+  template <typename T, typename... Args>
+  T* New(Args&&... args)
+  {
+    Cleanup* cleanup = nullptr;
+    if (!std::is_trivially_destructible<T>::value) {
+      cleanup = static_cast<Cleanup*>(
+        this->Allocate(sizeof(Cleanup), alignof(Cleanup)));
+    }
+    T* t = new (this->Allocate(sizeof(T), alignof(T)))
+      T(std::forward<Args>(args)...);
+    if (cleanup) {
+      cleanup->Object = t;
+      cleanup->Destroy = &cmArena::Destroy<T>;
+      cleanup->Previous = this->Cleanups;
+      this->Cleanups = cleanup;
+    }
+    return t;
+  }
+
+  /** Allocate raw memory from the arena.  */
+  void* Allocate(std::size_t size, std::size_t align);
+
+  /** Get the total size of the blocks allocated so far.  */
+  std::size_t GetBytesReserved() const { return this->BytesReserved; }
+
+private:
+  template <typename T>
+  static void Destroy(void* p)
+  {
+    static_cast<T*>(p)->~T();
+  }
+
+  struct Block
+  {
+    Block* Previous;
+  };
+
+  struct Cleanup
+  {
+    void* Object;
+    void (*Destroy)(void*);
+    Cleanup* Previous;
+  };
+
+  std::size_t BlockSize;
+  Block* Blocks = nullptr;
+  char* Next = nullptr;
+  char* End = nullptr;
+  Cleanup* Cleanups = nullptr;
+  std::size_t BytesReserved = 0;
+};
+
+#endif
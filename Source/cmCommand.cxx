@@ -18,13 +18,14 @@ void cmCommand::SetExecutionStatus(cmExecutionStatus* status)
 bool cmCommand::InvokeInitialPass(const std::vector<cmListFileArgument>& args,
                                   cmExecutionStatus& status)
 {
-  std::vector<std::string> expandedArguments;
-  if (!this->Makefile->ExpandArguments(args, expandedArguments)) {
+  std::vector<std::string> const* expandedArguments =
+    this->Makefile->ExpandCommandArguments(args);
+  if (!expandedArguments) {
     // There was an error expanding arguments.  It was already
     // reported, so we can skip this command without error.
     return true;
   }
-  return this->InitialPass(expandedArguments, status);
+  return this->InitialPass(*expandedArguments, status);
 }
 
 void cmCommand::SetError(const std::string& e)
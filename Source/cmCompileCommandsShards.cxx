@@ -0,0 +1,129 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmCompileCommandsShards.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <cm/memory>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmGeneratedFileStream.h"
+#include "cmGeneratorTarget.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+std::string cmCompileCommandsShards::GetShardFile(
+  cmGeneratorTarget const* target)
+{
+  cmLocalGenerator* lg = target->GetLocalGenerator();
+  std::string const& mode =
+    lg->GetMakefile()->GetSafeDefinition(
+      "CMAKE_EXPORT_COMPILE_COMMANDS_SHARDS");
+  if (mode == "DIRECTORY") {
+    return cmStrCat(lg->GetCurrentBinaryDirectory(),
+                    "/CMakeFiles/compile_commands.json");
+  }
+  if (mode == "TARGET") {
+    return cmStrCat(target->GetSupportDirectory(), "/compile_commands.json");
+  }
+  return std::string();
+}
+
+cmCompileCommandsShards::cmCompileCommandsShards() = default;
+
+cmCompileCommandsShards::~cmCompileCommandsShards() = default;
+
+void cmCompileCommandsShards::Add(std::string const& shardFile,
+                                  std::string const& directory,
+                                  std::string const& command,
+                                  std::string const& file)
+{
+  if (shardFile != this->CurrentFile) {
+    this->Close();
+    // The commands of a shard normally come in consecutively.  If a
+    // shard that was already written comes back, continue after the
+    // commands written to it so far.
+    std::string written;
+    if (std::find(this->Files.begin(), this->Files.end(), shardFile) ==
+        this->Files.end()) {
+      this->Files.push_back(shardFile);
+    } else {
+      cmsys::ifstream fin(shardFile.c_str(), std::ios::in | std::ios::binary);
+      written.assign(std::istreambuf_iterator<char>(fin),
+                     std::istreambuf_iterator<char>());
+      if (cmHasLiteralSuffix(written, "\n]\n")) {
+        written.resize(written.size() - 3);
+      } else {
+        written.clear();
+      }
+    }
+    this->CurrentFile = shardFile;
+    // Replace only the shards that changed.
+    this->Current = cm::make_unique<cmGeneratedFileStream>(shardFile);
+    this->Current->SetCopyIfDifferent(true);
+    if (written.empty()) {
+      *this->Current << '[';
+    } else {
+      *this->Current << written << ',';
+    }
+  } else {
+    *this->Current << ',';
+  }
+  /* clang-format off */
+  *this->Current << "\n{\n"
+    << R"(  "directory": ")" << cmGlobalGenerator::EscapeJSON(directory)
+    << "\",\n"
+    << R"(  "command": ")" << cmGlobalGenerator::EscapeJSON(command)
+    << "\",\n"
+    << R"(  "file": ")" << cmGlobalGenerator::EscapeJSON(file) << "\"\n"
+    << '}';
+  /* clang-format on */
+}
+
+void cmCompileCommandsShards::Close()
+{
+  if (this->Current) {
+    *this->Current << "\n]\n";
+    this->Current.reset();
+    this->CurrentFile.clear();
+  }
+}
+
+void cmCompileCommandsShards::Write(std::string const& homeOutputDirectory,
+                                    bool wroteCompileCommands)
+{
+  this->Close();
+
+  std::string const index =
+    cmStrCat(homeOutputDirectory, "/compile_commands_shards.json");
+  if (this->Files.empty()) {
+    // Do not let tools find the shards of an earlier run.
+    cmSystemTools::RemoveFile(index);
+    return;
+  }
+  if (!wroteCompileCommands) {
+    // Do not let tools find the commands of an earlier run.
+    cmSystemTools::RemoveFile(
+      cmStrCat(homeOutputDirectory, "/compile_commands.json"));
+  }
+
+  cmGeneratedFileStream fout(index);
+  fout.SetCopyIfDifferent(true);
+  fout << "{\n  \"version\": 1,\n  \"shards\": [";
+  const char* sep = "\n";
+  for (std::string const& shard : this->Files) {
+    fout << sep << "    \""
+         << cmGlobalGenerator::EscapeJSON(
+              cmSystemTools::RelativePath(homeOutputDirectory, shard))
+         << '"';
+    sep = ",\n";
+  }
+  fout << "\n  ]\n}\n";
+
+  this->Files.clear();
+}
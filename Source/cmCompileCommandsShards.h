@@ -0,0 +1,67 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmCompileCommandsShards_h
+#define cmCompileCommandsShards_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class cmGeneratedFileStream;
+class cmGeneratorTarget;
+
+/** \class cmCompileCommandsShards
+ * \brief Split the compilation database into one file per directory or
+ * target.
+ *
+ * When CMAKE_EXPORT_COMPILE_COMMANDS_SHARDS is set the generators hand
+ * the compile commands of a target to its shard instead of the single
+ * compile_commands.json file.  A compile_commands_shards.json file in
+ * the top of the build tree lists the shards.  Shards whose content did
+ * not change are left alone so that tools reading them only reload the
+ * ones that did.
+ *
+ * The generators handle one target, and one directory, after another.
+ * The commands of a shard are therefore added consecutively and each
+ * shard is written out as soon as the commands of the next one come in.
+ * Only one shard is open at a time.  A shard whose commands come back
+ * later is read back and continued.
+ */
+class cmCompileCommandsShards
+{
+public:
+  cmCompileCommandsShards();
+  ~cmCompileCommandsShards();
+
+  cmCompileCommandsShards(cmCompileCommandsShards const&) = delete;
+  cmCompileCommandsShards& operator=(cmCompileCommandsShards const&) =
+    delete;
+
+  /** Get the shard of the given target, or an empty string if its
+      compile commands go to the single compile_commands.json file.  */
+  static std::string GetShardFile(cmGeneratorTarget const* target);
+
+  /** Add a compile command to the given shard.  */
+  void Add(std::string const& shardFile, std::string const& directory,
+           std::string const& command, std::string const& file);
+
+  /** Finish the last shard and write the index of the shards.  Without
+      shards an index left by an earlier run is removed.  With shards a
+      compile_commands.json file left by an earlier run is removed unless
+      the given flag tells that it was written by this one.  */
+  void Write(std::string const& homeOutputDirectory,
+             bool wroteCompileCommands);
+
+private:
+  void Close();
+
+  // The shard being written.
+  std::unique_ptr<cmGeneratedFileStream> Current;
+  std::string CurrentFile;
+  // All shards, in the order they were written.
+  std::vector<std::string> Files;
+};
+
+#endif
@@ -253,13 +253,14 @@ cmComputeLinkDepends::Compute()
   // Compute the final set of link entries.
   // Iterate in reverse order so we can keep only the last occurrence
   // of a shared library.
-  std::set<int> emmitted;
+  std::vector<bool> emmitted(this->EntryList.size(), false);
   for (int i : cmReverseRange(this->FinalLinkOrder)) {
     LinkEntry const& e = this->EntryList[i];
     cmGeneratorTarget const* t = e.Target;
     // Entries that we know the linker will re-use do not need to be repeated.
     bool uniquify = t && t->GetType() == cmStateEnums::SHARED_LIBRARY;
-    if (!uniquify || emmitted.insert(i).second) {
+    if (!uniquify || !emmitted[i]) {
+      emmitted[i] = true;
       this->FinalLinkEntries.push_back(e);
     }
   }
@@ -283,6 +284,7 @@ std::map<cmLinkItem, int>::iterator cmComputeLinkDepends::AllocateLinkEntry(
   this->EntryList.emplace_back();
   this->InferredDependSets.emplace_back();
   this->EntryConstraintGraph.emplace_back();
+  this->SharedDepFollowed.push_back(false);
   return lei;
 }
 
@@ -367,7 +369,8 @@ void cmComputeLinkDepends::FollowSharedDeps(int depender_index,
                                             bool follow_interface)
 {
   // Follow dependencies if we have not followed them already.
-  if (this->SharedDepFollowed.insert(depender_index).second) {
+  if (!this->SharedDepFollowed[depender_index]) {
+    this->SharedDepFollowed[depender_index] = true;
     if (follow_interface) {
       this->QueueSharedDependencies(depender_index, iface->Libraries);
     }
@@ -529,7 +532,7 @@ void cmComputeLinkDepends::AddLinkEntries(int depender_index,
       if (!this->EntryList[dependee_index].Target &&
           !this->EntryList[dependee_index].IsFlag &&
           dependee_index != dependSet.first) {
-        dependSet.second.insert(dependee_index);
+        dependSet.second.push_back(dependee_index);
       }
     }
 
@@ -541,8 +544,11 @@ void cmComputeLinkDepends::AddLinkEntries(int depender_index,
   }
 
   // Store the inferred dependency sets discovered for this list.
-  for (auto const& dependSet : dependSets) {
-    this->InferredDependSets[dependSet.first].push_back(dependSet.second);
+  for (auto& dependSet : dependSets) {
+    DependSet& ds = dependSet.second;
+    std::sort(ds.begin(), ds.end());
+    ds.erase(std::unique(ds.begin(), ds.end()), ds.end());
+    this->InferredDependSets[dependSet.first].push_back(std::move(ds));
   }
 }
 
@@ -564,7 +570,9 @@ void cmComputeLinkDepends::InferDependencies()
 {
   // The inferred dependency sets for each item list the possible
   // dependencies.  The intersection of the sets for one item form its
-  // inferred dependencies.
+  // inferred dependencies.  Each set lists an entry at most once, so
+  // an entry is in the intersection if it is counted once per set.
+  std::vector<std::size_t> counts(this->EntryList.size(), 0);
   for (unsigned int depender_index = 0;
        depender_index < this->InferredDependSets.size(); ++depender_index) {
     // Skip items for which dependencies do not need to be inferred or
@@ -575,19 +583,26 @@ void cmComputeLinkDepends::InferDependencies()
     }
 
     // Intersect the sets for this item.
-    DependSet common = sets.front();
     for (DependSet const& i : cmMakeRange(sets).advance(1)) {
-      DependSet intersection;
-      std::set_intersection(common.begin(), common.end(), i.begin(), i.end(),
-                            std::inserter(intersection, intersection.begin()));
-      common = intersection;
+      for (int c : i) {
+        ++counts[c];
+      }
     }
 
-    // Add the inferred dependencies to the graph.
+    // Add the inferred dependencies to the graph in sorted order.
+    std::size_t const others = sets.size() - 1;
     cmGraphEdgeList& edges = this->EntryConstraintGraph[depender_index];
-    edges.reserve(edges.size() + common.size());
-    for (auto const& c : common) {
-      edges.emplace_back(c, true, cmListFileBacktrace());
+    for (int c : sets.front()) {
+      if (counts[c] == others) {
+        edges.emplace_back(c, true, cmListFileBacktrace());
+      }
+    }
+
+    // Reset the counts for the next item.
+    for (DependSet const& i : cmMakeRange(sets).advance(1)) {
+      for (int c : i) {
+        counts[c] = 0;
+      }
     }
   }
 }
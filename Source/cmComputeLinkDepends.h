@@ -93,15 +93,16 @@ private:
     int DependerIndex;
   };
   std::queue<SharedDepEntry> SharedDepQueue;
-  std::set<int> SharedDepFollowed;
+  std::vector<bool> SharedDepFollowed;
   void FollowSharedDeps(int depender_index, cmLinkInterface const* iface,
                         bool follow_interface = false);
   void QueueSharedDependencies(int depender_index,
                                std::vector<cmLinkItem> const& deps);
   void HandleSharedDependency(SharedDepEntry const& dep);
 
-  // Dependency inferral for each link item.
-  struct DependSet : public std::set<int>
+  // Dependency inferral for each link item.  The sets are kept as
+  // sorted vectors of entry indices.
+  struct DependSet : public std::vector<int>
   {
   };
   struct DependSetList : public std::vector<DependSet>
@@ -9,6 +9,8 @@
 #include <unordered_set>
 #include <utility>
 
+#include "cmMemoryReport.h"
+
 cmDefinitions::Def cmDefinitions::NoDef;
 
 cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
@@ -121,3 +123,28 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
   }
   return keys;
 }
+
+namespace {
+std::size_t StringBytes(cm::String const& s)
+{
+  // A string that owns its value holds a shared std::string.  Values
+  // shared between scopes are counted by each of them.
+  std::string const* str = s.str_if_stable();
+  if (!s.data() || !str) {
+    return 0;
+  }
+  return sizeof(std::string) + 2 * sizeof(void*) +
+    cmMemoryReport::Bytes(*str);
+}
+}
+
+cmMemoryFootprint cmDefinitions::GetFootprint() const
+{
+  cmMemoryFootprint f;
+  f.Count = this->Map.size();
+  f.Bytes = cmMemoryReport::Bytes(this->Map);
+  for (auto const& mi : this->Map) {
+    f.Bytes += StringBytes(mi.first) + StringBytes(mi.second.Value);
+  }
+  return f;
+}
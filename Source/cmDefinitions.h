@@ -16,6 +16,8 @@
 #include <unordered_map>
 #include <vector>
 
+struct cmMemoryFootprint;
+
 /** \class cmDefinitions
  * \brief Store a scope of variable definitions for CMake language.
  *
@@ -52,6 +54,9 @@ public:
   /** List of unused keys.  */
   std::vector<std::string> UnusedKeys() const;
 
+  /** Number of definitions and the heap bytes they hold.  */
+  cmMemoryFootprint GetFootprint() const;
+
 private:
   /** String with existence boolean.  */
   struct Def
@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmDepends.h"
 
+#include "cmDependsDatabase.h"
 #include "cmFileTime.h"
 #include "cmFileTimeCache.h"
 #include "cmGeneratedFileStream.h"
@@ -11,9 +12,17 @@
 #include "cmSystemTools.h"
 
 #include "cmsys/FStream.hxx"
+#include <cstdint>
 #include <sstream>
 #include <utility>
 
+#ifndef CMAKE_BOOTSTRAP
+#  include <thread>
+
+#  include "cmAffinity.h"
+#  include "cmWorkerPool.h"
+#endif
+
 cmDepends::cmDepends(cmLocalGenerator* lg, std::string targetDir)
   : LocalGenerator(lg)
   , TargetDirectory(std::move(targetDir))
@@ -43,6 +52,7 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
       dependencies[obj].insert(src);
     }
   }
+  this->PrepareDependencies(dependencies);
   for (auto const& d : dependencies) {
     // Write the dependencies for this pair.
     if (!this->WriteDependencies(d.second, d.first, makeDepends,
@@ -54,19 +64,93 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
   return this->Finalize(makeDepends, internalDepends);
 }
 
+void cmDepends::PrepareDependencies(
+  std::map<std::string, std::set<std::string>> const& /*unused*/)
+{
+}
+
 bool cmDepends::Finalize(std::ostream& /*unused*/, std::ostream& /*unused*/)
 {
   return true;
 }
 
+#ifndef CMAKE_BOOTSTRAP
+namespace {
+class cmDependsScanJob : public cmWorkerPool::JobT
+{
+public:
+  cmDependsScanJob(std::function<void(unsigned int)> func)
+    : Func(std::move(func))
+  {
+  }
+
+private:
+  void Process() override { this->Func(this->WorkerIndex()); }
+
+  std::function<void(unsigned int)> Func;
+};
+
+class cmDependsScanEndJob : public cmWorkerPool::JobFenceT
+{
+private:
+  void Process() override { this->Pool()->Abort(); }
+};
+}
+#endif
+
+unsigned int cmDepends::GetScanThreadCount(std::size_t objects)
+{
+#ifndef CMAKE_BOOTSTRAP
+  unsigned int count =
+    static_cast<unsigned int>(cmAffinity::GetProcessorsAvailable().size());
+  if (count == 0) {
+    count = std::thread::hardware_concurrency();
+  }
+  if (objects < count) {
+    count = static_cast<unsigned int>(objects);
+  }
+  return count;
+#else
+  static_cast<void>(objects);
+  return 1;
+#endif
+}
+
+bool cmDepends::RunScanJobs(
+  unsigned int threadCount,
+  std::vector<std::function<void(unsigned int)>> jobs)
+{
+#ifndef CMAKE_BOOTSTRAP
+  cmWorkerPool pool;
+  pool.SetThreadCount(threadCount);
+  for (auto& job : jobs) {
+    pool.EmplaceJob<cmDependsScanJob>(std::move(job));
+  }
+  pool.EmplaceJob<cmDependsScanEndJob>();
+  return pool.Process();
+#else
+  static_cast<void>(threadCount);
+  static_cast<void>(jobs);
+  return false;
+#endif
+}
+
 bool cmDepends::Check(const std::string& makeFile,
                       const std::string& internalFile,
                       DependencyMap& validDeps)
 {
   // Check whether dependencies must be regenerated.
   bool okay = true;
-  cmsys::ifstream fin(internalFile.c_str());
-  if (!(fin && this->CheckDependencies(fin, internalFile, validDeps))) {
+  bool valid;
+  if (this->UseDatabase) {
+    cmDependsDatabase db;
+    valid = db.Open(internalFile) &&
+      this->CheckDatabase(db, internalFile, validDeps);
+  } else {
+    cmsys::ifstream fin(internalFile.c_str());
+    valid = fin && this->CheckDependencies(fin, internalFile, validDeps);
+  }
+  if (!valid) {
     // Clear all dependencies so they will be regenerated.
     this->Clear(makeFile);
     cmSystemTools::RemoveFile(internalFile);
@@ -101,31 +185,12 @@ bool cmDepends::WriteDependencies(const std::set<std::string>& /*unused*/,
   return false;
 }
 
-bool cmDepends::CheckDependencies(std::istream& internalDepends,
-                                  const std::string& internalDependsFileName,
-                                  DependencyMap& validDeps)
+void cmDepends::ReadDependencies(std::istream& internalDepends,
+                                 DependencyMap& deps)
 {
-  // Read internal depends file time
-  cmFileTime internalDependsTime;
-  if (!this->FileTimeCache->Load(internalDependsFileName,
-                                 internalDependsTime)) {
-    return false;
-  }
-
-  // Parse dependencies from the stream.  If any dependee is missing
-  // or newer than the depender then dependencies should be
-  // regenerated.
-  bool okay = true;
-  bool dependerExists = false;
-
   std::string line;
   line.reserve(1024);
-  std::string depender;
-  std::string dependee;
-  cmFileTime dependerTime;
-  cmFileTime dependeeTime;
   std::vector<std::string>* currentDependencies = nullptr;
-
   while (std::getline(internalDepends, line)) {
     // Check if this an empty or a comment line
     if (line.empty() || line.front() == '#') {
@@ -138,70 +203,178 @@ bool cmDepends::CheckDependencies(std::istream& internalDepends,
         continue;
       }
     }
-    // Check if this a depender line
+    // Check if this a depender line.  Dependers may have multiple
+    // entries whose dependees are all collected.
     if (line.front() != ' ') {
-      depender = line;
-      dependerExists = this->FileTimeCache->Load(depender, dependerTime);
-      // If we erase validDeps[this->Depender] by overwriting it with an empty
-      // vector, we lose dependencies for dependers that have multiple
-      // entries. No need to initialize the entry, std::map will do so on first
-      // access.
-      currentDependencies = &validDeps[depender];
+      currentDependencies = &deps[line];
       continue;
     }
-
     // This is a dependee line
-    dependee = line.substr(1);
-
-    // Add dependee to depender's list
     if (currentDependencies != nullptr) {
-      currentDependencies->push_back(dependee);
+      currentDependencies->push_back(line.substr(1));
     }
+  }
+}
+
+bool cmDepends::CheckDependencies(std::istream& internalDepends,
+                                  const std::string& internalDependsFileName,
+                                  DependencyMap& validDeps)
+{
+  DependencyMap deps;
+  cmDepends::ReadDependencies(internalDepends, deps);
+  return this->CheckDependencyMap(deps, internalDependsFileName, validDeps);
+}
 
-    // Dependencies must be regenerated
-    // * if the dependee does not exist
-    // * if the depender exists and is older than the dependee.
-    // * if the depender does not exist, but the dependee is newer than the
-    //   depends file
+bool cmDepends::CheckDependencyMap(DependencyMap const& deps,
+                                   const std::string& internalDependsFileName,
+                                   DependencyMap& validDeps)
+{
+  // Read internal depends file time
+  cmFileTime internalDependsTime;
+  if (!this->FileTimeCache->Load(internalDependsFileName,
+                                 internalDependsTime)) {
+    return false;
+  }
+
+  // If any dependee is missing or newer than the depender then
+  // dependencies should be regenerated.
+  bool okay = true;
+  cmFileTime dependerTime;
+  cmFileTime dependeeTime;
+  for (auto const& d : deps) {
+    std::string const& depender = d.first;
+    bool dependerExists = this->FileTimeCache->Load(depender, dependerTime);
     bool regenerate = false;
-    bool dependeeExists = this->FileTimeCache->Load(dependee, dependeeTime);
-    if (!dependeeExists) {
-      // The dependee does not exist.
-      regenerate = true;
-
-      // Print verbose output.
-      if (this->Verbose) {
-        std::ostringstream msg;
-        msg << "Dependee \"" << dependee << "\" does not exist for depender \""
-            << depender << "\"." << std::endl;
-        cmSystemTools::Stdout(msg.str());
-      }
-    } else if (dependerExists) {
-      // The dependee and depender both exist.  Compare file times.
-      if (dependerTime.Older(dependeeTime)) {
-        // The depender is older than the dependee.
+    for (std::string const& dependee : d.second) {
+      // Dependencies must be regenerated
+      // * if the dependee does not exist
+      // * if the depender exists and is older than the dependee.
+      // * if the depender does not exist, but the dependee is newer than the
+      //   depends file
+      bool dependeeExists = this->FileTimeCache->Load(dependee, dependeeTime);
+      if (!dependeeExists) {
+        // The dependee does not exist.
         regenerate = true;
 
         // Print verbose output.
         if (this->Verbose) {
           std::ostringstream msg;
-          msg << "Dependee \"" << dependee << "\" is newer than depender \""
-              << depender << "\"." << std::endl;
+          msg << "Dependee \"" << dependee
+              << "\" does not exist for depender \"" << depender << "\"."
+              << std::endl;
           cmSystemTools::Stdout(msg.str());
         }
+      } else if (dependerExists) {
+        // The dependee and depender both exist.  Compare file times.
+        if (dependerTime.Older(dependeeTime)) {
+          // The depender is older than the dependee.
+          regenerate = true;
+
+          // Print verbose output.
+          if (this->Verbose) {
+            std::ostringstream msg;
+            msg << "Dependee \"" << dependee << "\" is newer than depender \""
+                << depender << "\"." << std::endl;
+            cmSystemTools::Stdout(msg.str());
+          }
+        }
+      } else {
+        // The dependee exists, but the depender doesn't. Regenerate if the
+        // internalDepends file is older than the dependee.
+        if (internalDependsTime.Older(dependeeTime)) {
+          // The depends-file is older than the dependee.
+          regenerate = true;
+
+          // Print verbose output.
+          if (this->Verbose) {
+            std::ostringstream msg;
+            msg << "Dependee \"" << dependee
+                << "\" is newer than depends file \""
+                << internalDependsFileName << "\"." << std::endl;
+            cmSystemTools::Stdout(msg.str());
+          }
+        }
+      }
+      if (regenerate) {
+        break;
+      }
+    }
+
+    if (regenerate) {
+      // Dependencies must be regenerated.  The information of this
+      // depender is not stored in the map so that it is rescanned.
+      okay = false;
+
+      // Remove the depender to be sure it is rebuilt.
+      if (dependerExists) {
+        cmSystemTools::RemoveFile(depender);
+        this->FileTimeCache->Remove(depender);
       }
     } else {
-      // The dependee exists, but the depender doesn't. Regenerate if the
-      // internalDepends file is older than the dependee.
-      if (internalDependsTime.Older(dependeeTime)) {
-        // The depends-file is older than the dependee.
-        regenerate = true;
+      std::vector<std::string>& valid = validDeps[depender];
+      valid.insert(valid.end(), d.second.begin(), d.second.end());
+    }
+  }
 
-        // Print verbose output.
+  return okay;
+}
+
+bool cmDepends::CheckDatabase(cmDependsDatabase const& db,
+                              const std::string& internalDependsFileName,
+                              DependencyMap& validDeps)
+{
+  // Read internal depends file time
+  cmFileTime internalDependsTime;
+  if (!this->FileTimeCache->Load(internalDependsFileName,
+                                 internalDependsTime)) {
+    return false;
+  }
+
+  // Look at each path of the database once, however many objects
+  // depend on it.
+  enum class PathState : char
+  {
+    Unknown,
+    Missing,
+    Exists
+  };
+  std::vector<PathState> states(db.GetPathCount(), PathState::Unknown);
+  std::vector<cmFileTime> times(db.GetPathCount());
+  auto exists = [&db, &states, &times](std::uint32_t path) -> bool {
+    if (states[path] == PathState::Unknown) {
+      states[path] = times[path].Load(db.GetPath(path)) ? PathState::Exists
+                                                        : PathState::Missing;
+    }
+    return states[path] == PathState::Exists;
+  };
+
+  // The same rules as in CheckDependencyMap apply.
+  bool okay = true;
+  std::vector<std::uint32_t> validObjects;
+  for (std::uint32_t object = 0; object < db.GetObjectCount(); ++object) {
+    std::uint32_t const depender = db.GetObjectPath(object);
+    bool const dependerExists = exists(depender);
+    bool regenerate = false;
+    std::uint32_t const count = db.GetDependeeCount(object);
+    for (std::uint32_t i = 0; i < count && !regenerate; ++i) {
+      std::uint32_t const dependee = db.GetDependee(object, i);
+      char const* reason = nullptr;
+      char const* other = db.GetPath(depender);
+      if (!exists(dependee)) {
+        reason = "\" does not exist for depender \"";
+      } else if (dependerExists) {
+        if (times[depender].Older(times[dependee])) {
+          reason = "\" is newer than depender \"";
+        }
+      } else if (internalDependsTime.Older(times[dependee])) {
+        reason = "\" is newer than depends file \"";
+        other = internalDependsFileName.c_str();
+      }
+      if (reason) {
+        regenerate = true;
         if (this->Verbose) {
           std::ostringstream msg;
-          msg << "Dependee \"" << dependee
-              << "\" is newer than depends file \"" << internalDependsFileName
+          msg << "Dependee \"" << db.GetPath(dependee) << reason << other
               << "\"." << std::endl;
           cmSystemTools::Stdout(msg.str());
         }
@@ -212,22 +385,23 @@ bool cmDepends::CheckDependencies(std::istream& internalDepends,
       // Dependencies must be regenerated.
       okay = false;
 
-      // Remove the information of this depender from the map, it needs
-      // to be rescanned
-      if (currentDependencies != nullptr) {
-        validDeps.erase(depender);
-        currentDependencies = nullptr;
-      }
-
       // Remove the depender to be sure it is rebuilt.
       if (dependerExists) {
-        cmSystemTools::RemoveFile(depender);
-        this->FileTimeCache->Remove(depender);
-        dependerExists = false;
+        cmSystemTools::RemoveFile(db.GetPath(depender));
+        this->FileTimeCache->Remove(db.GetPath(depender));
+        states[depender] = PathState::Missing;
       }
+    } else {
+      validObjects.push_back(object);
     }
   }
 
+  // The valid dependencies are only needed to rescan the other objects.
+  if (!okay) {
+    for (std::uint32_t object : validObjects) {
+      db.GetDependencies(object, validDeps);
+    }
+  }
   return okay;
 }
 
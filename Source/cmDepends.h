@@ -5,12 +5,15 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
+class cmDependsDatabase;
 class cmFileTimeCache;
 class cmLocalGenerator;
 
@@ -62,10 +65,29 @@ public:
       dependencies are okay and false if they must be generated.  If
       they must be generated Clear has already been called to wipe out
       the old dependencies.
-      Dependencies which are still valid will be stored in validDeps. */
+      Dependencies which are still valid will be stored in validDeps.
+      With a database they are stored only if false is returned.  */
   bool Check(const std::string& makeFile, const std::string& internalFile,
              DependencyMap& validDeps);
 
+  /** Read dependencies in the format of the depend.internal file.  */
+  static void ReadDependencies(std::istream& internalDepends,
+                               DependencyMap& deps);
+
+  /** Whether the internal dependencies are kept in a binary database
+      file (see cmDependsDatabase) instead of a depend.internal file.  */
+  void SetUseDatabase(bool db) { this->UseDatabase = db; }
+
+  /** Collect the scanned dependencies in the given map instead of
+      writing them to the internal dependencies stream, and write make
+      rules only for the given dependees generated by the target.  */
+  void SetDependencyMap(DependencyMap* deps,
+                        std::set<std::string> const* generatedFiles)
+  {
+    this->Dependencies = deps;
+    this->GeneratedFiles = generatedFiles;
+  }
+
   /** Clear dependencies for the target file so they will be regenerated.  */
   void Clear(const std::string& file);
 
@@ -73,6 +95,24 @@ public:
   void SetFileTimeCache(cmFileTimeCache* fc) { this->FileTimeCache = fc; }
 
 protected:
+  // Prepare the dependencies of all object files of the target before
+  // they are written one by one.  Subclasses may use this to scan the
+  // sources of several objects concurrently.
+  virtual void PrepareDependencies(
+    std::map<std::string, std::set<std::string>> const& dependencies);
+
+  // Number of worker threads to use for scanning the given number of
+  // objects concurrently.  Less than two means they should be scanned
+  // serially.
+  static unsigned int GetScanThreadCount(std::size_t objects);
+
+  // Run the given scanning jobs on the given number of worker threads.
+  // Each job receives the index of the thread running it.  Returns
+  // false if the jobs could not be run to completion.
+  static bool RunScanJobs(
+    unsigned int threadCount,
+    std::vector<std::function<void(unsigned int)>> jobs);
+
   // Write dependencies for the target file to the given stream.
   // Return true for success and false for failure.
   virtual bool WriteDependencies(const std::set<std::string>& sources,
@@ -87,6 +127,20 @@ protected:
                                  const std::string& internalDependsFileName,
                                  DependencyMap& validDeps);
 
+  // Check dependencies read from the internal dependencies file or
+  // database.  Return false if dependencies must be regenerated and true
+  // otherwise.
+  bool CheckDependencyMap(DependencyMap const& deps,
+                          const std::string& internalDependsFileName,
+                          DependencyMap& validDeps);
+
+  // Check dependencies stored in a mapped database without copying
+  // them.  Return false if dependencies must be regenerated and true
+  // otherwise.
+  bool CheckDatabase(cmDependsDatabase const& db,
+                     const std::string& internalDependsFileName,
+                     DependencyMap& validDeps);
+
   // Finalize the dependency information for the target.
   virtual bool Finalize(std::ostream& makeDepends,
                         std::ostream& internalDepends);
@@ -96,7 +150,10 @@ protected:
 
   // Flag for verbose output.
   bool Verbose = false;
+  bool UseDatabase = false;
   cmFileTimeCache* FileTimeCache = nullptr;
+  DependencyMap* Dependencies = nullptr;
+  std::set<std::string> const* GeneratedFiles = nullptr;
 
   std::string Language;
 
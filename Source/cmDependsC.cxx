@@ -3,20 +3,24 @@
 #include "cmDependsC.h"
 
 #include "cmsys/FStream.hxx"
+#include <cstdlib>
+#include <queue>
 #include <utility>
 
-#include "cmFileTime.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+#ifndef CMAKE_BOOTSTRAP
+#  include "cmFileLock.h"
+#  include "cmFileLockResult.h"
+#endif
+
 #define INCLUDE_REGEX_LINE                                                    \
   "^[ \t]*[#%][ \t]*(include|import)[ \t]*[<\"]([^\">]+)([\">])"
 
 #define INCLUDE_REGEX_LINE_MARKER "#IncludeRegexLine: "
-#define INCLUDE_REGEX_SCAN_MARKER "#IncludeRegexScan: "
-#define INCLUDE_REGEX_COMPLAIN_MARKER "#IncludeRegexComplain: "
 #define INCLUDE_REGEX_TRANSFORM_MARKER "#IncludeRegexTransform: "
 
 cmDependsC::cmDependsC() = default;
@@ -46,21 +50,28 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg, const std::string& targetDir,
     }
   }
 
-  this->IncludeRegexLine.compile(INCLUDE_REGEX_LINE);
-  this->IncludeRegexScan.compile(scanRegex);
-  this->IncludeRegexComplain.compile(complainRegex);
+  this->Regex.Line.compile(INCLUDE_REGEX_LINE);
+  this->Regex.Scan.compile(scanRegex);
+  this->Regex.Complain.compile(complainRegex);
   this->IncludeRegexLineString = INCLUDE_REGEX_LINE_MARKER INCLUDE_REGEX_LINE;
-  this->IncludeRegexScanString =
-    cmStrCat(INCLUDE_REGEX_SCAN_MARKER, scanRegex);
-  this->IncludeRegexComplainString =
-    cmStrCat(INCLUDE_REGEX_COMPLAIN_MARKER, complainRegex);
 
   this->SetupTransforms();
 
-  this->CacheFileName =
-    cmStrCat(this->TargetDirectory, '/', lang, ".includecache");
+  // The cache records every include directive of a file and the scan
+  // regular expression is applied while walking the dependency graph, so
+  // the results only depend on the include transform rules.  Share one
+  // cache across the build tree unless this target transforms includes.
+  if (this->TransformRules.empty()) {
+    this->CacheFileName = cmStrCat(lg->GetBinaryDirectory(), "/CMakeFiles/",
+                                   lang, ".includecache");
+  } else {
+    this->CacheFileName =
+      cmStrCat(this->TargetDirectory, '/', lang, ".includecache");
+  }
 
-  this->ReadCacheFile();
+  if (!this->CacheFileName.empty()) {
+    this->ReadCacheFile(this->FileCache);
+  }
 }
 
 cmDependsC::~cmDependsC()
@@ -68,6 +79,51 @@ cmDependsC::~cmDependsC()
   this->WriteCacheFile();
 }
 
+void cmDependsC::PrepareDependencies(
+  std::map<std::string, std::set<std::string>> const& dependencies)
+{
+  std::string const& binDir = this->LocalGenerator->GetBinaryDirectory();
+
+  // Select the objects whose dependencies have to be scanned again.
+  std::vector<ScanResult*> results;
+  for (auto const& d : dependencies) {
+    if (d.second.empty() || d.second.begin()->empty()) {
+      continue;
+    }
+    std::string obj_i =
+      this->LocalGenerator->MaybeConvertToRelativePath(binDir, d.first);
+    if (this->ValidDeps != nullptr &&
+        this->ValidDeps->find(obj_i) != this->ValidDeps->end()) {
+      continue;
+    }
+    ScanResult& result = this->ScanResults[d.first];
+    result.Sources = &d.second;
+    results.push_back(&result);
+  }
+
+  unsigned int const threadCount = GetScanThreadCount(results.size());
+  if (threadCount < 2) {
+    // Scan on demand while writing the dependencies.
+    this->ScanResults.clear();
+    return;
+  }
+
+  // Each worker thread needs its own copy of the regular expressions.
+  std::vector<IncludeRegexes> regexes(threadCount, this->Regex);
+
+  std::vector<std::function<void(unsigned int)>> jobs;
+  jobs.reserve(results.size());
+  for (ScanResult* result : results) {
+    jobs.emplace_back([this, result, &regexes](unsigned int worker) {
+      result->Okay = this->ScanSources(*result->Sources, regexes[worker],
+                                       result->Dependencies, result->Error);
+    });
+  }
+  if (!RunScanJobs(threadCount, std::move(jobs))) {
+    this->ScanResults.clear();
+  }
+}
+
 bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
                                    const std::string& obj,
                                    std::ostream& makeDepends,
@@ -103,145 +159,241 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   }
 
   if (!haveDeps) {
-    // Walk the dependency graph starting with the source file.
-    int srcFiles = static_cast<int>(sources.size());
-    this->Encountered.clear();
-
-    for (std::string const& src : sources) {
-      UnscannedEntry root;
-      root.FileName = src;
-      this->Unscanned.push(root);
-      this->Encountered.insert(src);
+    std::string error;
+    bool okay;
+    auto const resultIt = this->ScanResults.find(obj);
+    if (resultIt != this->ScanResults.end()) {
+      // The sources have already been scanned concurrently.
+      dependencies = std::move(resultIt->second.Dependencies);
+      error = std::move(resultIt->second.Error);
+      okay = resultIt->second.Okay;
+    } else {
+      okay = this->ScanSources(sources, this->Regex, dependencies, error);
+    }
+    if (!okay) {
+      cmSystemTools::Error(error);
+      return false;
     }
+  }
 
-    std::set<std::string> scanned;
-    while (!this->Unscanned.empty()) {
-      // Get the next file to scan.
-      UnscannedEntry current = this->Unscanned.front();
-      this->Unscanned.pop();
-
-      // If not a full path, find the file in the include path.
-      std::string fullName;
-      if ((srcFiles > 0) || cmSystemTools::FileIsFullPath(current.FileName)) {
-        if (cmSystemTools::FileExists(current.FileName, true)) {
-          fullName = current.FileName;
-        }
-      } else if (!current.QuotedLocation.empty() &&
-                 cmSystemTools::FileExists(current.QuotedLocation, true)) {
-        // The include statement producing this entry was a double-quote
-        // include and the included file is present in the directory of
-        // the source containing the include statement.
-        fullName = current.QuotedLocation;
-      } else {
+  // Write the dependencies to the output stream.  Makefile rules
+  // written by the original local generator for this directory
+  // convert the dependencies to paths relative to the home output
+  // directory.  We must do the same here.
+  std::string obj_m = cmSystemTools::ConvertToOutputPath(obj_i);
+  if (this->Dependencies) {
+    std::vector<std::string>& deps = (*this->Dependencies)[obj_i];
+    deps.insert(deps.end(), dependencies.begin(), dependencies.end());
+  } else {
+    internalDepends << obj_i << std::endl;
+  }
+
+  for (std::string const& dep : dependencies) {
+    // With a database the dependency check removes objects older than
+    // their dependees, but make still has to bring the dependees the
+    // target generates itself up to date before compiling the object.
+    if (this->Dependencies == nullptr ||
+        (this->GeneratedFiles != nullptr &&
+         this->GeneratedFiles->count(
+           cmSystemTools::CollapseFullPath(dep, binDir)) != 0)) {
+      makeDepends << obj_m << ": "
+                  << cmSystemTools::ConvertToOutputPath(
+                       this->LocalGenerator->MaybeConvertToRelativePath(
+                         binDir, dep))
+                  << std::endl;
+    }
+    if (this->Dependencies == nullptr) {
+      internalDepends << " " << dep << std::endl;
+    }
+  }
+  makeDepends << std::endl;
+
+  return true;
+}
+
+bool cmDependsC::ScanSources(std::set<std::string> const& sources,
+                             IncludeRegexes& rx,
+                             std::set<std::string>& dependencies,
+                             std::string& error)
+{
+  // Walk the dependency graph starting with the source file.
+  int srcFiles = static_cast<int>(sources.size());
+  std::set<std::string> encountered;
+  std::queue<UnscannedEntry> unscanned;
+
+  for (std::string const& src : sources) {
+    UnscannedEntry root;
+    root.FileName = src;
+    unscanned.push(root);
+    encountered.insert(src);
+  }
+
+  std::set<std::string> scanned;
+  while (!unscanned.empty()) {
+    // Get the next file to scan.
+    UnscannedEntry current = unscanned.front();
+    unscanned.pop();
+
+    // If not a full path, find the file in the include path.
+    std::string fullName;
+    if ((srcFiles > 0) || cmSystemTools::FileIsFullPath(current.FileName)) {
+      if (cmSystemTools::FileExists(current.FileName, true)) {
+        fullName = current.FileName;
+      }
+    } else if (!current.QuotedLocation.empty() &&
+               cmSystemTools::FileExists(current.QuotedLocation, true)) {
+      // The include statement producing this entry was a double-quote
+      // include and the included file is present in the directory of
+      // the source containing the include statement.
+      fullName = current.QuotedLocation;
+    } else {
+      {
+        std::lock_guard<std::mutex> lock(this->CacheMutex);
         auto headerLocationIt =
           this->HeaderLocationCache.find(current.FileName);
         if (headerLocationIt != this->HeaderLocationCache.end()) {
           fullName = headerLocationIt->second;
-        } else {
-          for (std::string const& iPath : this->IncludePath) {
-            // Construct the name of the file as if it were in the current
-            // include directory.  Avoid using a leading "./".
-            std::string tmpPath =
-              cmSystemTools::CollapseFullPath(current.FileName, iPath);
-
-            // Look for the file in this location.
-            if (cmSystemTools::FileExists(tmpPath, true)) {
-              fullName = tmpPath;
-              this->HeaderLocationCache[current.FileName] = std::move(tmpPath);
-              break;
-            }
-          }
         }
       }
-
-      // Complain if the file cannot be found and matches the complain
-      // regex.
-      if (fullName.empty() &&
-          this->IncludeRegexComplain.find(current.FileName)) {
-        cmSystemTools::Error("Cannot find file \"" + current.FileName + "\".");
-        return false;
+      if (fullName.empty()) {
+        for (std::string const& iPath : this->IncludePath) {
+          // Construct the name of the file as if it were in the current
+          // include directory.  Avoid using a leading "./".
+          std::string tmpPath =
+            cmSystemTools::CollapseFullPath(current.FileName, iPath);
+
+          // Look for the file in this location.
+          if (cmSystemTools::FileExists(tmpPath, true)) {
+            fullName = tmpPath;
+            std::lock_guard<std::mutex> lock(this->CacheMutex);
+            this->HeaderLocationCache[current.FileName] = std::move(tmpPath);
+            break;
+          }
+        }
       }
+    }
 
-      // Scan the file if it was found and has not been scanned already.
-      if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
-        // Record scanned files.
-        scanned.insert(fullName);
-
-        // Check whether this file is already in the cache
-        auto fileIt = this->FileCache.find(fullName);
-        if (fileIt != this->FileCache.end()) {
-          fileIt->second.Used = true;
-          dependencies.insert(fullName);
-          for (UnscannedEntry const& inc : fileIt->second.UnscannedEntries) {
-            if (this->Encountered.find(inc.FileName) ==
-                this->Encountered.end()) {
-              this->Encountered.insert(inc.FileName);
-              this->Unscanned.push(inc);
-            }
-          }
-        } else {
+    // Complain if the file cannot be found and matches the complain
+    // regex.
+    if (fullName.empty() && rx.Complain.find(current.FileName)) {
+      error = "Cannot find file \"" + current.FileName + "\".";
+      return false;
+    }
 
-          // Try to scan the file.  Just leave it out if we cannot find
-          // it.
-          cmsys::ifstream fin(fullName.c_str());
-          if (fin) {
-            cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
-            if (bom == cmsys::FStream::BOM_None ||
-                bom == cmsys::FStream::BOM_UTF8) {
-              // Add this file as a dependency.
-              dependencies.insert(fullName);
-
-              // Scan this file for new dependencies.  Pass the directory
-              // containing the file to handle double-quote includes.
-              std::string dir = cmSystemTools::GetFilenamePath(fullName);
-              this->Scan(fin, dir, fullName);
-            } else {
-              // Skip file with encoding we do not implement.
-            }
+    // Scan the file if it was found and has not been scanned already.
+    if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
+      // Record scanned files.
+      scanned.insert(fullName);
+
+      // Just leave the file out if we cannot read it.
+      if (cmIncludeLines const* lines = this->GetIncludeLines(fullName, rx)) {
+        // Add this file as a dependency.
+        dependencies.insert(fullName);
+
+        // Queue the files it includes if they have not yet been
+        // encountered and match the regular expression for recursive
+        // scanning.  Note that this check does not account for the
+        // possibility of two headers with the same name in different
+        // directories when one is included by double-quotes and the
+        // other by angle brackets.  It also does not work properly if
+        // two header files with the same name exist in different
+        // directories, and both are included from a file their own
+        // directory by simply using "filename.h" (#12619)
+        // This kind of problem will be fixed when a more
+        // preprocessor-like implementation of this scanner is created.
+        for (UnscannedEntry const& inc : lines->UnscannedEntries) {
+          if (rx.Scan.find(inc.FileName) &&
+              encountered.insert(inc.FileName).second) {
+            unscanned.push(inc);
           }
         }
       }
-
-      srcFiles--;
     }
-  }
-
-  // Write the dependencies to the output stream.  Makefile rules
-  // written by the original local generator for this directory
-  // convert the dependencies to paths relative to the home output
-  // directory.  We must do the same here.
-  std::string obj_m = cmSystemTools::ConvertToOutputPath(obj_i);
-  internalDepends << obj_i << std::endl;
 
-  for (std::string const& dep : dependencies) {
-    makeDepends << obj_m << ": "
-                << cmSystemTools::ConvertToOutputPath(
-                     this->LocalGenerator->MaybeConvertToRelativePath(binDir,
-                                                                      dep))
-                << std::endl;
-    internalDepends << " " << dep << std::endl;
+    srcFiles--;
   }
-  makeDepends << std::endl;
 
   return true;
 }
 
-void cmDependsC::ReadCacheFile()
+cmDependsC::cmIncludeLines const* cmDependsC::GetIncludeLines(
+  std::string const& fullName, IncludeRegexes& rx)
 {
-  if (this->CacheFileName.empty()) {
-    return;
+  // Use the cache entry if it has already been checked.
+  {
+    std::lock_guard<std::mutex> lock(this->CacheMutex);
+    auto fileIt = this->FileCache.find(fullName);
+    if (fileIt != this->FileCache.end() && fileIt->second.Valid) {
+      return &fileIt->second;
+    }
+  }
+
+  // Use the cache entry if the file has not changed since it was scanned.
+  cmFileTime fileTime;
+  if (!fileTime.Load(fullName)) {
+    // Drop the entry of a file that has been removed.
+    std::lock_guard<std::mutex> lock(this->CacheMutex);
+    auto fileIt = this->FileCache.find(fullName);
+    if (fileIt != this->FileCache.end() && !fileIt->second.Valid) {
+      this->FileCache.erase(fileIt);
+      this->RemovedFiles.insert(fullName);
+      this->CacheModified = true;
+    }
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->CacheMutex);
+    auto fileIt = this->FileCache.find(fullName);
+    if (fileIt != this->FileCache.end() &&
+        fileIt->second.Time == fileTime.GetNS()) {
+      fileIt->second.Valid = true;
+      return &fileIt->second;
+    }
+  }
+
+  // Try to scan the file.
+  cmsys::ifstream fin(fullName.c_str());
+  if (!fin) {
+    return nullptr;
+  }
+  cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
+  if (bom != cmsys::FStream::BOM_None && bom != cmsys::FStream::BOM_UTF8) {
+    // Skip file with encoding we do not implement.
+    return nullptr;
   }
+  cmIncludeLines lines;
+  lines.Time = fileTime.GetNS();
+  lines.Valid = true;
+
+  // Pass the directory containing the file to handle double-quote
+  // includes.
+  this->Scan(fin, cmSystemTools::GetFilenamePath(fullName), rx,
+             lines.UnscannedEntries);
+
+  // Another thread may have scanned the file meanwhile.  Valid entries
+  // may be in use and must not be replaced.
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  cmIncludeLines& entry = this->FileCache[fullName];
+  if (!entry.Valid) {
+    entry = std::move(lines);
+    this->CacheModified = true;
+  }
+  return &entry;
+}
+
+bool cmDependsC::ReadCacheFile(
+  std::map<std::string, cmIncludeLines>& cache) const
+{
   cmsys::ifstream fin(this->CacheFileName.c_str());
   if (!fin) {
-    return;
+    return false;
   }
 
+  // Each entry records the modification time of the file when it was
+  // scanned.  Entries are checked against the file when they are used.
   std::string line;
   cmIncludeLines* cacheEntry = nullptr;
   bool haveFileName = false;
-
-  cmFileTime cacheFileTime;
-  bool const cacheFileTimeGood = cacheFileTime.Load(this->CacheFileName);
   while (cmSystemTools::GetLineFromStream(fin, line)) {
     if (line.empty()) {
       cacheEntry = nullptr;
@@ -252,34 +404,31 @@ void cmDependsC::ReadCacheFile()
     if (!haveFileName) {
       haveFileName = true;
 
-      cmFileTime fileTime;
-      bool const res = cacheFileTimeGood && fileTime.Load(line);
-      bool const newer = res && cacheFileTime.Newer(fileTime);
-
-      if (res && newer) // cache is newer than the parsed file
-      {
-        cacheEntry = &this->FileCache[line];
-      }
-      // file doesn't exist, check that the regular expressions
-      // haven't changed
-      else if (!res) {
-        if (line.find(INCLUDE_REGEX_LINE_MARKER) == 0) {
-          if (line != this->IncludeRegexLineString) {
-            return;
-          }
-        } else if (line.find(INCLUDE_REGEX_SCAN_MARKER) == 0) {
-          if (line != this->IncludeRegexScanString) {
-            return;
-          }
-        } else if (line.find(INCLUDE_REGEX_COMPLAIN_MARKER) == 0) {
-          if (line != this->IncludeRegexComplainString) {
-            return;
-          }
-        } else if (line.find(INCLUDE_REGEX_TRANSFORM_MARKER) == 0) {
-          if (line != this->IncludeRegexTransformString) {
-            return;
-          }
+      if (line.find(INCLUDE_REGEX_LINE_MARKER) == 0) {
+        if (line != this->IncludeRegexLineString) {
+          return false;
         }
+      } else if (line.find(INCLUDE_REGEX_TRANSFORM_MARKER) == 0) {
+        if (line != this->IncludeRegexTransformString) {
+          return false;
+        }
+      } else {
+        // the next line is the modification time of the parsed file
+        std::string timeLine;
+        if (!cmSystemTools::GetLineFromStream(fin, timeLine) ||
+            timeLine.empty()) {
+          return false;
+        }
+        char* end = nullptr;
+        long long const time = std::strtoll(timeLine.c_str(), &end, 10);
+        if (*end != '\0') {
+          // This cache file was written in an older format.
+          cache.clear();
+          return false;
+        }
+        cacheEntry = &cache[line];
+        cacheEntry->UnscannedEntries.clear();
+        cacheEntry->Time = time;
       }
     } else if (cacheEntry != nullptr) {
       UnscannedEntry entry;
@@ -292,61 +441,100 @@ void cmDependsC::ReadCacheFile()
       }
     }
   }
+  return true;
 }
 
-void cmDependsC::WriteCacheFile() const
+void cmDependsC::WriteCacheFile()
 {
-  if (this->CacheFileName.empty()) {
+  // Leave the cache file alone unless a file had to be scanned again.
+  if (this->CacheFileName.empty() || !this->CacheModified) {
     return;
   }
-  cmsys::ofstream cacheOut(this->CacheFileName.c_str());
-  if (!cacheOut) {
+
+#ifndef CMAKE_BOOTSTRAP
+  // Other targets may update a shared cache file concurrently.  Hold a
+  // lock while merging their entries so that none of them are lost.  The
+  // cache only saves scanning time, so give up rather than wait long for
+  // a step that holds the lock.
+  std::string const lockName = cmStrCat(this->CacheFileName, ".lock");
+  cmFileLock lock;
+  if (!cmSystemTools::Touch(lockName, true) ||
+      !lock.Lock(lockName, 10).IsOk()) {
     return;
   }
+#endif
+
+  // Merge the entries written since this cache was read.  Only the
+  // entries checked against the files during this run replace them.
+  // The others are checked when they are used, so there is no need to
+  // look at their files here.
+  std::map<std::string, cmIncludeLines> cache;
+  this->ReadCacheFile(cache);
+  for (std::string const& removed : this->RemovedFiles) {
+    cache.erase(removed);
+  }
+  for (auto& fileIt : this->FileCache) {
+    if (fileIt.second.Valid) {
+      cache[fileIt.first] = std::move(fileIt.second);
+    }
+  }
+
+  // Write to a temporary file and replace the cache atomically so that
+  // readers never see a partially written file.
+  std::string const tempName =
+    cmStrCat(this->CacheFileName, '.', cmSystemTools::RandomSeed(), ".tmp");
+  {
+    cmsys::ofstream cacheOut(tempName.c_str());
+    if (!cacheOut) {
+      return;
+    }
 
-  cacheOut << this->IncludeRegexLineString << "\n\n";
-  cacheOut << this->IncludeRegexScanString << "\n\n";
-  cacheOut << this->IncludeRegexComplainString << "\n\n";
-  cacheOut << this->IncludeRegexTransformString << "\n\n";
+    cacheOut << this->IncludeRegexLineString << "\n\n";
+    cacheOut << this->IncludeRegexTransformString << "\n\n";
 
-  for (auto const& fileIt : this->FileCache) {
-    if (fileIt.second.Used) {
-      cacheOut << fileIt.first << std::endl;
+    for (auto const& fileIt : cache) {
+      cacheOut << fileIt.first << "\n" << fileIt.second.Time << "\n";
 
       for (UnscannedEntry const& inc : fileIt.second.UnscannedEntries) {
-        cacheOut << inc.FileName << std::endl;
+        cacheOut << inc.FileName << "\n";
         if (inc.QuotedLocation.empty()) {
-          cacheOut << "-" << std::endl;
+          cacheOut << "-\n";
         } else {
-          cacheOut << inc.QuotedLocation << std::endl;
+          cacheOut << inc.QuotedLocation << "\n";
         }
       }
-      cacheOut << std::endl;
+      cacheOut << "\n";
     }
+    if (!cacheOut) {
+      cacheOut.close();
+      cmSystemTools::RemoveFile(tempName);
+      return;
+    }
+  }
+  if (!cmSystemTools::RenameFile(tempName, this->CacheFileName)) {
+    cmSystemTools::RemoveFile(tempName);
   }
 }
 
 void cmDependsC::Scan(std::istream& is, const std::string& directory,
-                      const std::string& fullName)
+                      IncludeRegexes& rx,
+                      std::vector<UnscannedEntry>& entries) const
 {
-  cmIncludeLines& newCacheEntry = this->FileCache[fullName];
-  newCacheEntry.Used = true;
-
   // Read one line at a time.
   std::string line;
   while (cmSystemTools::GetLineFromStream(is, line)) {
     // Transform the line content first.
     if (!this->TransformRules.empty()) {
-      this->TransformLine(line);
+      this->TransformLine(line, rx);
     }
 
     // Match include directives.
-    if (this->IncludeRegexLine.find(line)) {
+    if (rx.Line.find(line)) {
       // Get the file being included.
       UnscannedEntry entry;
-      entry.FileName = this->IncludeRegexLine.match(2);
+      entry.FileName = rx.Line.match(2);
       cmSystemTools::ConvertToUnixSlashes(entry.FileName);
-      if (this->IncludeRegexLine.match(3) == "\"" &&
+      if (rx.Line.match(3) == "\"" &&
           !cmSystemTools::FileIsFullPath(entry.FileName)) {
         // This was a double-quoted include with a relative path.  We
         // must check for the file in the directory containing the
@@ -354,25 +542,7 @@ void cmDependsC::Scan(std::istream& is, const std::string& directory,
         entry.QuotedLocation =
           cmSystemTools::CollapseFullPath(entry.FileName, directory);
       }
-
-      // Queue the file if it has not yet been encountered and it
-      // matches the regular expression for recursive scanning.  Note
-      // that this check does not account for the possibility of two
-      // headers with the same name in different directories when one
-      // is included by double-quotes and the other by angle brackets.
-      // It also does not work properly if two header files with the same
-      // name exist in different directories, and both are included from a
-      // file their own directory by simply using "filename.h" (#12619)
-      // This kind of problem will be fixed when a more
-      // preprocessor-like implementation of this scanner is created.
-      if (this->IncludeRegexScan.find(entry.FileName)) {
-        newCacheEntry.UnscannedEntries.push_back(entry);
-        if (this->Encountered.find(entry.FileName) ==
-            this->Encountered.end()) {
-          this->Encountered.insert(entry.FileName);
-          this->Unscanned.push(entry);
-        }
-      }
+      entries.push_back(std::move(entry));
     }
   }
 }
@@ -401,7 +571,7 @@ void cmDependsC::SetupTransforms()
       sep = "|";
     }
     xform += ")[ \t]*\\(([^),]*)\\)";
-    this->IncludeRegexTransform.compile(xform);
+    this->Regex.Transform.compile(xform);
 
     // Build a string that encodes all transformation rules and will
     // change when rules are changed.
@@ -428,20 +598,20 @@ void cmDependsC::ParseTransform(std::string const& xform)
   this->TransformRules[name] = value;
 }
 
-void cmDependsC::TransformLine(std::string& line)
+void cmDependsC::TransformLine(std::string& line, IncludeRegexes& rx) const
 {
   // Check for a transform rule match.  Return if none.
-  if (!this->IncludeRegexTransform.find(line)) {
+  if (!rx.Transform.find(line)) {
     return;
   }
-  auto tri = this->TransformRules.find(this->IncludeRegexTransform.match(3));
+  auto tri = this->TransformRules.find(rx.Transform.match(3));
   if (tri == this->TransformRules.end()) {
     return;
   }
 
   // Construct the transformed line.
-  std::string newline = this->IncludeRegexTransform.match(1);
-  std::string arg = this->IncludeRegexTransform.match(4);
+  std::string newline = rx.Transform.match(1);
+  std::string arg = rx.Transform.match(4);
   for (char c : tri->second) {
     if (c == '%') {
       newline += arg;
@@ -6,11 +6,12 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include "cmDepends.h"
+#include "cmFileTime.h"
 
 #include "cmsys/RegularExpression.hxx"
 #include <iosfwd>
 #include <map>
-#include <queue>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -37,34 +38,13 @@ public:
 
 protected:
   // Implement writing/checking methods required by superclass.
+  void PrepareDependencies(
+    std::map<std::string, std::set<std::string>> const& dependencies)
+    override;
   bool WriteDependencies(const std::set<std::string>& sources,
                          const std::string& obj, std::ostream& makeDepends,
                          std::ostream& internalDepends) override;
 
-  // Method to scan a single file.
-  void Scan(std::istream& is, const std::string& directory,
-            const std::string& fullName);
-
-  // Regular expression to identify C preprocessor include directives.
-  cmsys::RegularExpression IncludeRegexLine;
-
-  // Regular expressions to choose which include files to scan
-  // recursively and which to complain about not finding.
-  cmsys::RegularExpression IncludeRegexScan;
-  cmsys::RegularExpression IncludeRegexComplain;
-  std::string IncludeRegexLineString;
-  std::string IncludeRegexScanString;
-  std::string IncludeRegexComplainString;
-
-  // Regex to transform #include lines.
-  std::string IncludeRegexTransformString;
-  cmsys::RegularExpression IncludeRegexTransform;
-  using TransformRulesType = std::map<std::string, std::string>;
-  TransformRulesType TransformRules;
-  void SetupTransforms();
-  void ParseTransform(std::string const& xform);
-  void TransformLine(std::string& line);
-
 public:
   // Data structures for dependency graph walk.
   struct UnscannedEntry
@@ -76,21 +56,80 @@ public:
   struct cmIncludeLines
   {
     std::vector<UnscannedEntry> UnscannedEntries;
-    bool Used = false;
+    // Modification time of the file when it was scanned.
+    cmFileTime::NSC Time = 0;
+    // Whether the entry is known to match the file on disk.  Such
+    // entries are never modified again and may be shared by threads.
+    bool Valid = false;
+  };
+
+  // Regular expressions used during a scan.  Matching stores state in
+  // the expression objects so each scanning thread needs its own copy.
+  struct IncludeRegexes
+  {
+    // Regular expression to identify C preprocessor include directives.
+    cmsys::RegularExpression Line;
+
+    // Regular expressions to choose which include files to scan
+    // recursively and which to complain about not finding.
+    cmsys::RegularExpression Scan;
+    cmsys::RegularExpression Complain;
+
+    // Regex to transform #include lines.
+    cmsys::RegularExpression Transform;
+  };
+
+  struct ScanResult
+  {
+    std::set<std::string> const* Sources = nullptr;
+    std::set<std::string> Dependencies;
+    std::string Error;
+    bool Okay = false;
   };
 
 protected:
+  // Compute the set of files the given sources depend on.  This may be
+  // called concurrently with distinct regular expression objects.
+  bool ScanSources(std::set<std::string> const& sources, IncludeRegexes& rx,
+                   std::set<std::string>& dependencies, std::string& error);
+
+  // Lookup the include lines of a file, scanning it if it has changed.
+  // Returns null if the file cannot be read.
+  cmIncludeLines const* GetIncludeLines(std::string const& fullName,
+                                        IncludeRegexes& rx);
+
+  // Method to scan a single file.
+  void Scan(std::istream& is, const std::string& directory,
+            IncludeRegexes& rx, std::vector<UnscannedEntry>& entries) const;
+
+  IncludeRegexes Regex;
+  std::string IncludeRegexLineString;
+  std::string IncludeRegexTransformString;
+
+  using TransformRulesType = std::map<std::string, std::string>;
+  TransformRulesType TransformRules;
+  void SetupTransforms();
+  void ParseTransform(std::string const& xform);
+  void TransformLine(std::string& line, IncludeRegexes& rx) const;
+
   const DependencyMap* ValidDeps = nullptr;
-  std::set<std::string> Encountered;
-  std::queue<UnscannedEntry> Unscanned;
 
+  // Dependencies of objects scanned by PrepareDependencies.
+  std::map<std::string, ScanResult> ScanResults;
+
+  // Protects the caches below while scanning concurrently.
+  std::mutex CacheMutex;
   std::map<std::string, cmIncludeLines> FileCache;
+  // Files with a cache entry that were found to be removed.
+  std::set<std::string> RemovedFiles;
   std::map<std::string, std::string> HeaderLocationCache;
 
   std::string CacheFileName;
+  // Whether a file was scanned again since the cache file was read.
+  bool CacheModified = false;
 
-  void WriteCacheFile() const;
-  void ReadCacheFile();
+  void WriteCacheFile();
+  bool ReadCacheFile(std::map<std::string, cmIncludeLines>& cache) const;
 };
 
 #endif
@@ -0,0 +1,285 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmDependsCompiler.h"
+
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <utility>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmDependsDatabase.h"
+#include "cmFileTime.h"
+#include "cmFileTimeCache.h"
+#include "cmGeneratedFileStream.h"
+#include "cmLocalGenerator.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+cmDependsCompiler::cmDependsCompiler(cmLocalGenerator* lg,
+                                     std::string targetDir)
+  : LocalGenerator(lg)
+  , TargetDirectory(std::move(targetDir))
+{
+}
+
+bool cmDependsCompiler::Update(
+  std::vector<std::string> const& objectDepfilePairs)
+{
+  std::string const internalFile =
+    cmStrCat(this->TargetDirectory,
+             this->UseDatabase ? "/compiler_depend.db"
+                               : "/compiler_depend.internal");
+  std::string const makeFile =
+    cmStrCat(this->TargetDirectory, "/compiler_depend.make");
+  std::string const& binDir = this->LocalGenerator->GetBinaryDirectory();
+  // The compiler runs in the current binary directory so relative paths
+  // in the depfiles are relative to it.
+  std::string const& workDir =
+    this->LocalGenerator->GetCurrentBinaryDirectory();
+
+  // Load the dependencies consolidated by a previous run.
+  cmDepends::DependencyMap oldDeps;
+  cmFileTime internalTime;
+  bool const haveInternal =
+    this->FileTimeCache->Load(internalFile, internalTime) &&
+    this->ReadInternal(internalFile, oldDeps);
+
+  bool changed = !haveInternal;
+  cmDepends::DependencyMap newDeps;
+  cmFileTime fileTime;
+  for (auto pi = objectDepfilePairs.begin();
+       pi != objectDepfilePairs.end() && (pi + 1) != objectDepfilePairs.end();
+       pi += 2) {
+    std::string const& obj = *pi;
+    std::string const& depfile = *(pi + 1);
+    std::string const obj_i =
+      this->LocalGenerator->MaybeConvertToRelativePath(binDir, obj);
+    auto const oi = oldDeps.find(obj_i);
+
+    cmFileTime depfileTime;
+    if (!this->FileTimeCache->Load(depfile, depfileTime)) {
+      // The object has not been compiled since the depfile was removed.
+      if (oi != oldDeps.end()) {
+        changed = true;
+      }
+      continue;
+    }
+
+    std::vector<std::string> deps;
+    if (oi != oldDeps.end() && internalTime.Newer(depfileTime)) {
+      // The depfile has already been consolidated.
+      deps = std::move(oi->second);
+    } else {
+      cmsys::ifstream fin(depfile.c_str());
+      std::vector<std::string> parsed;
+      if (!fin || !cmDependsCompiler::ParseDepfile(fin, parsed)) {
+        changed = true;
+        continue;
+      }
+      if (this->Verbose) {
+        std::ostringstream msg;
+        msg << "Reading dependencies of \"" << obj_i << "\" from \""
+            << depfile << "\"." << std::endl;
+        cmSystemTools::Stdout(msg.str());
+      }
+      std::set<std::string> unique;
+      for (std::string const& dep : parsed) {
+        unique.insert(cmSystemTools::CollapseFullPath(dep, workDir));
+      }
+      deps.assign(unique.begin(), unique.end());
+      changed = true;
+    }
+
+    // If a dependee has disappeared the object must be rebuilt and
+    // the compiler will report the new dependencies.  Make would
+    // otherwise fail to find a rule for the missing file.  The make
+    // rules do not list the dependees stored in a database so the
+    // object must be rebuilt here if one of them is newer, too.
+    cmFileTime objTime;
+    bool const checkTime =
+      this->UseDatabase && this->FileTimeCache->Load(obj, objTime);
+    bool dependeeMissing = false;
+    for (std::string const& dep : deps) {
+      if (!this->FileTimeCache->Load(dep, fileTime)) {
+        if (this->Verbose) {
+          std::ostringstream msg;
+          msg << "Dependee \"" << dep << "\" does not exist for depender \""
+              << obj << "\"." << std::endl;
+          cmSystemTools::Stdout(msg.str());
+        }
+        dependeeMissing = true;
+        break;
+      }
+      if (checkTime && objTime.Older(fileTime)) {
+        if (this->Verbose) {
+          std::ostringstream msg;
+          msg << "Dependee \"" << dep << "\" is newer than depender \""
+              << obj << "\"." << std::endl;
+          cmSystemTools::Stdout(msg.str());
+        }
+        cmSystemTools::RemoveFile(obj);
+        this->FileTimeCache->Remove(obj);
+        break;
+      }
+    }
+    if (dependeeMissing) {
+      cmSystemTools::RemoveFile(obj);
+      this->FileTimeCache->Remove(obj);
+      cmSystemTools::RemoveFile(depfile);
+      this->FileTimeCache->Remove(depfile);
+      changed = true;
+      continue;
+    }
+
+    newDeps[obj_i] = std::move(deps);
+  }
+
+  // Objects may have been removed from the target.
+  if (!changed && newDeps.size() == oldDeps.size()) {
+    return true;
+  }
+
+  bool const okay = this->WriteDependencies(makeFile, internalFile, newDeps);
+  this->FileTimeCache->Remove(internalFile);
+  return okay;
+}
+
+bool cmDependsCompiler::ReadInternal(std::string const& internalFile,
+                                     cmDepends::DependencyMap& deps)
+{
+  if (this->UseDatabase) {
+    return cmDependsDatabase::Load(internalFile, deps);
+  }
+  cmsys::ifstream fin(internalFile.c_str());
+  if (!fin) {
+    return false;
+  }
+  cmDepends::ReadDependencies(fin, deps);
+  return true;
+}
+
+bool cmDependsCompiler::WriteDependencies(
+  std::string const& makeFile, std::string const& internalFile,
+  cmDepends::DependencyMap const& deps)
+{
+  // The make depends file should be copy-if-different because the make
+  // tool may try to reload it needlessly otherwise.
+  cmGeneratedFileStream makeDepends(makeFile);
+  makeDepends.SetCopyIfDifferent(true);
+  if (!makeDepends) {
+    return false;
+  }
+  makeDepends << "# CMAKE generated file: DO NOT EDIT!\n"
+              << "# Dependencies reported by the compiler.\n\n";
+
+  if (this->UseDatabase) {
+    makeDepends << "# The dependencies are stored in "
+                << cmSystemTools::GetFilenameName(internalFile) << ".\n";
+    return cmDependsDatabase::Save(internalFile, deps);
+  }
+
+  cmGeneratedFileStream internalDepends(internalFile);
+  if (!internalDepends) {
+    return false;
+  }
+  internalDepends << "# CMAKE generated file: DO NOT EDIT!\n"
+                  << "# Dependencies reported by the compiler.\n\n";
+
+  // Makefile rules written by the original local generator for this
+  // directory convert the dependencies to paths relative to the home
+  // output directory.  We must do the same here.
+  std::string const& binDir = this->LocalGenerator->GetBinaryDirectory();
+  for (auto const& d : deps) {
+    std::string const obj_m = cmSystemTools::ConvertToOutputPath(d.first);
+    internalDepends << d.first << "\n";
+    for (std::string const& dep : d.second) {
+      makeDepends << obj_m << ": "
+                  << cmSystemTools::ConvertToOutputPath(
+                       this->LocalGenerator->MaybeConvertToRelativePath(
+                         binDir, dep))
+                  << "\n";
+      internalDepends << " " << dep << "\n";
+    }
+    makeDepends << "\n";
+  }
+
+  return true;
+}
+
+bool cmDependsCompiler::ParseDepfile(std::istream& is,
+                                     std::vector<std::string>& deps)
+{
+  std::string const content{ std::istreambuf_iterator<char>(is),
+                             std::istreambuf_iterator<char>() };
+  if (is.bad()) {
+    return false;
+  }
+
+  // Tokens before an unescaped colon name the rule outputs and are
+  // ignored.  Tokens after it up to the end of line are prerequisites.
+  bool inPrereqs = false;
+  std::string token;
+  auto flush = [&token, &inPrereqs, &deps]() {
+    if (!token.empty()) {
+      if (inPrereqs) {
+        deps.push_back(token);
+      }
+      token.clear();
+    }
+  };
+
+  std::string::size_type const n = content.size();
+  for (std::string::size_type i = 0; i < n; ++i) {
+    char const c = content[i];
+    char const next = (i + 1 < n) ? content[i + 1] : '\0';
+    switch (c) {
+      case '\\':
+        if (next == '\n') {
+          // Line continuation.
+          flush();
+          ++i;
+        } else if (next == '\r' && i + 2 < n && content[i + 2] == '\n') {
+          flush();
+          i += 2;
+        } else if (next == ' ' || next == '#') {
+          token += next;
+          ++i;
+        } else {
+          token += c;
+        }
+        break;
+      case '$':
+        token += c;
+        if (next == '$') {
+          ++i;
+        }
+        break;
+      case ' ':
+      case '\t':
+        flush();
+        break;
+      case '\r':
+      case '\n':
+        flush();
+        inPrereqs = false;
+        break;
+      case ':':
+        if (!inPrereqs &&
+            (next == '\0' || next == ' ' || next == '\t' || next == '\r' ||
+             next == '\n')) {
+          flush();
+          inPrereqs = true;
+        } else {
+          token += c;
+        }
+        break;
+      default:
+        token += c;
+        break;
+    }
+  }
+  flush();
+  return true;
+}
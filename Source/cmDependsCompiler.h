@@ -0,0 +1,69 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmDependsCompiler_h
+#define cmDependsCompiler_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "cmDepends.h"
+
+class cmFileTimeCache;
+class cmLocalGenerator;
+
+/** \class cmDependsCompiler
+ * \brief Consolidate dependency files generated by the compiler.
+ *
+ * Instead of scanning sources for include directives, compilers that
+ * support it write a make-style dependency file (depfile) next to each
+ * object file while compiling.  This class merges the depfiles of a
+ * target into its compiler_depend.make file so that the next build
+ * picks up the dependencies found by the previous one.
+ */
+class cmDependsCompiler
+{
+public:
+  cmDependsCompiler(cmLocalGenerator* lg, std::string targetDir);
+
+  cmDependsCompiler(cmDependsCompiler const&) = delete;
+  cmDependsCompiler& operator=(cmDependsCompiler const&) = delete;
+
+  /** should this be verbose in its output */
+  void SetVerbose(bool verb) { this->Verbose = verb; }
+
+  /** Set the file comparison object */
+  void SetFileTimeCache(cmFileTimeCache* fc) { this->FileTimeCache = fc; }
+
+  /** Store the dependencies in compiler_depend.db instead of listing
+      them in compiler_depend.make.  Objects older than one of their
+      dependencies are then removed by Update.  */
+  void SetUseDatabase(bool db) { this->UseDatabase = db; }
+
+  /** Update compiler_depend.make and compiler_depend.internal (or
+      compiler_depend.db) from the given list of alternating object file and depfile full paths.
+      Returns false if the dependency files cannot be written.  */
+  bool Update(std::vector<std::string> const& objectDepfilePairs);
+
+  /** Parse the prerequisites of a make-style depfile as written by
+      GCC-compatible compilers.  Returns false if the file cannot be
+      read.  */
+  static bool ParseDepfile(std::istream& is, std::vector<std::string>& deps);
+
+private:
+  bool ReadInternal(std::string const& internalFile,
+                    cmDepends::DependencyMap& deps);
+  bool WriteDependencies(std::string const& makeFile,
+                         std::string const& internalFile,
+                         cmDepends::DependencyMap const& deps);
+
+  cmLocalGenerator* LocalGenerator;
+  std::string TargetDirectory;
+  bool Verbose = false;
+  bool UseDatabase = false;
+  cmFileTimeCache* FileTimeCache = nullptr;
+};
+
+#endif
@@ -0,0 +1,281 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmDependsDatabase.h"
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+
+#  include "cmsys/Encoding.hxx"
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+// "CMDD" when read as a little-endian word.  A database written on a
+// machine with another byte order is not recognized and gets rebuilt.
+std::uint32_t const DatabaseMagic = 0x44444d43;
+std::uint32_t const DatabaseVersion = 1;
+
+// Size of the magic, version, path count and object count words.
+std::size_t const HeaderSize = 4 * sizeof(std::uint32_t);
+
+void AppendWord(std::string& out, std::uint32_t value)
+{
+  out.append(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+}
+
+cmDependsDatabase::~cmDependsDatabase()
+{
+  this->Close();
+}
+
+void cmDependsDatabase::Close()
+{
+  if (this->Data) {
+#if defined(_WIN32)
+    UnmapViewOfFile(this->Data);
+#else
+    munmap(const_cast<char*>(this->Data), this->Size);
+#endif
+  }
+  this->Data = nullptr;
+  this->Size = 0;
+  this->PathCount = 0;
+  this->Table = 0;
+  this->Objects.clear();
+}
+
+std::uint32_t cmDependsDatabase::Word(std::size_t offset) const
+{
+  std::uint32_t value;
+  std::memcpy(&value, this->Data + offset, sizeof(value));
+  return value;
+}
+
+bool cmDependsDatabase::Open(std::string const& file)
+{
+  this->Close();
+
+#if defined(_WIN32)
+  HANDLE hFile = CreateFileW(cmsys::Encoding::ToWide(file).c_str(),
+                             GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (hFile == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(hFile, &size) || size.QuadPart < LONGLONG(HeaderSize)) {
+    CloseHandle(hFile);
+    return false;
+  }
+  HANDLE hFileMapping =
+    CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(hFile);
+  if (hFileMapping == 0) {
+    return false;
+  }
+  // The view keeps the mapping and the file open.
+  LPVOID data = MapViewOfFile(hFileMapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(hFileMapping);
+  if (data == 0) {
+    return false;
+  }
+  this->Data = static_cast<char const*>(data);
+  this->Size = static_cast<std::size_t>(size.QuadPart);
+#else
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < off_t(HeaderSize)) {
+    close(fd);
+    return false;
+  }
+  std::size_t const size = static_cast<std::size_t>(st.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  this->Data = static_cast<char const*>(data);
+  this->Size = size;
+#endif
+
+  // Check the structure once so that the accessors need not.
+  std::size_t const words = this->Size / sizeof(std::uint32_t);
+  if (this->Word(0) != DatabaseMagic || this->Word(4) != DatabaseVersion) {
+    this->Close();
+    return false;
+  }
+  std::uint32_t const pathCount = this->Word(8);
+  std::uint32_t const objectCount = this->Word(12);
+  if (words < 5 + std::size_t(pathCount)) {
+    this->Close();
+    return false;
+  }
+  std::size_t const tableSizeOffset = HeaderSize + 4 * std::size_t(pathCount);
+  std::uint32_t const tableSize = this->Word(tableSizeOffset);
+  std::size_t const table = tableSizeOffset + 4;
+  if (this->Size - table < tableSize ||
+      (tableSize > 0 && this->Data[table + tableSize - 1])) {
+    this->Close();
+    return false;
+  }
+  for (std::uint32_t i = 0; i < pathCount; ++i) {
+    if (this->Word(HeaderSize + 4 * std::size_t(i)) >= tableSize) {
+      this->Close();
+      return false;
+    }
+  }
+  this->PathCount = pathCount;
+  this->Table = table;
+
+  // Locate the record of each object.
+  this->Objects.reserve(objectCount);
+  std::size_t offset = table + tableSize;
+  for (std::uint32_t i = 0; i < objectCount; ++i) {
+    if (this->Size - offset < 8 || this->Word(offset) >= pathCount) {
+      this->Close();
+      return false;
+    }
+    std::uint32_t const count = this->Word(offset + 4);
+    if ((this->Size - offset - 8) / 4 < count) {
+      this->Close();
+      return false;
+    }
+    for (std::uint32_t j = 0; j < count; ++j) {
+      if (this->Word(offset + 8 + 4 * std::size_t(j)) >= pathCount) {
+        this->Close();
+        return false;
+      }
+    }
+    this->Objects.push_back(offset);
+    offset += 8 + 4 * std::size_t(count);
+  }
+  return true;
+}
+
+char const* cmDependsDatabase::GetPath(std::uint32_t path) const
+{
+  return this->Data + this->Table +
+    this->Word(HeaderSize + 4 * std::size_t(path));
+}
+
+std::uint32_t cmDependsDatabase::GetObjectCount() const
+{
+  return static_cast<std::uint32_t>(this->Objects.size());
+}
+
+std::uint32_t cmDependsDatabase::GetObjectPath(std::uint32_t object) const
+{
+  return this->Word(this->Objects[object]);
+}
+
+std::uint32_t cmDependsDatabase::GetDependeeCount(std::uint32_t object) const
+{
+  return this->Word(this->Objects[object] + 4);
+}
+
+std::uint32_t cmDependsDatabase::GetDependee(std::uint32_t object,
+                                             std::uint32_t i) const
+{
+  return this->Word(this->Objects[object] + 8 + 4 * std::size_t(i));
+}
+
+void cmDependsDatabase::GetDependencies(std::uint32_t object,
+                                        cmDepends::DependencyMap& deps) const
+{
+  std::uint32_t const count = this->GetDependeeCount(object);
+  std::vector<std::string>& objectDeps =
+    deps[this->GetPath(this->GetObjectPath(object))];
+  objectDeps.reserve(objectDeps.size() + count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    objectDeps.emplace_back(this->GetPath(this->GetDependee(object, i)));
+  }
+}
+
+bool cmDependsDatabase::Load(std::string const& file,
+                             cmDepends::DependencyMap& deps)
+{
+  cmDependsDatabase db;
+  if (!db.Open(file)) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < db.GetObjectCount(); ++i) {
+    db.GetDependencies(i, deps);
+  }
+  return true;
+}
+
+bool cmDependsDatabase::Save(std::string const& file,
+                             cmDepends::DependencyMap const& deps)
+{
+  // Assign an index to each distinct path.
+  std::unordered_map<std::string, std::uint32_t> indices;
+  std::vector<std::string const*> paths;
+  auto index = [&indices, &paths](std::string const& path) {
+    auto const ins =
+      indices.emplace(path, static_cast<std::uint32_t>(paths.size()));
+    if (ins.second) {
+      paths.push_back(&ins.first->first);
+    }
+    return ins.first->second;
+  };
+  std::string records;
+  for (auto const& d : deps) {
+    AppendWord(records, index(d.first));
+    AppendWord(records, static_cast<std::uint32_t>(d.second.size()));
+    for (std::string const& dep : d.second) {
+      AppendWord(records, index(dep));
+    }
+  }
+
+  std::string table;
+  std::string header;
+  AppendWord(header, DatabaseMagic);
+  AppendWord(header, DatabaseVersion);
+  AppendWord(header, static_cast<std::uint32_t>(paths.size()));
+  AppendWord(header, static_cast<std::uint32_t>(deps.size()));
+  for (std::string const* path : paths) {
+    AppendWord(header, static_cast<std::uint32_t>(table.size()));
+    table.append(path->c_str(), path->size() + 1);
+  }
+  // Keep the records aligned to their word size.
+  table.resize((table.size() + 3) & ~std::string::size_type(3), '\0');
+  AppendWord(header, static_cast<std::uint32_t>(table.size()));
+
+  // Replace the database atomically so that an interrupted write does
+  // not leave a truncated file behind.
+  std::string const tmpFile = cmStrCat(file, ".tmp");
+  {
+    cmsys::ofstream fout(tmpFile.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fout) {
+      return false;
+    }
+    fout.write(header.data(), header.size());
+    fout.write(table.data(), table.size());
+    fout.write(records.data(), records.size());
+    if (!fout) {
+      fout.close();
+      cmSystemTools::RemoveFile(tmpFile);
+      return false;
+    }
+  }
+  return cmSystemTools::RenameFile(tmpFile, file);
+}
@@ -0,0 +1,81 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmDependsDatabase_h
+#define cmDependsDatabase_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cmDepends.h"
+
+/** \class cmDependsDatabase
+ * \brief Binary storage for the implicit dependencies of a target.
+ *
+ * The text depend.internal and depend.make files repeat the full path
+ * of every dependee for each object that includes it, and make has to
+ * parse all of them on every invocation.  A database file stores each
+ * path once in a string table and refers to it by index from the
+ * dependency lists of the objects.  All fields are 32-bit words in
+ * native byte order at fixed offsets so the file is mapped into memory
+ * and used without further parsing:
+ *
+ *   magic, version, path count, object count
+ *   path count * offset of the path in the string table
+ *   string table size, string table of null-terminated paths
+ *   object count * { object path index, dependee count,
+ *                    dependee count * dependee path index }
+ */
+class cmDependsDatabase
+{
+public:
+  cmDependsDatabase() = default;
+  ~cmDependsDatabase();
+
+  cmDependsDatabase(cmDependsDatabase const&) = delete;
+  cmDependsDatabase& operator=(cmDependsDatabase const&) = delete;
+
+  /** Map the given database file into memory.  Returns false if it does
+      not exist or was not written by this version.  */
+  bool Open(std::string const& file);
+
+  /** Get the number of distinct paths and the path of the given index.
+      Paths are referred to by their index in the object records.  */
+  std::uint32_t GetPathCount() const { return this->PathCount; }
+  char const* GetPath(std::uint32_t path) const;
+
+  /** Get the number of objects, the index of the path of an object, and
+      the number and path indices of its dependees.  */
+  std::uint32_t GetObjectCount() const;
+  std::uint32_t GetObjectPath(std::uint32_t object) const;
+  std::uint32_t GetDependeeCount(std::uint32_t object) const;
+  std::uint32_t GetDependee(std::uint32_t object, std::uint32_t i) const;
+
+  /** Add the dependencies stored in the given object record.  */
+  void GetDependencies(std::uint32_t object,
+                       cmDepends::DependencyMap& deps) const;
+
+  /** Read the dependencies stored in the given database file.  Returns
+      false if it does not exist or was not written by this version.  */
+  static bool Load(std::string const& file, cmDepends::DependencyMap& deps);
+
+  /** Replace the given database file with the given dependencies.  */
+  static bool Save(std::string const& file,
+                   cmDepends::DependencyMap const& deps);
+
+private:
+  void Close();
+  std::uint32_t Word(std::size_t offset) const;
+
+  char const* Data = nullptr;
+  std::size_t Size = 0;
+  std::uint32_t PathCount = 0;
+  std::size_t Table = 0;
+  // Offset of the record of each object.
+  std::vector<std::size_t> Objects;
+};
+
+#endif
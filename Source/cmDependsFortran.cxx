@@ -5,10 +5,14 @@
 #include "cmsys/FStream.hxx"
 #include <cassert>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <utility>
+#include <vector>
 
+#include "cmFileTime.h"
+#include "cmFileTimeCache.h"
 #include "cmFortranParser.h" /* Interface to parser object.  */
 #include "cmGeneratedFileStream.h"
 #include "cmLocalGenerator.h"
@@ -53,6 +57,26 @@ public:
   using ObjectInfoMap = std::map<std::string, cmFortranSourceInfo>;
   ObjectInfoMap ObjectInfo;
 
+  // Result of scanning a source file, now or by a previous run.
+  struct SourceScan
+  {
+    cmFortranSourceInfo Info;
+    // Modification times of the source and the files it includes.
+    std::map<std::string, cmFileTime::NSC> Times;
+    std::string Error;
+    bool Okay = false;
+  };
+  using SourceScanMap = std::map<std::string, SourceScan>;
+
+  // Scan results of the sources of the target.
+  SourceScanMap Scans;
+
+  // Scan results loaded from the cache file.  They are valid only if
+  // the sources were scanned with the same settings.
+  SourceScanMap CachedScans;
+  std::string CacheFileName;
+  std::string CacheSignature;
+
   cmFortranSourceInfo& CreateObjectInfo(const std::string& obj,
                                         const std::string& src)
   {
@@ -97,6 +121,12 @@ cmDependsFortran::cmDependsFortran(cmLocalGenerator* lg)
   this->CompilerId = mf->GetSafeDefinition("CMAKE_Fortran_COMPILER_ID");
   this->SModSep = mf->GetSafeDefinition("CMAKE_Fortran_SUBMODULE_SEP");
   this->SModExt = mf->GetSafeDefinition("CMAKE_Fortran_SUBMODULE_EXT");
+
+  // Cached scan results may be reused only with the same settings.
+  this->Internal->CacheSignature =
+    cmStrCat(this->CompilerId, '|', this->SModSep, '|', this->SModExt, '|',
+             cmJoin(this->PPDefinitions, ";"), '|',
+             cmJoin(this->IncludePath, ";"));
 }
 
 cmDependsFortran::~cmDependsFortran()
@@ -104,6 +134,87 @@ cmDependsFortran::~cmDependsFortran()
   delete this->Internal;
 }
 
+void cmDependsFortran::PrepareDependencies(
+  std::map<std::string, std::set<std::string>> const& dependencies)
+{
+  using SourceScan = cmDependsFortranInternals::SourceScan;
+  cmDependsFortranInternals::SourceScanMap& scans = this->Internal->Scans;
+
+  this->Internal->CacheFileName =
+    cmStrCat(this->TargetDirectory, "/fortran.scancache");
+  this->ReadCacheFile();
+
+  // Reuse the results of sources that did not change since they were
+  // scanned.  Every file the source includes must be unchanged, too.
+  std::vector<std::pair<std::string const, SourceScan>*> pending;
+  cmFileTime fileTime;
+  for (auto const& d : dependencies) {
+    for (std::string const& src : d.second) {
+      if (src.empty() || scans.find(src) != scans.end()) {
+        continue;
+      }
+      auto& entry = *scans.emplace(src, SourceScan()).first;
+      auto const ci = this->Internal->CachedScans.find(src);
+      if (ci != this->Internal->CachedScans.end()) {
+        bool unchanged = true;
+        for (auto const& t : ci->second.Times) {
+          if (!this->FileTimeCache->Load(t.first, fileTime) ||
+              fileTime.GetNS() != t.second) {
+            unchanged = false;
+            break;
+          }
+        }
+        if (unchanged) {
+          entry.second = std::move(ci->second);
+          continue;
+        }
+      }
+      pending.push_back(&entry);
+    }
+  }
+  this->Internal->CachedScans.clear();
+  if (pending.empty()) {
+    return;
+  }
+
+  auto scan = [this](std::string const& src, SourceScan& result) {
+    cmFileTime time;
+    bool const haveTime = time.Load(src);
+    result.Okay = this->ScanSource(src, result.Info, result.Error);
+    if (result.Okay && haveTime) {
+      // The source is stamped before it is parsed so that a change
+      // made meanwhile is not taken for the scanned content.
+      result.Times[src] = time.GetNS();
+      for (std::string const& i : result.Info.Includes) {
+        if (time.Load(i)) {
+          result.Times[i] = time.GetNS();
+        }
+      }
+    }
+  };
+
+  unsigned int const threadCount = GetScanThreadCount(pending.size());
+  bool scanned = false;
+  if (threadCount > 1) {
+    std::vector<std::function<void(unsigned int)>> jobs;
+    jobs.reserve(pending.size());
+    for (auto* entry : pending) {
+      jobs.emplace_back([&scan, entry](unsigned int /*worker*/) {
+        scan(entry->first, entry->second);
+      });
+    }
+    scanned = RunScanJobs(threadCount, std::move(jobs));
+  }
+  if (!scanned) {
+    for (auto* entry : pending) {
+      entry->second = SourceScan();
+      scan(entry->first, entry->second);
+    }
+  }
+
+  this->WriteCacheFile();
+}
+
 bool cmDependsFortran::WriteDependencies(const std::set<std::string>& sources,
                                          const std::string& obj,
                                          std::ostream& /*makeDepends*/,
@@ -119,31 +230,32 @@ bool cmDependsFortran::WriteDependencies(const std::set<std::string>& sources,
     return false;
   }
 
-  cmFortranCompiler fc;
-  fc.Id = this->CompilerId;
-  fc.SModSep = this->SModSep;
-  fc.SModExt = this->SModExt;
-
   bool okay = true;
   for (std::string const& src : sources) {
     // Get the information object for this source.
     cmFortranSourceInfo& info = this->Internal->CreateObjectInfo(obj, src);
 
-    // Create the parser object. The constructor takes info by reference,
-    // so we may look into the resulting objects later.
-    cmFortranParser parser(fc, this->IncludePath, this->PPDefinitions, info);
-
-    // Push on the starting file.
-    cmFortranParser_FilePush(&parser, src.c_str());
+    // Sources are normally scanned before by PrepareDependencies.
+    auto si = this->Internal->Scans.find(src);
+    if (si == this->Internal->Scans.end()) {
+      si = this->Internal->Scans
+             .emplace(src, cmDependsFortranInternals::SourceScan())
+             .first;
+      si->second.Okay =
+        this->ScanSource(src, si->second.Info, si->second.Error);
+    }
+    cmFortranSourceInfo const& scanned = si->second.Info;
+    info.Provides.insert(scanned.Provides.begin(), scanned.Provides.end());
+    info.Requires.insert(scanned.Requires.begin(), scanned.Requires.end());
+    info.Includes.insert(scanned.Includes.begin(), scanned.Includes.end());
 
-    // Parse the translation unit.
-    if (cmFortran_yyparse(parser.Scanner) != 0) {
+    if (!si->second.Okay) {
       // Failed to parse the file.  Report failure to write dependencies.
       okay = false;
       /* clang-format off */
       std::cerr <<
         "warning: failed to parse dependencies from Fortran source "
-        "'" << src << "': " << parser.Error << std::endl
+        "'" << src << "': " << si->second.Error << std::endl
         ;
       /* clang-format on */
     }
@@ -151,6 +263,118 @@ bool cmDependsFortran::WriteDependencies(const std::set<std::string>& sources,
   return okay;
 }
 
+bool cmDependsFortran::ScanSource(std::string const& src,
+                                  cmFortranSourceInfo& info,
+                                  std::string& error) const
+{
+  cmFortranCompiler fc;
+  fc.Id = this->CompilerId;
+  fc.SModSep = this->SModSep;
+  fc.SModExt = this->SModExt;
+
+  // Create the parser object. The constructor takes info by reference,
+  // so we may look into the resulting objects later.
+  cmFortranParser parser(fc, this->IncludePath, this->PPDefinitions, info);
+
+  // Push on the starting file.
+  cmFortranParser_FilePush(&parser, src.c_str());
+
+  // Parse the translation unit.
+  if (cmFortran_yyparse(parser.Scanner) != 0) {
+    error = parser.Error;
+    return false;
+  }
+  return true;
+}
+
+void cmDependsFortran::ReadCacheFile()
+{
+  cmsys::ifstream fin(this->Internal->CacheFileName.c_str());
+  if (!fin) {
+    return;
+  }
+
+  cmDependsFortranInternals::SourceScanMap& cache =
+    this->Internal->CachedScans;
+  cmDependsFortranInternals::SourceScan* current = nullptr;
+  bool haveSignature = false;
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    if (line.front() == '#') {
+      if (cmHasLiteralPrefix(line, "#Signature: ")) {
+        haveSignature = line.substr(12) == this->Internal->CacheSignature;
+      }
+      continue;
+    }
+    if (!haveSignature) {
+      // The sources were scanned with other settings.
+      break;
+    }
+    if (line.front() != ' ') {
+      current = &cache[line];
+      current->Okay = true;
+      continue;
+    }
+    if (current == nullptr || line.size() < 3) {
+      continue;
+    }
+    std::string value = line.substr(3);
+    switch (line[1]) {
+      case 't': {
+        std::string::size_type const pos = value.find(' ');
+        if (pos != std::string::npos) {
+          current->Times[value.substr(pos + 1)] =
+            std::strtoll(value.c_str(), nullptr, 10);
+        }
+      } break;
+      case 'p':
+        current->Info.Provides.insert(std::move(value));
+        break;
+      case 'r':
+        current->Info.Requires.insert(std::move(value));
+        break;
+      case 'i':
+        current->Info.Includes.insert(std::move(value));
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void cmDependsFortran::WriteCacheFile()
+{
+  cmGeneratedFileStream fout(this->Internal->CacheFileName);
+  if (!fout) {
+    return;
+  }
+  fout << "# CMAKE generated file: DO NOT EDIT!\n"
+       << "# Modules provided and required by the scanned sources.\n"
+       << "#Signature: " << this->Internal->CacheSignature << "\n\n";
+  for (auto const& s : this->Internal->Scans) {
+    // Sources that failed to parse are scanned again next time.
+    if (!s.second.Okay || s.second.Times.empty()) {
+      continue;
+    }
+    fout << s.first << "\n";
+    for (auto const& t : s.second.Times) {
+      fout << " t " << t.second << " " << t.first << "\n";
+    }
+    for (std::string const& p : s.second.Info.Provides) {
+      fout << " p " << p << "\n";
+    }
+    for (std::string const& r : s.second.Info.Requires) {
+      fout << " r " << r << "\n";
+    }
+    for (std::string const& i : s.second.Info.Includes) {
+      fout << " i " << i << "\n";
+    }
+  }
+}
+
 bool cmDependsFortran::Finalize(std::ostream& makeDepends,
                                 std::ostream& internalDepends)
 {
@@ -325,14 +549,22 @@ bool cmDependsFortran::WriteDependenciesReal(std::string const& obj,
   std::string binDir = this->LocalGenerator->GetBinaryDirectory();
   std::string obj_i = this->MaybeConvertToRelativePath(binDir, obj);
   std::string obj_m = cmSystemTools::ConvertToOutputPath(obj_i);
-  internalDepends << obj_i << std::endl;
-  internalDepends << " " << src << std::endl;
+  if (this->Dependencies) {
+    std::vector<std::string>& deps = (*this->Dependencies)[obj_i];
+    deps.push_back(src);
+    deps.insert(deps.end(), info.Includes.begin(), info.Includes.end());
+  } else {
+    internalDepends << obj_i << std::endl;
+    internalDepends << " " << src << std::endl;
+    for (std::string const& i : info.Includes) {
+      internalDepends << " " << i << std::endl;
+    }
+  }
   for (std::string const& i : info.Includes) {
     makeDepends << obj_m << ": "
                 << cmSystemTools::ConvertToOutputPath(
                      this->MaybeConvertToRelativePath(binDir, i))
                 << std::endl;
-    internalDepends << " " << i << std::endl;
   }
   makeDepends << std::endl;
 
@@ -6,6 +6,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <iosfwd>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -50,6 +51,13 @@ public:
                             const std::string& compilerId);
 
 protected:
+  // Scan the sources of all objects of the target concurrently.  The
+  // results of sources that did not change since the last scan are
+  // taken from the target's scan cache instead.
+  void PrepareDependencies(
+    std::map<std::string, std::set<std::string>> const& dependencies)
+    override;
+
   // Finalize the dependency information for the target.
   bool Finalize(std::ostream& makeDepends,
                 std::ostream& internalDepends) override;
@@ -89,6 +97,14 @@ protected:
 private:
   std::string MaybeConvertToRelativePath(std::string const& base,
                                          std::string const& path);
+
+  // Parse a source file for the modules it provides and requires.
+  bool ScanSource(std::string const& src, cmFortranSourceInfo& info,
+                  std::string& error) const;
+
+  // Load and store the results of previous scans of the target sources.
+  void ReadCacheFile();
+  void WriteCacheFile();
 };
 
 #endif
@@ -6,7 +6,9 @@
 #include "cmFileAPICMakeFiles.h"
 #include "cmFileAPICache.h"
 #include "cmFileAPICodemodel.h"
+#include "cmGeneratedFileStream.h"
 #include "cmGlobalGenerator.h"
+#include "cmJsonStreamWriter.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmTimestamp.h"
@@ -36,11 +38,6 @@ cmFileAPI::cmFileAPI(cmake* cm)
   rbuilder["strictRoot"] = true;
   this->JsonReader =
     std::unique_ptr<Json::CharReader>(rbuilder.newCharReader());
-
-  Json::StreamWriterBuilder wbuilder;
-  wbuilder["indentation"] = "\t";
-  this->JsonWriter =
-    std::unique_ptr<Json::StreamWriter>(wbuilder.newStreamWriter());
 }
 
 void cmFileAPI::ReadQueries()
@@ -145,33 +142,35 @@ std::string cmFileAPI::WriteJsonFile(
   Json::Value const& value, std::string const& prefix,
   std::string (*computeSuffix)(std::string const&))
 {
-  std::string fileName;
+  std::ostringstream content;
+  cmJsonStreamWriter writer(content);
+  writer.Value(value);
+  return this->WriteJsonFile(content.str(), prefix, computeSuffix);
+}
 
-  // Write the json file with a temporary name.
-  std::string const& tmpFile = this->APIv1 + "/tmp.json";
-  cmsys::ofstream ftmp(tmpFile.c_str());
-  this->JsonWriter->write(value, &ftmp);
-  ftmp << "\n";
-  ftmp.close();
-  if (!ftmp) {
-    cmSystemTools::RemoveFile(tmpFile);
-    return fileName;
-  }
+std::string cmFileAPI::WriteJsonFile(
+  std::string content, std::string const& prefix,
+  std::string (*computeSuffix)(std::string const&))
+{
+  content += '\n';
 
   // Compute the final name for the file.
-  fileName = prefix + "-" + computeSuffix(tmpFile) + ".json";
-
-  // Create the destination.
-  std::string file = this->APIv1 + "/reply";
-  cmSystemTools::MakeDirectory(file);
-  file += "/";
-  file += fileName;
+  std::string const fileName =
+    cmStrCat(prefix, '-', computeSuffix(content), ".json");
+  std::string const file = cmStrCat(this->APIv1, "/reply/", fileName);
 
   // If the final name already exists then assume it has proper content.
-  // Otherwise, atomically place the reply file at its final name
-  if (cmSystemTools::FileExists(file, true) ||
-      !cmSystemTools::RenameFile(tmpFile, file)) {
-    cmSystemTools::RemoveFile(tmpFile);
+  // Otherwise, atomically place the reply file at its final name.  Report
+  // a failure now, before the reply index can refer to the file.
+  if (!cmSystemTools::FileExists(file, true)) {
+    cmGeneratedFileStream fout(file);
+    fout << content;
+    fout.flush();
+    if (!fout.Close() || !cmSystemTools::FileExists(file, true)) {
+      cmSystemTools::Error(
+        cmStrCat("Failed to write file API reply file:\n  ", file));
+      return std::string();
+    }
   }
 
   // Record this among files we have just written.
@@ -192,10 +191,10 @@ Json::Value cmFileAPI::MaybeJsonFile(Json::Value in, std::string const& prefix)
   return out;
 }
 
-std::string cmFileAPI::ComputeSuffixHash(std::string const& file)
+std::string cmFileAPI::ComputeSuffixHash(std::string const& content)
 {
   cmCryptoHash hasher(cmCryptoHash::AlgoSHA3_256);
-  std::string hash = hasher.HashFile(file);
+  std::string hash = hasher.HashString(content);
   hash.resize(20, '0');
   return hash;
 }
@@ -383,14 +382,16 @@ Json::Value const& cmFileAPI::AddReplyIndexObject(Object const& o)
   }
 
   // Generate this reply object.
-  Json::Value const& object = this->BuildObject(o);
+  std::ostringstream content;
+  cmJsonStreamWriter writer(content);
+  Json::Value const& object = this->BuildObject(o, writer);
   assert(object.isObject());
 
   // Populate this index entry.
   indexEntry = Json::objectValue;
   indexEntry["kind"] = object["kind"];
   indexEntry["version"] = object["version"];
-  indexEntry["jsonFile"] = this->WriteJsonFile(object, ObjectName(o));
+  indexEntry["jsonFile"] = this->WriteJsonFile(content.str(), ObjectName(o));
   return indexEntry;
 }
 
@@ -420,22 +421,26 @@ Json::Value cmFileAPI::BuildVersion(unsigned int major, unsigned int minor)
   return version;
 }
 
-Json::Value cmFileAPI::BuildObject(Object const& object)
+Json::Value cmFileAPI::BuildObject(Object const& object,
+                                   cmJsonStreamWriter& writer)
 {
   Json::Value value;
 
+  // Some object kinds stream themselves to the writer.
   switch (object.Kind) {
     case ObjectKind::CodeModel:
-      value = this->BuildCodeModel(object);
+      value = this->BuildCodeModel(object, writer);
       break;
     case ObjectKind::Cache:
-      value = this->BuildCache(object);
+      value = this->BuildCache(object, writer);
       break;
     case ObjectKind::CMakeFiles:
       value = this->BuildCMakeFiles(object);
+      writer.Value(value);
       break;
     case ObjectKind::InternalTest:
       value = this->BuildInternalTest(object);
+      writer.Value(value);
       break;
   }
 
@@ -681,9 +686,10 @@ void cmFileAPI::BuildClientRequestCodeModel(
   }
 }
 
-Json::Value cmFileAPI::BuildCodeModel(Object const& object)
+Json::Value cmFileAPI::BuildCodeModel(Object const& object,
+                                      cmJsonStreamWriter& writer)
 {
-  Json::Value codemodel = cmFileAPICodemodelDump(*this, object.Version);
+  Json::Value codemodel = Json::objectValue;
   codemodel["kind"] = this->ObjectKindName(object.Kind);
 
   Json::Value& version = codemodel["version"];
@@ -693,6 +699,7 @@ Json::Value cmFileAPI::BuildCodeModel(Object const& object)
     return codemodel; // should be unreachable
   }
 
+  cmFileAPICodemodelDump(*this, object.Version, codemodel, writer);
   return codemodel;
 }
 
@@ -715,9 +722,10 @@ void cmFileAPI::BuildClientRequestCache(
   }
 }
 
-Json::Value cmFileAPI::BuildCache(Object const& object)
+Json::Value cmFileAPI::BuildCache(Object const& object,
+                                  cmJsonStreamWriter& writer)
 {
-  Json::Value cache = cmFileAPICacheDump(*this, object.Version);
+  Json::Value cache = Json::objectValue;
   cache["kind"] = this->ObjectKindName(object.Kind);
 
   Json::Value& version = cache["version"];
@@ -727,6 +735,7 @@ Json::Value cmFileAPI::BuildCache(Object const& object)
     return cache; // should be unreachable
   }
 
+  cmFileAPICacheDump(*this, object.Version, cache, writer);
   return cache;
 }
 
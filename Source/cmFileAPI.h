@@ -7,7 +7,6 @@
 
 #include "cm_jsoncpp_reader.h"
 #include "cm_jsoncpp_value.h"
-#include "cm_jsoncpp_writer.h"
 
 #include <map>
 #include <memory>
@@ -15,6 +14,7 @@
 #include <unordered_set>
 #include <vector>
 
+class cmJsonStreamWriter;
 class cmake;
 
 class cmFileAPI
@@ -36,6 +36,13 @@ public:
       and holding the original object.  Other JSON types are unchanged.  */
   Json::Value MaybeJsonFile(Json::Value in, std::string const& prefix);
 
+  /** Write the given JSON text to a file named with the given prefix.
+      Returns the name of the file, or an empty string if it could not
+      be written.  */
+  std::string WriteJsonFile(
+    std::string content, std::string const& prefix,
+    std::string (*computeSuffix)(std::string const&) = ComputeSuffixHash);
+
   /** Report file-api capabilities for cmake -E capabilities.  */
   static Json::Value ReportCapabilities();
 
@@ -140,7 +147,6 @@ private:
   std::map<Object, Json::Value> ReplyIndexObjects;
 
   std::unique_ptr<Json::CharReader> JsonReader;
-  std::unique_ptr<Json::StreamWriter> JsonWriter;
 
   bool ReadJsonFile(std::string const& file, Json::Value& value,
                     std::string& error);
@@ -167,7 +173,7 @@ private:
 
   static Json::Value BuildVersion(unsigned int major, unsigned int minor);
 
-  Json::Value BuildObject(Object const& object);
+  Json::Value BuildObject(Object const& object, cmJsonStreamWriter& writer);
 
   ClientRequests BuildClientRequests(Json::Value const& requests);
   ClientRequest BuildClientRequest(Json::Value const& request);
@@ -191,11 +197,12 @@ private:
 
   void BuildClientRequestCodeModel(
     ClientRequest& r, std::vector<RequestVersion> const& versions);
-  Json::Value BuildCodeModel(Object const& object);
+  Json::Value BuildCodeModel(Object const& object,
+                             cmJsonStreamWriter& writer);
 
   void BuildClientRequestCache(ClientRequest& r,
                                std::vector<RequestVersion> const& versions);
-  Json::Value BuildCache(Object const& object);
+  Json::Value BuildCache(Object const& object, cmJsonStreamWriter& writer);
 
   void BuildClientRequestCMakeFiles(
     ClientRequest& r, std::vector<RequestVersion> const& versions);
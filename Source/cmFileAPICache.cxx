@@ -3,14 +3,12 @@
 #include "cmFileAPICache.h"
 
 #include "cmFileAPI.h"
+#include "cmJsonStreamWriter.h"
 #include "cmState.h"
 #include "cmake.h"
 
-#include "cm_jsoncpp_value.h"
-
 #include <algorithm>
 #include <string>
-#include <utility>
 #include <vector>
 
 namespace {
@@ -20,87 +18,101 @@ class Cache
   cmFileAPI& FileAPI;
   unsigned long Version;
   cmState* State;
+  cmJsonStreamWriter& Writer;
 
-  Json::Value DumpEntries();
-  Json::Value DumpEntry(std::string const& name);
-  Json::Value DumpEntryProperties(std::string const& name);
-  Json::Value DumpEntryProperty(std::string const& name,
-                                std::string const& prop);
+  void DumpEntries();
+  void DumpEntry(std::string const& name);
+  void DumpEntryProperties(std::string const& name,
+                           std::vector<std::string> const& props);
+  void DumpEntryProperty(std::string const& name, std::string const& prop);
 
 public:
-  Cache(cmFileAPI& fileAPI, unsigned long version);
-  Json::Value Dump();
+  Cache(cmFileAPI& fileAPI, unsigned long version, cmJsonStreamWriter& writer);
+  void Dump(Json::Value const& object);
 };
 
-Cache::Cache(cmFileAPI& fileAPI, unsigned long version)
+Cache::Cache(cmFileAPI& fileAPI, unsigned long version,
+             cmJsonStreamWriter& writer)
   : FileAPI(fileAPI)
   , Version(version)
   , State(this->FileAPI.GetCMakeInstance()->GetState())
+  , Writer(writer)
 {
   static_cast<void>(this->Version);
 }
 
-Json::Value Cache::Dump()
+void Cache::Dump(Json::Value const& object)
 {
-  Json::Value cache = Json::objectValue;
-  cache["entries"] = DumpEntries();
-  return cache;
+  // Members are written in name order.
+  this->Writer.BeginObject();
+  this->Writer.Key("entries");
+  this->DumpEntries();
+  this->Writer.Key("kind");
+  this->Writer.Value(object["kind"]);
+  this->Writer.Key("version");
+  this->Writer.Value(object["version"]);
+  this->Writer.EndObject();
 }
 
-Json::Value Cache::DumpEntries()
+void Cache::DumpEntries()
 {
-  Json::Value entries = Json::arrayValue;
-
   std::vector<std::string> names = this->State->GetCacheEntryKeys();
   std::sort(names.begin(), names.end());
 
+  this->Writer.BeginArray();
   for (std::string const& name : names) {
-    entries.append(this->DumpEntry(name));
+    this->DumpEntry(name);
   }
-
-  return entries;
+  this->Writer.EndArray();
 }
 
-Json::Value Cache::DumpEntry(std::string const& name)
+void Cache::DumpEntry(std::string const& name)
 {
-  Json::Value entry = Json::objectValue;
-  entry["name"] = name;
-  entry["type"] =
-    cmState::CacheEntryTypeToString(this->State->GetCacheEntryType(name));
-  entry["value"] = this->State->GetCacheEntryValue(name);
-
-  Json::Value properties = this->DumpEntryProperties(name);
-  if (!properties.empty()) {
-    entry["properties"] = std::move(properties);
+  this->Writer.BeginObject();
+  this->Writer.Key("name");
+  this->Writer.Value(name);
+
+  std::vector<std::string> props =
+    this->State->GetCacheEntryPropertyList(name);
+  if (!props.empty()) {
+    std::sort(props.begin(), props.end());
+    this->Writer.Key("properties");
+    this->DumpEntryProperties(name, props);
   }
 
-  return entry;
+  this->Writer.Key("type");
+  this->Writer.Value(
+    cmState::CacheEntryTypeToString(this->State->GetCacheEntryType(name)));
+  this->Writer.Key("value");
+  this->Writer.Value(this->State->GetCacheEntryValue(name));
+  this->Writer.EndObject();
 }
 
-Json::Value Cache::DumpEntryProperties(std::string const& name)
+void Cache::DumpEntryProperties(std::string const& name,
+                                std::vector<std::string> const& props)
 {
-  Json::Value properties = Json::arrayValue;
-  std::vector<std::string> props =
-    this->State->GetCacheEntryPropertyList(name);
-  std::sort(props.begin(), props.end());
+  this->Writer.BeginArray();
   for (std::string const& prop : props) {
-    properties.append(this->DumpEntryProperty(name, prop));
+    this->DumpEntryProperty(name, prop);
   }
-  return properties;
+  this->Writer.EndArray();
 }
 
-Json::Value Cache::DumpEntryProperty(std::string const& name,
-                                     std::string const& prop)
+void Cache::DumpEntryProperty(std::string const& name,
+                              std::string const& prop)
 {
-  Json::Value property = Json::objectValue;
-  property["name"] = prop;
-  property["value"] = this->State->GetCacheEntryProperty(name, prop);
-  return property;
+  this->Writer.BeginObject();
+  this->Writer.Key("name");
+  this->Writer.Value(prop);
+  this->Writer.Key("value");
+  this->Writer.Value(this->State->GetCacheEntryProperty(name, prop));
+  this->Writer.EndObject();
 }
 }
 
-Json::Value cmFileAPICacheDump(cmFileAPI& fileAPI, unsigned long version)
+void cmFileAPICacheDump(cmFileAPI& fileAPI, unsigned long version,
+                        Json::Value const& object, cmJsonStreamWriter& writer)
 {
-  Cache cache(fileAPI, version);
-  return cache.Dump();
+  Cache cache(fileAPI, version, writer);
+  cache.Dump(object);
 }
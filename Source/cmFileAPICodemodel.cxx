@@ -11,6 +11,7 @@
 #include "cmInstallGenerator.h"
 #include "cmInstallSubdirectoryGenerator.h"
 #include "cmInstallTargetGenerator.h"
+#include "cmJsonStreamWriter.h"
 #include "cmLinkLineComputer.h"
 #include "cmListFileCache.h"
 #include "cmLocalGenerator.h"
@@ -37,6 +38,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -48,14 +50,16 @@ class Codemodel
 {
   cmFileAPI& FileAPI;
   unsigned long Version;
+  cmJsonStreamWriter& Writer;
 
-  Json::Value DumpPaths();
-  Json::Value DumpConfigurations();
-  Json::Value DumpConfiguration(std::string const& config);
+  void DumpPaths();
+  void DumpConfigurations();
+  void DumpConfiguration(std::string const& config);
 
 public:
-  Codemodel(cmFileAPI& fileAPI, unsigned long version);
-  Json::Value Dump();
+  Codemodel(cmFileAPI& fileAPI, unsigned long version,
+            cmJsonStreamWriter& writer);
+  void Dump(Json::Value const& object);
 };
 
 class CodemodelConfig
@@ -63,6 +67,7 @@ class CodemodelConfig
   cmFileAPI& FileAPI;
   unsigned long Version;
   std::string const& Config;
+  cmJsonStreamWriter& Writer;
   std::string TopSource;
   std::string TopBuild;
 
@@ -70,7 +75,7 @@ class CodemodelConfig
   {
     cmStateSnapshot Snapshot;
     cmLocalGenerator const* LocalGenerator = nullptr;
-    Json::Value TargetIndexes = Json::arrayValue;
+    std::vector<Json::ArrayIndex> TargetIndexes;
     Json::ArrayIndex ProjectIndex;
     bool HasInstallRule = false;
   };
@@ -84,36 +89,39 @@ class CodemodelConfig
     static const Json::ArrayIndex NoParentIndex =
       static_cast<Json::ArrayIndex>(-1);
     Json::ArrayIndex ParentIndex = NoParentIndex;
-    Json::Value ChildIndexes = Json::arrayValue;
-    Json::Value DirectoryIndexes = Json::arrayValue;
-    Json::Value TargetIndexes = Json::arrayValue;
+    std::vector<Json::ArrayIndex> ChildIndexes;
+    std::vector<Json::ArrayIndex> DirectoryIndexes;
+    std::vector<Json::ArrayIndex> TargetIndexes;
   };
   std::map<cmStateSnapshot, Json::ArrayIndex, cmStateSnapshot::StrictWeakOrder>
     ProjectMap;
   std::vector<Project> Projects;
 
+  std::vector<cmGeneratorTarget*> Targets;
+
   void ProcessDirectories();
+  void ProcessTargets();
 
   Json::ArrayIndex GetDirectoryIndex(cmLocalGenerator const* lg);
   Json::ArrayIndex GetDirectoryIndex(cmStateSnapshot s);
 
   Json::ArrayIndex AddProject(cmStateSnapshot s);
 
-  Json::Value DumpTargets();
-  Json::Value DumpTarget(cmGeneratorTarget* gt, Json::ArrayIndex ti);
+  void DumpTargets();
+  void DumpTarget(cmGeneratorTarget* gt);
 
-  Json::Value DumpDirectories();
-  Json::Value DumpDirectory(Directory& d);
+  void DumpDirectories();
+  void DumpDirectory(Directory& d);
 
-  Json::Value DumpProjects();
-  Json::Value DumpProject(Project& p);
+  void DumpProjects();
+  void DumpProject(Project& p);
 
-  Json::Value DumpMinimumCMakeVersion(cmStateSnapshot s);
+  void DumpMinimumCMakeVersion(std::string const& version);
 
 public:
   CodemodelConfig(cmFileAPI& fileAPI, unsigned long version,
-                  std::string const& config);
-  Json::Value Dump();
+                  std::string const& config, cmJsonStreamWriter& writer);
+  void Dump();
 };
 
 std::string RelativeIfUnder(std::string const& top, std::string const& in)
@@ -139,6 +147,16 @@ std::string TargetId(cmGeneratorTarget const* gt, std::string const& topBuild)
   return gt->GetName() + CMAKE_DIRECTORY_ID_SEP + hash;
 }
 
+void DumpIndexes(cmJsonStreamWriter& writer,
+                 std::vector<Json::ArrayIndex> const& indexes)
+{
+  writer.BeginArray();
+  for (Json::ArrayIndex i : indexes) {
+    writer.Value(i);
+  }
+  writer.EndArray();
+}
+
 class JBTIndex
 {
 public:
@@ -179,9 +197,17 @@ class BacktraceData
   std::unordered_map<std::string, Json::ArrayIndex> CommandMap;
   std::unordered_map<std::string, Json::ArrayIndex> FileMap;
   std::unordered_map<cmListFileContext const*, Json::ArrayIndex> NodeMap;
-  Json::Value Commands = Json::arrayValue;
-  Json::Value Files = Json::arrayValue;
-  Json::Value Nodes = Json::arrayValue;
+  std::vector<std::string> Commands;
+  std::vector<std::string> Files;
+
+  struct Node
+  {
+    Json::ArrayIndex File;
+    long Line = 0;
+    JBTIndex Command;
+    JBTIndex Parent;
+  };
+  std::vector<Node> Nodes;
 
   Json::ArrayIndex AddCommand(std::string const& command)
   {
@@ -189,7 +215,7 @@ class BacktraceData
     if (i == this->CommandMap.end()) {
       auto cmdIndex = static_cast<Json::ArrayIndex>(this->Commands.size());
       i = this->CommandMap.emplace(command, cmdIndex).first;
-      this->Commands.append(command);
+      this->Commands.push_back(command);
     }
     return i->second;
   }
@@ -200,7 +226,7 @@ class BacktraceData
     if (i == this->FileMap.end()) {
       auto fileIndex = static_cast<Json::ArrayIndex>(this->Files.size());
       i = this->FileMap.emplace(file, fileIndex).first;
-      this->Files.append(RelativeIfUnder(this->TopSource, file));
+      this->Files.push_back(RelativeIfUnder(this->TopSource, file));
     }
     return i->second;
   }
@@ -208,7 +234,7 @@ class BacktraceData
 public:
   BacktraceData(std::string topSource);
   JBTIndex Add(cmListFileBacktrace const& bt);
-  Json::Value Dump();
+  void Dump(cmJsonStreamWriter& writer);
 };
 
 BacktraceData::BacktraceData(std::string topSource)
@@ -228,32 +254,64 @@ JBTIndex BacktraceData::Add(cmListFileBacktrace const& bt)
     index.Index = found->second;
     return index;
   }
-  Json::Value entry = Json::objectValue;
-  entry["file"] = this->AddFile(top->FilePath);
-  if (top->Line) {
-    entry["line"] = static_cast<int>(top->Line);
-  }
+  Node node;
+  node.File = this->AddFile(top->FilePath);
+  node.Line = top->Line;
   if (!top->Name.empty()) {
-    entry["command"] = this->AddCommand(top->Name);
+    node.Command.Index = this->AddCommand(top->Name);
   }
-  if (JBTIndex parent = this->Add(bt.Pop())) {
-    entry["parent"] = parent.Index;
-  }
-  index.Index = this->NodeMap[top] = this->Nodes.size();
-  this->Nodes.append(std::move(entry)); // NOLINT(*)
+  node.Parent = this->Add(bt.Pop());
+  index.Index = this->NodeMap[top] =
+    static_cast<Json::ArrayIndex>(this->Nodes.size());
+  this->Nodes.push_back(node);
   return index;
 }
 
-Json::Value BacktraceData::Dump()
+void BacktraceData::Dump(cmJsonStreamWriter& writer)
 {
-  Json::Value backtraceGraph;
   this->CommandMap.clear();
   this->FileMap.clear();
   this->NodeMap.clear();
-  backtraceGraph["commands"] = std::move(this->Commands);
-  backtraceGraph["files"] = std::move(this->Files);
-  backtraceGraph["nodes"] = std::move(this->Nodes);
-  return backtraceGraph;
+
+  writer.BeginObject();
+  writer.Key("commands");
+  writer.BeginArray();
+  for (std::string const& command : this->Commands) {
+    writer.Value(command);
+  }
+  writer.EndArray();
+  writer.Key("files");
+  writer.BeginArray();
+  for (std::string const& file : this->Files) {
+    writer.Value(file);
+  }
+  writer.EndArray();
+  writer.Key("nodes");
+  writer.BeginArray();
+  for (Node const& node : this->Nodes) {
+    writer.BeginObject();
+    if (node.Command) {
+      writer.Key("command");
+      writer.Value(node.Command.Index);
+    }
+    writer.Key("file");
+    writer.Value(node.File);
+    if (node.Line) {
+      writer.Key("line");
+      writer.Value(static_cast<int>(node.Line));
+    }
+    if (node.Parent) {
+      writer.Key("parent");
+      writer.Value(node.Parent.Index);
+    }
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  this->Commands.clear();
+  this->Files.clear();
+  this->Nodes.clear();
 }
 
 struct CompileData
@@ -323,6 +381,7 @@ class Target
 {
   cmGeneratorTarget* GT;
   std::string const& Config;
+  cmJsonStreamWriter& Writer;
   std::string TopSource;
   std::string TopBuild;
   std::vector<cmSourceGroup> SourceGroupsLocal;
@@ -331,12 +390,11 @@ class Target
   std::map<std::string, CompileData> CompileDataMap;
 
   std::unordered_map<cmSourceFile const*, Json::ArrayIndex> SourceMap;
-  Json::Value Sources = Json::arrayValue;
 
   struct SourceGroup
   {
     std::string Name;
-    Json::Value SourceIndexes = Json::arrayValue;
+    std::vector<Json::ArrayIndex> SourceIndexes;
   };
   std::unordered_map<cmSourceGroup const*, Json::ArrayIndex> SourceGroupsMap;
   std::vector<SourceGroup> SourceGroups;
@@ -344,86 +402,122 @@ class Target
   struct CompileGroup
   {
     std::unordered_map<CompileData, Json::ArrayIndex>::iterator Entry;
-    Json::Value SourceIndexes = Json::arrayValue;
+    std::vector<Json::ArrayIndex> SourceIndexes;
+  };
+
+  struct LinkCommandFragment
+  {
+    JBT<std::string> Fragment;
+    const char* Role;
   };
   std::unordered_map<CompileData, Json::ArrayIndex> CompileGroupMap;
   std::vector<CompileGroup> CompileGroups;
 
+  struct Source
+  {
+    std::string Path;
+    bool IsGenerated = false;
+    JBTIndex Backtrace;
+    static const Json::ArrayIndex NoIndex = static_cast<Json::ArrayIndex>(-1);
+    Json::ArrayIndex SourceGroupIndex = NoIndex;
+    Json::ArrayIndex CompileGroupIndex = NoIndex;
+  };
+  std::vector<Source> Sources;
+
+  JBTIndex Backtrace;
+  std::vector<JBT<std::string>> InstallDestinations;
+  std::vector<LinkCommandFragment> LinkCommandFragments;
+  std::vector<JBT<std::string>> Dependencies;
+
   template <typename T>
   JBT<T> ToJBT(BT<T> const& bt)
   {
     return JBT<T>(bt.Value, this->Backtraces.Add(bt.Backtrace));
   }
 
+  void Process();
   void ProcessLanguages();
   void ProcessLanguage(std::string const& lang);
+  void ProcessSources();
+  void ProcessSource(cmGeneratorTarget::SourceAndKind const& sk,
+                     Json::ArrayIndex si);
 
   Json::ArrayIndex AddSourceGroup(cmSourceGroup* sg, Json::ArrayIndex si);
   CompileData BuildCompileData(cmSourceFile* sf);
   CompileData MergeCompileData(CompileData const& fd);
   Json::ArrayIndex AddSourceCompileGroup(cmSourceFile* sf,
                                          Json::ArrayIndex si);
-  void AddBacktrace(Json::Value& object, cmListFileBacktrace const& bt);
-  void AddBacktrace(Json::Value& object, JBTIndex bt);
-  Json::Value DumpPaths();
-  Json::Value DumpCompileData(CompileData const& cd);
-  Json::Value DumpInclude(CompileData::IncludeEntry const& inc);
-  Json::Value DumpDefine(JBT<std::string> const& def);
-  Json::Value DumpSources();
-  Json::Value DumpSource(cmGeneratorTarget::SourceAndKind const& sk,
-                         Json::ArrayIndex si);
-  Json::Value DumpSourceGroups();
-  Json::Value DumpSourceGroup(SourceGroup& sg);
-  Json::Value DumpCompileGroups();
-  Json::Value DumpCompileGroup(CompileGroup& cg);
-  Json::Value DumpSysroot(std::string const& path);
-  Json::Value DumpInstall();
-  Json::Value DumpInstallPrefix();
-  Json::Value DumpInstallDestinations();
-  Json::Value DumpInstallDestination(cmInstallTargetGenerator* itGen);
-  Json::Value DumpArtifacts();
-  Json::Value DumpLink();
-  Json::Value DumpArchive();
-  Json::Value DumpLinkCommandFragments();
-  Json::Value DumpCommandFragments(std::vector<JBT<std::string>> const& frags);
-  Json::Value DumpCommandFragment(JBT<std::string> const& frag,
-                                  std::string const& role = std::string());
-  Json::Value DumpDependencies();
-  Json::Value DumpDependency(cmTargetDepend const& td);
-  Json::Value DumpFolder();
+  std::vector<std::string> GetArtifacts();
+  std::vector<LinkCommandFragment> GetLinkCommandFragments();
+  void DumpBacktrace(JBTIndex bt);
+  void DumpPaths();
+  void DumpInclude(CompileData::IncludeEntry const& inc);
+  void DumpDefine(JBT<std::string> const& def);
+  void DumpSources();
+  void DumpSource(Source const& s);
+  void DumpSourceGroups();
+  void DumpSourceGroup(SourceGroup& sg);
+  void DumpCompileGroups();
+  void DumpCompileGroup(CompileGroup& cg);
+  void DumpSysroot(std::string const& path);
+  void DumpInstall();
+  void DumpInstallPrefix();
+  void DumpInstallDestinations();
+  void DumpInstallDestination(JBT<std::string> const& dest);
+  void DumpArtifacts(std::vector<std::string> const& artifacts);
+  void DumpLink();
+  void DumpArchive();
+  void DumpLinkCommandFragments();
+  void DumpCommandFragments(std::vector<JBT<std::string>> const& frags);
+  void DumpCommandFragment(JBT<std::string> const& frag,
+                           const char* role = nullptr);
+  void DumpDependencies();
+  void DumpDependency(JBT<std::string> const& dep);
+  void DumpFolder(const char* folder);
 
 public:
-  Target(cmGeneratorTarget* gt, std::string const& config);
-  Json::Value Dump();
+  Target(cmGeneratorTarget* gt, std::string const& config,
+         cmJsonStreamWriter& writer);
+  void Dump();
 };
 
-Codemodel::Codemodel(cmFileAPI& fileAPI, unsigned long version)
+Codemodel::Codemodel(cmFileAPI& fileAPI, unsigned long version,
+                     cmJsonStreamWriter& writer)
   : FileAPI(fileAPI)
   , Version(version)
+  , Writer(writer)
 {
 }
 
-Json::Value Codemodel::Dump()
-{
-  Json::Value codemodel = Json::objectValue;
-
-  codemodel["paths"] = this->DumpPaths();
-  codemodel["configurations"] = this->DumpConfigurations();
-
-  return codemodel;
+void Codemodel::Dump(Json::Value const& object)
+{
+  // Members are written in name order throughout.
+  this->Writer.BeginObject();
+  this->Writer.Key("configurations");
+  this->DumpConfigurations();
+  this->Writer.Key("kind");
+  this->Writer.Value(object["kind"]);
+  this->Writer.Key("paths");
+  this->DumpPaths();
+  this->Writer.Key("version");
+  this->Writer.Value(object["version"]);
+  this->Writer.EndObject();
 }
 
-Json::Value Codemodel::DumpPaths()
+void Codemodel::DumpPaths()
 {
-  Json::Value paths = Json::objectValue;
-  paths["source"] = this->FileAPI.GetCMakeInstance()->GetHomeDirectory();
-  paths["build"] = this->FileAPI.GetCMakeInstance()->GetHomeOutputDirectory();
-  return paths;
+  this->Writer.BeginObject();
+  this->Writer.Key("build");
+  this->Writer.Value(
+    this->FileAPI.GetCMakeInstance()->GetHomeOutputDirectory());
+  this->Writer.Key("source");
+  this->Writer.Value(this->FileAPI.GetCMakeInstance()->GetHomeDirectory());
+  this->Writer.EndObject();
 }
 
-Json::Value Codemodel::DumpConfigurations()
+void Codemodel::DumpConfigurations()
 {
-  Json::Value configurations = Json::arrayValue;
+  this->Writer.BeginArray();
   cmGlobalGenerator* gg =
     this->FileAPI.GetCMakeInstance()->GetGlobalGenerator();
   auto makefiles = gg->GetMakefiles();
@@ -431,38 +525,49 @@ Json::Value Codemodel::DumpConfigurations()
     std::vector<std::string> const& configs =
       makefiles[0]->GetGeneratorConfigs();
     for (std::string const& config : configs) {
-      configurations.append(this->DumpConfiguration(config));
+      this->DumpConfiguration(config);
     }
   }
-  return configurations;
+  this->Writer.EndArray();
 }
 
-Json::Value Codemodel::DumpConfiguration(std::string const& config)
+void Codemodel::DumpConfiguration(std::string const& config)
 {
-  CodemodelConfig configuration(this->FileAPI, this->Version, config);
-  return configuration.Dump();
+  CodemodelConfig configuration(this->FileAPI, this->Version, config,
+                                this->Writer);
+  configuration.Dump();
 }
 
 CodemodelConfig::CodemodelConfig(cmFileAPI& fileAPI, unsigned long version,
-                                 std::string const& config)
+                                 std::string const& config,
+                                 cmJsonStreamWriter& writer)
   : FileAPI(fileAPI)
   , Version(version)
   , Config(config)
+  , Writer(writer)
   , TopSource(this->FileAPI.GetCMakeInstance()->GetHomeDirectory())
   , TopBuild(this->FileAPI.GetCMakeInstance()->GetHomeOutputDirectory())
 {
   static_cast<void>(this->Version);
 }
 
-Json::Value CodemodelConfig::Dump()
+void CodemodelConfig::Dump()
 {
-  Json::Value configuration = Json::objectValue;
-  configuration["name"] = this->Config;
+  // The directories and projects refer to the targets, so index the
+  // targets before writing them last.
   this->ProcessDirectories();
-  configuration["targets"] = this->DumpTargets();
-  configuration["directories"] = this->DumpDirectories();
-  configuration["projects"] = this->DumpProjects();
-  return configuration;
+  this->ProcessTargets();
+
+  this->Writer.BeginObject();
+  this->Writer.Key("directories");
+  this->DumpDirectories();
+  this->Writer.Key("name");
+  this->Writer.Value(this->Config);
+  this->Writer.Key("projects");
+  this->DumpProjects();
+  this->Writer.Key("targets");
+  this->DumpTargets();
+  this->Writer.EndObject();
 }
 
 void CodemodelConfig::ProcessDirectories()
@@ -483,7 +588,8 @@ void CodemodelConfig::ProcessDirectories()
     this->DirectoryMap[d.Snapshot] = directoryIndex;
 
     d.ProjectIndex = this->AddProject(d.Snapshot);
-    this->Projects[d.ProjectIndex].DirectoryIndexes.append(directoryIndex);
+    this->Projects[d.ProjectIndex].DirectoryIndexes.push_back(
+      directoryIndex);
   }
 
   // Update directories in reverse order to process children before parents.
@@ -542,15 +648,13 @@ Json::ArrayIndex CodemodelConfig::AddProject(cmStateSnapshot s)
   if (ps.IsValid()) {
     Json::ArrayIndex const parentDirIndex = this->GetDirectoryIndex(ps);
     p.ParentIndex = this->Directories[parentDirIndex].ProjectIndex;
-    this->Projects[p.ParentIndex].ChildIndexes.append(projectIndex);
+    this->Projects[p.ParentIndex].ChildIndexes.push_back(projectIndex);
   }
   return projectIndex;
 }
 
-Json::Value CodemodelConfig::DumpTargets()
+void CodemodelConfig::ProcessTargets()
 {
-  Json::Value targets = Json::arrayValue;
-
   std::vector<cmGeneratorTarget*> targetList;
   cmGlobalGenerator* gg =
     this->FileAPI.GetCMakeInstance()->GetGlobalGenerator();
@@ -568,16 +672,28 @@ Json::Value CodemodelConfig::DumpTargets()
       continue;
     }
 
-    targets.append(this->DumpTarget(gt, targets.size()));
+    // Cross-reference directory and project containing target.
+    auto ti = static_cast<Json::ArrayIndex>(this->Targets.size());
+    Json::ArrayIndex di = this->GetDirectoryIndex(gt->GetLocalGenerator());
+    this->Directories[di].TargetIndexes.push_back(ti);
+    Json::ArrayIndex pi = this->Directories[di].ProjectIndex;
+    this->Projects[pi].TargetIndexes.push_back(ti);
+
+    this->Targets.push_back(gt);
   }
+}
 
-  return targets;
+void CodemodelConfig::DumpTargets()
+{
+  this->Writer.BeginArray();
+  for (cmGeneratorTarget* gt : this->Targets) {
+    this->DumpTarget(gt);
+  }
+  this->Writer.EndArray();
 }
 
-Json::Value CodemodelConfig::DumpTarget(cmGeneratorTarget* gt,
-                                        Json::ArrayIndex ti)
+void CodemodelConfig::DumpTarget(cmGeneratorTarget* gt)
 {
-  Target t(gt, this->Config);
   std::string prefix = "target-" + gt->GetName();
   for (char& c : prefix) {
     // CMP0037 OLD behavior allows slashes in target names.  Remove them.
@@ -588,120 +704,143 @@ Json::Value CodemodelConfig::DumpTarget(cmGeneratorTarget* gt,
   if (!this->Config.empty()) {
     prefix += "-" + this->Config;
   }
-  Json::Value target = this->FileAPI.MaybeJsonFile(t.Dump(), prefix);
-  target["name"] = gt->GetName();
-  target["id"] = TargetId(gt, this->TopBuild);
-
-  // Cross-reference directory containing target.
-  Json::ArrayIndex di = this->GetDirectoryIndex(gt->GetLocalGenerator());
-  target["directoryIndex"] = di;
-  this->Directories[di].TargetIndexes.append(ti);
 
-  // Cross-reference project containing target.
-  Json::ArrayIndex pi = this->Directories[di].ProjectIndex;
-  target["projectIndex"] = pi;
-  this->Projects[pi].TargetIndexes.append(ti);
+  // Each target has a reply file of its own, written by its own writer.
+  // This stays on the main thread.  Walking a target fills caches of
+  // cmGeneratorTarget that are not synchronized.
+  std::string jsonFile;
+  {
+    std::ostringstream content;
+    cmJsonStreamWriter targetWriter(content);
+    Target t(gt, this->Config, targetWriter);
+    t.Dump();
+    jsonFile = this->FileAPI.WriteJsonFile(content.str(), prefix);
+  }
 
-  return target;
+  Json::ArrayIndex di = this->GetDirectoryIndex(gt->GetLocalGenerator());
+  this->Writer.BeginObject();
+  this->Writer.Key("directoryIndex");
+  this->Writer.Value(di);
+  this->Writer.Key("id");
+  this->Writer.Value(TargetId(gt, this->TopBuild));
+  this->Writer.Key("jsonFile");
+  this->Writer.Value(jsonFile);
+  this->Writer.Key("name");
+  this->Writer.Value(gt->GetName());
+  this->Writer.Key("projectIndex");
+  this->Writer.Value(this->Directories[di].ProjectIndex);
+  this->Writer.EndObject();
 }
 
-Json::Value CodemodelConfig::DumpDirectories()
+void CodemodelConfig::DumpDirectories()
 {
-  Json::Value directories = Json::arrayValue;
+  this->Writer.BeginArray();
   for (Directory& d : this->Directories) {
-    directories.append(this->DumpDirectory(d));
+    this->DumpDirectory(d);
   }
-  return directories;
+  this->Writer.EndArray();
 }
 
-Json::Value CodemodelConfig::DumpDirectory(Directory& d)
+void CodemodelConfig::DumpDirectory(Directory& d)
 {
-  Json::Value directory = Json::objectValue;
-
-  std::string sourceDir = d.Snapshot.GetDirectory().GetCurrentSource();
-  directory["source"] = RelativeIfUnder(this->TopSource, sourceDir);
+  this->Writer.BeginObject();
 
   std::string buildDir = d.Snapshot.GetDirectory().GetCurrentBinary();
-  directory["build"] = RelativeIfUnder(this->TopBuild, buildDir);
-
-  cmStateSnapshot parentDir = d.Snapshot.GetBuildsystemDirectoryParent();
-  if (parentDir.IsValid()) {
-    directory["parentIndex"] = this->GetDirectoryIndex(parentDir);
-  }
+  this->Writer.Key("build");
+  this->Writer.Value(RelativeIfUnder(this->TopBuild, buildDir));
 
-  Json::Value childIndexes = Json::arrayValue;
+  std::vector<Json::ArrayIndex> childIndexes;
   for (cmStateSnapshot const& child : d.Snapshot.GetChildren()) {
-    childIndexes.append(
+    childIndexes.push_back(
       this->GetDirectoryIndex(child.GetBuildsystemDirectory()));
   }
   if (!childIndexes.empty()) {
-    directory["childIndexes"] = std::move(childIndexes);
+    this->Writer.Key("childIndexes");
+    DumpIndexes(this->Writer, childIndexes);
   }
 
-  directory["projectIndex"] = d.ProjectIndex;
+  if (d.HasInstallRule) {
+    this->Writer.Key("hasInstallRule");
+    this->Writer.Value(true);
+  }
 
-  if (!d.TargetIndexes.empty()) {
-    directory["targetIndexes"] = std::move(d.TargetIndexes);
+  if (std::string const* def =
+        d.Snapshot.GetDefinition("CMAKE_MINIMUM_REQUIRED_VERSION")) {
+    this->Writer.Key("minimumCMakeVersion");
+    this->DumpMinimumCMakeVersion(*def);
   }
 
-  Json::Value minimumCMakeVersion = this->DumpMinimumCMakeVersion(d.Snapshot);
-  if (!minimumCMakeVersion.isNull()) {
-    directory["minimumCMakeVersion"] = std::move(minimumCMakeVersion);
+  cmStateSnapshot parentDir = d.Snapshot.GetBuildsystemDirectoryParent();
+  if (parentDir.IsValid()) {
+    this->Writer.Key("parentIndex");
+    this->Writer.Value(this->GetDirectoryIndex(parentDir));
   }
 
-  if (d.HasInstallRule) {
-    directory["hasInstallRule"] = true;
+  this->Writer.Key("projectIndex");
+  this->Writer.Value(d.ProjectIndex);
+
+  std::string sourceDir = d.Snapshot.GetDirectory().GetCurrentSource();
+  this->Writer.Key("source");
+  this->Writer.Value(RelativeIfUnder(this->TopSource, sourceDir));
+
+  if (!d.TargetIndexes.empty()) {
+    this->Writer.Key("targetIndexes");
+    DumpIndexes(this->Writer, d.TargetIndexes);
   }
 
-  return directory;
+  this->Writer.EndObject();
 }
 
-Json::Value CodemodelConfig::DumpProjects()
+void CodemodelConfig::DumpProjects()
 {
-  Json::Value projects = Json::arrayValue;
+  this->Writer.BeginArray();
   for (Project& p : this->Projects) {
-    projects.append(this->DumpProject(p));
+    this->DumpProject(p);
   }
-  return projects;
+  this->Writer.EndArray();
 }
 
-Json::Value CodemodelConfig::DumpProject(Project& p)
+void CodemodelConfig::DumpProject(Project& p)
 {
-  Json::Value project = Json::objectValue;
-
-  project["name"] = p.Snapshot.GetProjectName();
-
-  if (p.ParentIndex != Project::NoParentIndex) {
-    project["parentIndex"] = p.ParentIndex;
-  }
+  this->Writer.BeginObject();
 
   if (!p.ChildIndexes.empty()) {
-    project["childIndexes"] = std::move(p.ChildIndexes);
+    this->Writer.Key("childIndexes");
+    DumpIndexes(this->Writer, p.ChildIndexes);
   }
 
-  project["directoryIndexes"] = std::move(p.DirectoryIndexes);
+  this->Writer.Key("directoryIndexes");
+  DumpIndexes(this->Writer, p.DirectoryIndexes);
+
+  this->Writer.Key("name");
+  this->Writer.Value(p.Snapshot.GetProjectName());
+
+  if (p.ParentIndex != Project::NoParentIndex) {
+    this->Writer.Key("parentIndex");
+    this->Writer.Value(p.ParentIndex);
+  }
 
   if (!p.TargetIndexes.empty()) {
-    project["targetIndexes"] = std::move(p.TargetIndexes);
+    this->Writer.Key("targetIndexes");
+    DumpIndexes(this->Writer, p.TargetIndexes);
   }
 
-  return project;
+  this->Writer.EndObject();
 }
 
-Json::Value CodemodelConfig::DumpMinimumCMakeVersion(cmStateSnapshot s)
+void CodemodelConfig::DumpMinimumCMakeVersion(std::string const& version)
 {
-  Json::Value minimumCMakeVersion;
-  if (std::string const* def =
-        s.GetDefinition("CMAKE_MINIMUM_REQUIRED_VERSION")) {
-    minimumCMakeVersion = Json::objectValue;
-    minimumCMakeVersion["string"] = *def;
-  }
-  return minimumCMakeVersion;
+  this->Writer.BeginObject();
+  this->Writer.Key("string");
+  this->Writer.Value(version);
+  this->Writer.EndObject();
 }
 
-Target::Target(cmGeneratorTarget* gt, std::string const& config)
+Target::Target(cmGeneratorTarget* gt, std::string const& config,
+               cmJsonStreamWriter& writer)
   : GT(gt)
   , Config(config)
+  , Writer(writer)
   , TopSource(gt->GetGlobalGenerator()->GetCMakeInstance()->GetHomeDirectory())
   , TopBuild(
       gt->GetGlobalGenerator()->GetCMakeInstance()->GetHomeOutputDirectory())
@@ -710,72 +849,125 @@ Target::Target(cmGeneratorTarget* gt, std::string const& config)
 {
 }
 
-Json::Value Target::Dump()
+void Target::Dump()
 {
-  Json::Value target = Json::objectValue;
+  // The backtrace graph is written before most of the members that refer
+  // to it, so find everything that does first.
+  this->Process();
 
   cmStateEnums::TargetType const type = this->GT->GetType();
 
-  target["name"] = this->GT->GetName();
-  target["type"] = cmState::GetTargetTypeName(type);
-  target["id"] = TargetId(this->GT, this->TopBuild);
-  target["paths"] = this->DumpPaths();
-  if (this->GT->Target->GetIsGeneratorProvided()) {
-    target["isGeneratorProvided"] = true;
-  }
-
-  this->AddBacktrace(target, this->GT->GetBacktrace());
+  this->Writer.BeginObject();
 
-  if (this->GT->Target->GetHaveInstallRule()) {
-    target["install"] = this->DumpInstall();
+  if (type == cmStateEnums::STATIC_LIBRARY) {
+    this->Writer.Key("archive");
+    this->DumpArchive();
   }
 
   if (this->GT->HaveWellDefinedOutputFiles()) {
-    Json::Value artifacts = this->DumpArtifacts();
+    std::vector<std::string> const artifacts = this->GetArtifacts();
     if (!artifacts.empty()) {
-      target["artifacts"] = std::move(artifacts);
+      this->Writer.Key("artifacts");
+      this->DumpArtifacts(artifacts);
     }
   }
 
+  this->DumpBacktrace(this->Backtrace);
+  this->Writer.Key("backtraceGraph");
+  this->Backtraces.Dump(this->Writer);
+
+  if (!this->CompileGroups.empty()) {
+    this->Writer.Key("compileGroups");
+    this->DumpCompileGroups();
+  }
+
+  if (!this->Dependencies.empty()) {
+    this->Writer.Key("dependencies");
+    this->DumpDependencies();
+  }
+
+  if (const char* folder = this->GT->GetProperty("FOLDER")) {
+    this->Writer.Key("folder");
+    this->DumpFolder(folder);
+  }
+
+  this->Writer.Key("id");
+  this->Writer.Value(TargetId(this->GT, this->TopBuild));
+
+  if (this->GT->Target->GetHaveInstallRule()) {
+    this->Writer.Key("install");
+    this->DumpInstall();
+  }
+
+  if (this->GT->Target->GetIsGeneratorProvided()) {
+    this->Writer.Key("isGeneratorProvided");
+    this->Writer.Value(true);
+  }
+
   if (type == cmStateEnums::EXECUTABLE ||
       type == cmStateEnums::SHARED_LIBRARY ||
       type == cmStateEnums::MODULE_LIBRARY) {
-    target["nameOnDisk"] = this->GT->GetFullName(this->Config);
-    target["link"] = this->DumpLink();
-  } else if (type == cmStateEnums::STATIC_LIBRARY) {
-    target["nameOnDisk"] = this->GT->GetFullName(this->Config);
-    target["archive"] = this->DumpArchive();
+    this->Writer.Key("link");
+    this->DumpLink();
+  }
+
+  this->Writer.Key("name");
+  this->Writer.Value(this->GT->GetName());
+
+  if (type == cmStateEnums::EXECUTABLE ||
+      type == cmStateEnums::SHARED_LIBRARY ||
+      type == cmStateEnums::MODULE_LIBRARY ||
+      type == cmStateEnums::STATIC_LIBRARY) {
+    this->Writer.Key("nameOnDisk");
+    this->Writer.Value(this->GT->GetFullName(this->Config));
   }
 
-  Json::Value dependencies = this->DumpDependencies();
-  if (!dependencies.empty()) {
-    target["dependencies"] = dependencies;
+  this->Writer.Key("paths");
+  this->DumpPaths();
+
+  if (!this->SourceGroups.empty()) {
+    this->Writer.Key("sourceGroups");
+    this->DumpSourceGroups();
   }
 
-  {
-    this->ProcessLanguages();
+  this->Writer.Key("sources");
+  this->DumpSources();
 
-    target["sources"] = this->DumpSources();
+  this->Writer.Key("type");
+  this->Writer.Value(cmState::GetTargetTypeName(type));
 
-    Json::Value folder = this->DumpFolder();
-    if (!folder.isNull()) {
-      target["folder"] = std::move(folder);
-    }
+  this->Writer.EndObject();
+}
 
-    Json::Value sourceGroups = this->DumpSourceGroups();
-    if (!sourceGroups.empty()) {
-      target["sourceGroups"] = std::move(sourceGroups);
-    }
+void Target::Process()
+{
+  // Add the backtraces in the order in which the graph numbers them.
+  this->Backtrace = this->Backtraces.Add(this->GT->GetBacktrace());
 
-    Json::Value compileGroups = this->DumpCompileGroups();
-    if (!compileGroups.empty()) {
-      target["compileGroups"] = std::move(compileGroups);
+  if (this->GT->Target->GetHaveInstallRule()) {
+    for (auto itGen : this->GT->Target->GetInstallGenerators()) {
+      JBTIndex const bt = this->Backtraces.Add(itGen->GetBacktrace());
+      this->InstallDestinations.emplace_back(
+        itGen->GetDestination(this->Config), bt);
     }
   }
 
-  target["backtraceGraph"] = this->Backtraces.Dump();
+  cmStateEnums::TargetType const type = this->GT->GetType();
+  if (type == cmStateEnums::EXECUTABLE ||
+      type == cmStateEnums::SHARED_LIBRARY ||
+      type == cmStateEnums::MODULE_LIBRARY ||
+      type == cmStateEnums::STATIC_LIBRARY) {
+    this->LinkCommandFragments = this->GetLinkCommandFragments();
+  }
+
+  for (cmTargetDepend const& td :
+       this->GT->GetGlobalGenerator()->GetTargetDirectDepends(this->GT)) {
+    JBTIndex const bt = this->Backtraces.Add(td.GetBacktrace());
+    this->Dependencies.emplace_back(TargetId(td, this->TopBuild), bt);
+  }
 
-  return target;
+  this->ProcessLanguages();
+  this->ProcessSources();
 }
 
 void Target::ProcessLanguages()
@@ -835,7 +1027,7 @@ Json::ArrayIndex Target::AddSourceGroup(cmSourceGroup* sg, Json::ArrayIndex si)
     g.Name = sg->GetFullName();
     this->SourceGroups.push_back(std::move(g));
   }
-  this->SourceGroups[i->second].SourceIndexes.append(si);
+  this->SourceGroups[i->second].SourceIndexes.push_back(si);
   return i->second;
 }
 
@@ -979,70 +1171,151 @@ Json::ArrayIndex Target::AddSourceCompileGroup(cmSourceFile* sf,
     g.Entry = i;
     this->CompileGroups.push_back(std::move(g));
   }
-  this->CompileGroups[i->second].SourceIndexes.append(si);
+  this->CompileGroups[i->second].SourceIndexes.push_back(si);
   return i->second;
 }
 
-void Target::AddBacktrace(Json::Value& object, cmListFileBacktrace const& bt)
+void Target::DumpBacktrace(JBTIndex bt)
 {
-  if (JBTIndex backtrace = this->Backtraces.Add(bt)) {
-    object["backtrace"] = backtrace.Index;
+  if (bt) {
+    this->Writer.Key("backtrace");
+    this->Writer.Value(bt.Index);
   }
 }
 
-void Target::AddBacktrace(Json::Value& object, JBTIndex bt)
+std::vector<std::string> Target::GetArtifacts()
 {
-  if (bt) {
-    object["backtrace"] = bt.Index;
+  std::vector<std::string> artifacts;
+
+  // Object libraries have only object files as artifacts.
+  if (this->GT->GetType() == cmStateEnums::OBJECT_LIBRARY) {
+    if (!this->GT->GetGlobalGenerator()->HasKnownObjectFileLocation(nullptr)) {
+      return artifacts;
+    }
+    std::vector<cmSourceFile const*> objectSources;
+    this->GT->GetObjectSources(objectSources, this->Config);
+    std::string const obj_dir = this->GT->GetObjectDirectory(this->Config);
+    for (cmSourceFile const* sf : objectSources) {
+      const std::string& obj = this->GT->GetObjectName(sf);
+      artifacts.push_back(RelativeIfUnder(this->TopBuild, obj_dir + obj));
+    }
+    return artifacts;
   }
+
+  // Other target types always have a "main" artifact.
+  artifacts.push_back(
+    RelativeIfUnder(this->TopBuild,
+                    this->GT->GetFullPath(
+                      this->Config, cmStateEnums::RuntimeBinaryArtifact)));
+
+  // Add Windows-specific artifacts produced by the linker.
+  if (this->GT->HasImportLibrary(this->Config)) {
+    artifacts.push_back(
+      RelativeIfUnder(this->TopBuild,
+                      this->GT->GetFullPath(
+                        this->Config, cmStateEnums::ImportLibraryArtifact)));
+  }
+  if (this->GT->IsDLLPlatform() &&
+      this->GT->GetType() != cmStateEnums::STATIC_LIBRARY) {
+    cmGeneratorTarget::OutputInfo const* output =
+      this->GT->GetOutputInfo(this->Config);
+    if (output && !output->PdbDir.empty()) {
+      artifacts.push_back(RelativeIfUnder(
+        this->TopBuild,
+        output->PdbDir + '/' + this->GT->GetPDBName(this->Config)));
+    }
+  }
+  return artifacts;
 }
 
-Json::Value Target::DumpPaths()
+std::vector<Target::LinkCommandFragment> Target::GetLinkCommandFragments()
 {
-  Json::Value paths = Json::objectValue;
+  std::vector<LinkCommandFragment> linkFragments;
+
+  std::string linkLanguageFlags;
+  std::vector<BT<std::string>> linkFlags;
+  std::string frameworkPath;
+  std::vector<BT<std::string>> linkPath;
+  std::vector<BT<std::string>> linkLibs;
   cmLocalGenerator* lg = this->GT->GetLocalGenerator();
+  cmLinkLineComputer linkLineComputer(lg,
+                                      lg->GetStateSnapshot().GetDirectory());
+  lg->GetTargetFlags(&linkLineComputer, this->Config, linkLibs,
+                     linkLanguageFlags, linkFlags, frameworkPath, linkPath,
+                     this->GT);
+  linkLanguageFlags = cmTrimWhitespace(linkLanguageFlags);
+  frameworkPath = cmTrimWhitespace(frameworkPath);
 
-  std::string const& sourceDir = lg->GetCurrentSourceDirectory();
-  paths["source"] = RelativeIfUnder(this->TopSource, sourceDir);
+  if (!linkLanguageFlags.empty()) {
+    linkFragments.push_back({ std::move(linkLanguageFlags), "flags" });
+  }
+
+  for (BT<std::string> frag : linkFlags) {
+    frag.Value = cmTrimWhitespace(frag.Value);
+    linkFragments.push_back({ this->ToJBT(frag), "flags" });
+  }
+
+  if (!frameworkPath.empty()) {
+    linkFragments.push_back({ std::move(frameworkPath), "frameworkPath" });
+  }
+
+  for (BT<std::string> frag : linkPath) {
+    frag.Value = cmTrimWhitespace(frag.Value);
+    linkFragments.push_back({ this->ToJBT(frag), "libraryPath" });
+  }
+
+  for (BT<std::string> frag : linkLibs) {
+    frag.Value = cmTrimWhitespace(frag.Value);
+    linkFragments.push_back({ this->ToJBT(frag), "libraries" });
+  }
+
+  return linkFragments;
+}
+
+void Target::DumpPaths()
+{
+  this->Writer.BeginObject();
+  cmLocalGenerator* lg = this->GT->GetLocalGenerator();
 
   std::string const& buildDir = lg->GetCurrentBinaryDirectory();
-  paths["build"] = RelativeIfUnder(this->TopBuild, buildDir);
+  this->Writer.Key("build");
+  this->Writer.Value(RelativeIfUnder(this->TopBuild, buildDir));
+
+  std::string const& sourceDir = lg->GetCurrentSourceDirectory();
+  this->Writer.Key("source");
+  this->Writer.Value(RelativeIfUnder(this->TopSource, sourceDir));
 
-  return paths;
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpSources()
+void Target::ProcessSources()
 {
-  Json::Value sources = Json::arrayValue;
   cmGeneratorTarget::KindedSources const& kinded =
     this->GT->GetKindedSources(this->Config);
+  Json::ArrayIndex si = 0;
   for (cmGeneratorTarget::SourceAndKind const& sk : kinded.Sources) {
-    sources.append(this->DumpSource(sk, sources.size()));
+    this->ProcessSource(sk, si++);
   }
-  return sources;
 }
 
-Json::Value Target::DumpSource(cmGeneratorTarget::SourceAndKind const& sk,
-                               Json::ArrayIndex si)
+void Target::ProcessSource(cmGeneratorTarget::SourceAndKind const& sk,
+                           Json::ArrayIndex si)
 {
-  Json::Value source = Json::objectValue;
+  Source s;
 
   std::string const path = sk.Source.Value->ResolveFullPath();
-  source["path"] = RelativeIfUnder(this->TopSource, path);
-  if (sk.Source.Value->GetIsGenerated()) {
-    source["isGenerated"] = true;
-  }
-  this->AddBacktrace(source, sk.Source.Backtrace);
+  s.Path = RelativeIfUnder(this->TopSource, path);
+  s.IsGenerated = sk.Source.Value->GetIsGenerated();
+  s.Backtrace = this->Backtraces.Add(sk.Source.Backtrace);
 
   if (cmSourceGroup* sg =
         this->GT->Makefile->FindSourceGroup(path, this->SourceGroupsLocal)) {
-    source["sourceGroupIndex"] = this->AddSourceGroup(sg, si);
+    s.SourceGroupIndex = this->AddSourceGroup(sg, si);
   }
 
   switch (sk.Kind) {
     case cmGeneratorTarget::SourceKindObjectSource: {
-      source["compileGroupIndex"] =
-        this->AddSourceCompileGroup(sk.Source.Value, si);
+      s.CompileGroupIndex = this->AddSourceCompileGroup(sk.Source.Value, si);
     } break;
     case cmGeneratorTarget::SourceKindAppManifest:
     case cmGeneratorTarget::SourceKindCertificate:
@@ -1058,340 +1331,291 @@ Json::Value Target::DumpSource(cmGeneratorTarget::SourceAndKind const& sk,
       break;
   }
 
-  return source;
+  this->Sources.push_back(std::move(s));
 }
 
-Json::Value Target::DumpCompileData(CompileData const& cd)
+void Target::DumpSources()
 {
-  Json::Value result = Json::objectValue;
-
-  if (!cd.Language.empty()) {
-    result["language"] = cd.Language;
+  this->Writer.BeginArray();
+  for (Source const& s : this->Sources) {
+    this->DumpSource(s);
   }
-  if (!cd.Sysroot.empty()) {
-    result["sysroot"] = this->DumpSysroot(cd.Sysroot);
+  this->Writer.EndArray();
+}
+
+void Target::DumpSource(Source const& s)
+{
+  this->Writer.BeginObject();
+  this->DumpBacktrace(s.Backtrace);
+  if (s.CompileGroupIndex != Source::NoIndex) {
+    this->Writer.Key("compileGroupIndex");
+    this->Writer.Value(s.CompileGroupIndex);
   }
-  if (!cd.Flags.empty()) {
-    result["compileCommandFragments"] = this->DumpCommandFragments(cd.Flags);
+  if (s.IsGenerated) {
+    this->Writer.Key("isGenerated");
+    this->Writer.Value(true);
   }
-  if (!cd.Includes.empty()) {
-    Json::Value includes = Json::arrayValue;
-    for (auto const& i : cd.Includes) {
-      includes.append(this->DumpInclude(i));
-    }
-    result["includes"] = includes;
+  this->Writer.Key("path");
+  this->Writer.Value(s.Path);
+  if (s.SourceGroupIndex != Source::NoIndex) {
+    this->Writer.Key("sourceGroupIndex");
+    this->Writer.Value(s.SourceGroupIndex);
   }
-  if (!cd.Defines.empty()) {
-    Json::Value defines = Json::arrayValue;
-    for (JBT<std::string> const& d : cd.Defines) {
-      defines.append(this->DumpDefine(d));
-    }
-    result["defines"] = std::move(defines);
-  }
-
-  return result;
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpInclude(CompileData::IncludeEntry const& inc)
+void Target::DumpInclude(CompileData::IncludeEntry const& inc)
 {
-  Json::Value include = Json::objectValue;
-  include["path"] = inc.Path.Value;
+  this->Writer.BeginObject();
+  this->DumpBacktrace(inc.Path.Backtrace);
   if (inc.IsSystem) {
-    include["isSystem"] = true;
+    this->Writer.Key("isSystem");
+    this->Writer.Value(true);
   }
-  this->AddBacktrace(include, inc.Path.Backtrace);
-  return include;
+  this->Writer.Key("path");
+  this->Writer.Value(inc.Path.Value);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpDefine(JBT<std::string> const& def)
+void Target::DumpDefine(JBT<std::string> const& def)
 {
-  Json::Value define = Json::objectValue;
-  define["define"] = def.Value;
-  this->AddBacktrace(define, def.Backtrace);
-  return define;
+  this->Writer.BeginObject();
+  this->DumpBacktrace(def.Backtrace);
+  this->Writer.Key("define");
+  this->Writer.Value(def.Value);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpSourceGroups()
+void Target::DumpSourceGroups()
 {
-  Json::Value sourceGroups = Json::arrayValue;
+  this->Writer.BeginArray();
   for (auto& sg : this->SourceGroups) {
-    sourceGroups.append(this->DumpSourceGroup(sg));
+    this->DumpSourceGroup(sg);
   }
-  return sourceGroups;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpSourceGroup(SourceGroup& sg)
+void Target::DumpSourceGroup(SourceGroup& sg)
 {
-  Json::Value group = Json::objectValue;
-  group["name"] = sg.Name;
-  group["sourceIndexes"] = std::move(sg.SourceIndexes);
-  return group;
+  this->Writer.BeginObject();
+  this->Writer.Key("name");
+  this->Writer.Value(sg.Name);
+  this->Writer.Key("sourceIndexes");
+  DumpIndexes(this->Writer, sg.SourceIndexes);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpCompileGroups()
+void Target::DumpCompileGroups()
 {
-  Json::Value compileGroups = Json::arrayValue;
+  this->Writer.BeginArray();
   for (auto& cg : this->CompileGroups) {
-    compileGroups.append(this->DumpCompileGroup(cg));
+    this->DumpCompileGroup(cg);
   }
-  return compileGroups;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpCompileGroup(CompileGroup& cg)
+void Target::DumpCompileGroup(CompileGroup& cg)
 {
-  Json::Value group =
-    this->DumpCompileData(this->MergeCompileData(cg.Entry->first));
-  group["sourceIndexes"] = std::move(cg.SourceIndexes);
-  return group;
+  CompileData const cd = this->MergeCompileData(cg.Entry->first);
+
+  this->Writer.BeginObject();
+  if (!cd.Flags.empty()) {
+    this->Writer.Key("compileCommandFragments");
+    this->DumpCommandFragments(cd.Flags);
+  }
+  if (!cd.Defines.empty()) {
+    this->Writer.Key("defines");
+    this->Writer.BeginArray();
+    for (JBT<std::string> const& d : cd.Defines) {
+      this->DumpDefine(d);
+    }
+    this->Writer.EndArray();
+  }
+  if (!cd.Includes.empty()) {
+    this->Writer.Key("includes");
+    this->Writer.BeginArray();
+    for (auto const& i : cd.Includes) {
+      this->DumpInclude(i);
+    }
+    this->Writer.EndArray();
+  }
+  if (!cd.Language.empty()) {
+    this->Writer.Key("language");
+    this->Writer.Value(cd.Language);
+  }
+  this->Writer.Key("sourceIndexes");
+  DumpIndexes(this->Writer, cg.SourceIndexes);
+  if (!cd.Sysroot.empty()) {
+    this->Writer.Key("sysroot");
+    this->DumpSysroot(cd.Sysroot);
+  }
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpSysroot(std::string const& path)
+void Target::DumpSysroot(std::string const& path)
 {
-  Json::Value sysroot = Json::objectValue;
-  sysroot["path"] = path;
-  return sysroot;
+  this->Writer.BeginObject();
+  this->Writer.Key("path");
+  this->Writer.Value(path);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpInstall()
+void Target::DumpInstall()
 {
-  Json::Value install = Json::objectValue;
-  install["prefix"] = this->DumpInstallPrefix();
-  install["destinations"] = this->DumpInstallDestinations();
-  return install;
+  this->Writer.BeginObject();
+  this->Writer.Key("destinations");
+  this->DumpInstallDestinations();
+  this->Writer.Key("prefix");
+  this->DumpInstallPrefix();
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpInstallPrefix()
+void Target::DumpInstallPrefix()
 {
-  Json::Value prefix = Json::objectValue;
   std::string p =
     this->GT->Makefile->GetSafeDefinition("CMAKE_INSTALL_PREFIX");
   cmSystemTools::ConvertToUnixSlashes(p);
-  prefix["path"] = p;
-  return prefix;
+  this->Writer.BeginObject();
+  this->Writer.Key("path");
+  this->Writer.Value(p);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpInstallDestinations()
+void Target::DumpInstallDestinations()
 {
-  Json::Value destinations = Json::arrayValue;
-  auto installGens = this->GT->Target->GetInstallGenerators();
-  for (auto itGen : installGens) {
-    destinations.append(this->DumpInstallDestination(itGen));
+  this->Writer.BeginArray();
+  for (JBT<std::string> const& dest : this->InstallDestinations) {
+    this->DumpInstallDestination(dest);
   }
-  return destinations;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpInstallDestination(cmInstallTargetGenerator* itGen)
+void Target::DumpInstallDestination(JBT<std::string> const& dest)
 {
-  Json::Value destination = Json::objectValue;
-  destination["path"] = itGen->GetDestination(this->Config);
-  this->AddBacktrace(destination, itGen->GetBacktrace());
-  return destination;
+  this->Writer.BeginObject();
+  this->DumpBacktrace(dest.Backtrace);
+  this->Writer.Key("path");
+  this->Writer.Value(dest.Value);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpArtifacts()
+void Target::DumpArtifacts(std::vector<std::string> const& artifacts)
 {
-  Json::Value artifacts = Json::arrayValue;
-
-  // Object libraries have only object files as artifacts.
-  if (this->GT->GetType() == cmStateEnums::OBJECT_LIBRARY) {
-    if (!this->GT->GetGlobalGenerator()->HasKnownObjectFileLocation(nullptr)) {
-      return artifacts;
-    }
-    std::vector<cmSourceFile const*> objectSources;
-    this->GT->GetObjectSources(objectSources, this->Config);
-    std::string const obj_dir = this->GT->GetObjectDirectory(this->Config);
-    for (cmSourceFile const* sf : objectSources) {
-      const std::string& obj = this->GT->GetObjectName(sf);
-      Json::Value artifact = Json::objectValue;
-      artifact["path"] = RelativeIfUnder(this->TopBuild, obj_dir + obj);
-      artifacts.append(std::move(artifact)); // NOLINT(*)
-    }
-    return artifacts;
+  this->Writer.BeginArray();
+  for (std::string const& path : artifacts) {
+    this->Writer.BeginObject();
+    this->Writer.Key("path");
+    this->Writer.Value(path);
+    this->Writer.EndObject();
   }
-
-  // Other target types always have a "main" artifact.
-  {
-    Json::Value artifact = Json::objectValue;
-    artifact["path"] =
-      RelativeIfUnder(this->TopBuild,
-                      this->GT->GetFullPath(
-                        this->Config, cmStateEnums::RuntimeBinaryArtifact));
-    artifacts.append(std::move(artifact)); // NOLINT(*)
-  }
-
-  // Add Windows-specific artifacts produced by the linker.
-  if (this->GT->HasImportLibrary(this->Config)) {
-    Json::Value artifact = Json::objectValue;
-    artifact["path"] =
-      RelativeIfUnder(this->TopBuild,
-                      this->GT->GetFullPath(
-                        this->Config, cmStateEnums::ImportLibraryArtifact));
-    artifacts.append(std::move(artifact)); // NOLINT(*)
-  }
-  if (this->GT->IsDLLPlatform() &&
-      this->GT->GetType() != cmStateEnums::STATIC_LIBRARY) {
-    cmGeneratorTarget::OutputInfo const* output =
-      this->GT->GetOutputInfo(this->Config);
-    if (output && !output->PdbDir.empty()) {
-      Json::Value artifact = Json::objectValue;
-      artifact["path"] = RelativeIfUnder(this->TopBuild,
-                                         output->PdbDir + '/' +
-                                           this->GT->GetPDBName(this->Config));
-      artifacts.append(std::move(artifact)); // NOLINT(*)
-    }
-  }
-  return artifacts;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpLink()
+void Target::DumpLink()
 {
-  Json::Value link = Json::objectValue;
+  this->Writer.BeginObject();
+  if (!this->LinkCommandFragments.empty()) {
+    this->Writer.Key("commandFragments");
+    this->DumpLinkCommandFragments();
+  }
   std::string lang = this->GT->GetLinkerLanguage(this->Config);
-  link["language"] = lang;
-  {
-    Json::Value commandFragments = this->DumpLinkCommandFragments();
-    if (!commandFragments.empty()) {
-      link["commandFragments"] = std::move(commandFragments);
-    }
+  this->Writer.Key("language");
+  this->Writer.Value(lang);
+  if (this->GT->IsIPOEnabled(lang, this->Config)) {
+    this->Writer.Key("lto");
+    this->Writer.Value(true);
   }
   if (const char* sysrootLink =
         this->GT->Makefile->GetDefinition("CMAKE_SYSROOT_LINK")) {
-    link["sysroot"] = this->DumpSysroot(sysrootLink);
+    this->Writer.Key("sysroot");
+    this->DumpSysroot(sysrootLink);
   } else if (const char* sysroot =
                this->GT->Makefile->GetDefinition("CMAKE_SYSROOT")) {
-    link["sysroot"] = this->DumpSysroot(sysroot);
-  }
-  if (this->GT->IsIPOEnabled(lang, this->Config)) {
-    link["lto"] = true;
+    this->Writer.Key("sysroot");
+    this->DumpSysroot(sysroot);
   }
-  return link;
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpArchive()
+void Target::DumpArchive()
 {
-  Json::Value archive = Json::objectValue;
-  {
-    // The "link" fragments not relevant to static libraries are empty.
-    Json::Value commandFragments = this->DumpLinkCommandFragments();
-    if (!commandFragments.empty()) {
-      archive["commandFragments"] = std::move(commandFragments);
-    }
+  this->Writer.BeginObject();
+  // The "link" fragments not relevant to static libraries are empty.
+  if (!this->LinkCommandFragments.empty()) {
+    this->Writer.Key("commandFragments");
+    this->DumpLinkCommandFragments();
   }
   std::string lang = this->GT->GetLinkerLanguage(this->Config);
   if (this->GT->IsIPOEnabled(lang, this->Config)) {
-    archive["lto"] = true;
+    this->Writer.Key("lto");
+    this->Writer.Value(true);
   }
-  return archive;
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpLinkCommandFragments()
+void Target::DumpLinkCommandFragments()
 {
-  Json::Value linkFragments = Json::arrayValue;
-
-  std::string linkLanguageFlags;
-  std::vector<BT<std::string>> linkFlags;
-  std::string frameworkPath;
-  std::vector<BT<std::string>> linkPath;
-  std::vector<BT<std::string>> linkLibs;
-  cmLocalGenerator* lg = this->GT->GetLocalGenerator();
-  cmLinkLineComputer linkLineComputer(lg,
-                                      lg->GetStateSnapshot().GetDirectory());
-  lg->GetTargetFlags(&linkLineComputer, this->Config, linkLibs,
-                     linkLanguageFlags, linkFlags, frameworkPath, linkPath,
-                     this->GT);
-  linkLanguageFlags = cmTrimWhitespace(linkLanguageFlags);
-  frameworkPath = cmTrimWhitespace(frameworkPath);
-
-  if (!linkLanguageFlags.empty()) {
-    linkFragments.append(
-      this->DumpCommandFragment(std::move(linkLanguageFlags), "flags"));
-  }
-
-  if (!linkFlags.empty()) {
-    for (BT<std::string> frag : linkFlags) {
-      frag.Value = cmTrimWhitespace(frag.Value);
-      linkFragments.append(
-        this->DumpCommandFragment(this->ToJBT(frag), "flags"));
-    }
-  }
-
-  if (!frameworkPath.empty()) {
-    linkFragments.append(
-      this->DumpCommandFragment(std::move(frameworkPath), "frameworkPath"));
-  }
-
-  if (!linkPath.empty()) {
-    for (BT<std::string> frag : linkPath) {
-      frag.Value = cmTrimWhitespace(frag.Value);
-      linkFragments.append(
-        this->DumpCommandFragment(this->ToJBT(frag), "libraryPath"));
-    }
-  }
-
-  if (!linkLibs.empty()) {
-    for (BT<std::string> frag : linkLibs) {
-      frag.Value = cmTrimWhitespace(frag.Value);
-      linkFragments.append(
-        this->DumpCommandFragment(this->ToJBT(frag), "libraries"));
-    }
+  this->Writer.BeginArray();
+  for (LinkCommandFragment const& f : this->LinkCommandFragments) {
+    this->DumpCommandFragment(f.Fragment, f.Role);
   }
-
-  return linkFragments;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpCommandFragments(
-  std::vector<JBT<std::string>> const& frags)
+void Target::DumpCommandFragments(std::vector<JBT<std::string>> const& frags)
 {
-  Json::Value commandFragments = Json::arrayValue;
+  this->Writer.BeginArray();
   for (JBT<std::string> const& f : frags) {
-    commandFragments.append(this->DumpCommandFragment(f));
+    this->DumpCommandFragment(f);
   }
-  return commandFragments;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpCommandFragment(JBT<std::string> const& frag,
-                                        std::string const& role)
+void Target::DumpCommandFragment(JBT<std::string> const& frag,
+                                 const char* role)
 {
-  Json::Value fragment = Json::objectValue;
-  fragment["fragment"] = frag.Value;
-  if (!role.empty()) {
-    fragment["role"] = role;
+  this->Writer.BeginObject();
+  this->DumpBacktrace(frag.Backtrace);
+  this->Writer.Key("fragment");
+  this->Writer.Value(frag.Value);
+  if (role) {
+    this->Writer.Key("role");
+    this->Writer.Value(role);
   }
-  this->AddBacktrace(fragment, frag.Backtrace);
-  return fragment;
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpDependencies()
+void Target::DumpDependencies()
 {
-  Json::Value dependencies = Json::arrayValue;
-  cmGlobalGenerator* gg = this->GT->GetGlobalGenerator();
-  for (cmTargetDepend const& td : gg->GetTargetDirectDepends(this->GT)) {
-    dependencies.append(this->DumpDependency(td));
+  this->Writer.BeginArray();
+  for (JBT<std::string> const& dep : this->Dependencies) {
+    this->DumpDependency(dep);
   }
-  return dependencies;
+  this->Writer.EndArray();
 }
 
-Json::Value Target::DumpDependency(cmTargetDepend const& td)
+void Target::DumpDependency(JBT<std::string> const& dep)
 {
-  Json::Value dependency = Json::objectValue;
-  dependency["id"] = TargetId(td, this->TopBuild);
-  this->AddBacktrace(dependency, td.GetBacktrace());
-  return dependency;
+  this->Writer.BeginObject();
+  this->DumpBacktrace(dep.Backtrace);
+  this->Writer.Key("id");
+  this->Writer.Value(dep.Value);
+  this->Writer.EndObject();
 }
 
-Json::Value Target::DumpFolder()
+void Target::DumpFolder(const char* folder)
 {
-  Json::Value folder;
-  if (const char* f = this->GT->GetProperty("FOLDER")) {
-    folder = Json::objectValue;
-    folder["name"] = f;
-  }
-  return folder;
+  this->Writer.BeginObject();
+  this->Writer.Key("name");
+  this->Writer.Value(folder);
+  this->Writer.EndObject();
 }
 }
 
-Json::Value cmFileAPICodemodelDump(cmFileAPI& fileAPI, unsigned long version)
+void cmFileAPICodemodelDump(cmFileAPI& fileAPI, unsigned long version,
+                            Json::Value const& object,
+                            cmJsonStreamWriter& writer)
 {
-  Codemodel codemodel(fileAPI, version);
-  return codemodel.Dump();
+  Codemodel codemodel(fileAPI, version, writer);
+  codemodel.Dump(object);
 }
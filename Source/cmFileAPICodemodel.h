@@ -8,8 +8,12 @@
 #include "cm_jsoncpp_value.h"
 
 class cmFileAPI;
+class cmJsonStreamWriter;
 
-extern Json::Value cmFileAPICodemodelDump(cmFileAPI& fileAPI,
-                                          unsigned long version);
+/** Write the codemodel object to the writer.  The given object holds its
+    "kind" and "version" members.  */
+extern void cmFileAPICodemodelDump(cmFileAPI& fileAPI, unsigned long version,
+                                   Json::Value const& object,
+                                   cmJsonStreamWriter& writer);
 
 #endif
@@ -15,6 +15,7 @@
 #include "cmFunctionBlocker.h"
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
+#include "cmMemoryReport.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
 #include "cmState.h"
@@ -142,7 +143,13 @@ bool cmFunctionFunctionBlocker::Replay(
   f.Functions = std::move(functions);
   f.FilePath = this->GetStartingContext().FilePath;
   mf.RecordPolicies(f.Policies);
-  mf.GetState()->AddScriptedCommand(this->Args[0], std::move(f));
+  cmState* state = mf.GetState();
+  if (state->GetMeasureCommandBodies()) {
+    cmMemoryFootprint const body = cmMemoryReport::Measure(f.Functions);
+    state->AddScriptedCommand(this->Args[0], std::move(f), &body);
+  } else {
+    state->AddScriptedCommand(this->Args[0], std::move(f));
+  }
   return true;
 }
 
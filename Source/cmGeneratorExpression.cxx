@@ -3,19 +3,117 @@
 #include "cmGeneratorExpression.h"
 
 #include "cmsys/RegularExpression.hxx"
+#include <cm/memory>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 
-#include "cmAlgorithms.h"
+#include "cmArena.h"
 #include "cmGeneratorExpressionContext.h"
 #include "cmGeneratorExpressionDAGChecker.h"
 #include "cmGeneratorExpressionEvaluator.h"
 #include "cmGeneratorExpressionLexer.h"
 #include "cmGeneratorExpressionParser.h"
+#include "cmMemoryReport.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include <cassert>
 
+/** The evaluators parsed from a generator expression string.  They are
+    not modified by evaluation so the same tree is shared by every
+    compiled expression parsed from an identical string.  The evaluators
+    refer to the text of the input so the tree keeps its own copy.  They
+    are allocated together in an arena sized for the number of tokens,
+    which usually takes a single heap allocation.  */
+class cmCompiledGeneratorExpressionTree
+{
+public:
+  cmCompiledGeneratorExpressionTree(std::string input)
+    : Input(std::move(input))
+  {
+    cmGeneratorExpressionLexer l;
+    std::vector<cmGeneratorExpressionToken> tokens = l.Tokenize(this->Input);
+    this->NeedsEvaluation = l.GetSawGeneratorExpression();
+
+    if (this->NeedsEvaluation) {
+      // Each token creates at most one evaluator.
+      this->Arena = cm::make_unique<cmArena>(
+        tokens.size() * (sizeof(GeneratorExpressionContent) + 32));
+      cmGeneratorExpressionParser p(std::move(tokens), *this->Arena);
+      p.Parse(this->Evaluators);
+    }
+  }
+
+  cmCompiledGeneratorExpressionTree(cmCompiledGeneratorExpressionTree const&) =
+    delete;
+  cmCompiledGeneratorExpressionTree& operator=(
+    cmCompiledGeneratorExpressionTree const&) = delete;
+
+  std::string const Input;
+  std::unique_ptr<cmArena> Arena;
+  std::vector<cmGeneratorExpressionEvaluator*> Evaluators;
+  bool NeedsEvaluation;
+};
+
+namespace {
+// Identical expressions are common in the usage requirements of widely
+// used targets, which are parsed again for every consumer.  Look up the
+// parse tree of an input seen before instead.  Like the rest of the
+// generate step this is only used from the main thread.
+using ParseTreeCache =
+  std::unordered_map<std::string,
+                     std::shared_ptr<cmCompiledGeneratorExpressionTree const>>;
+
+ParseTreeCache& GetParseTreeCache()
+{
+  static ParseTreeCache cache;
+  return cache;
+}
+
+std::shared_ptr<cmCompiledGeneratorExpressionTree const> GetParseTree(
+  std::string const& input)
+{
+  // Strings without a generator expression are common and have an
+  // empty tree.  Do not keep a copy of each of them in the cache.
+  if (cmGeneratorExpression::Find(input) == std::string::npos) {
+    static auto const emptyTree =
+      std::make_shared<cmCompiledGeneratorExpressionTree const>(
+        std::string());
+    return emptyTree;
+  }
+  std::shared_ptr<cmCompiledGeneratorExpressionTree const>& tree =
+    GetParseTreeCache()[input];
+  if (!tree) {
+    tree = std::make_shared<cmCompiledGeneratorExpressionTree const>(input);
+  }
+  return tree;
+}
+}
+
+void cmGeneratorExpression::ClearParseTreeCache()
+{
+  GetParseTreeCache().clear();
+}
+
+void cmGeneratorExpression::ReportMemory(cmMemoryReport& report)
+{
+  ParseTreeCache const& cache = GetParseTreeCache();
+  cmMemoryFootprint trees;
+  trees.Count = cache.size();
+  trees.Bytes = cmMemoryReport::Bytes(cache);
+  for (auto const& i : cache) {
+    cmCompiledGeneratorExpressionTree const& tree = *i.second;
+    trees.Bytes += cmMemoryReport::Bytes(i.first) +
+      sizeof(cmCompiledGeneratorExpressionTree) +
+      cmMemoryReport::Bytes(tree.Input) +
+      cmMemoryReport::Bytes(tree.Evaluators);
+    if (tree.Arena) {
+      trees.Bytes += tree.Arena->GetBytesReserved();
+    }
+  }
+  report.Add("generator-expressions", "parse-trees", trees);
+}
+
 cmGeneratorExpression::cmGeneratorExpression(cmListFileBacktrace backtrace)
   : Backtrace(std::move(backtrace))
 {
@@ -79,13 +177,13 @@ const std::string& cmCompiledGeneratorExpression::EvaluateWithContext(
   cmGeneratorExpressionContext& context,
   cmGeneratorExpressionDAGChecker* dagChecker) const
 {
-  if (!this->NeedsEvaluation) {
+  if (!this->Tree->NeedsEvaluation) {
     return this->Input;
   }
 
   this->Output.clear();
 
-  for (const cmGeneratorExpressionEvaluator* it : this->Evaluators) {
+  for (const cmGeneratorExpressionEvaluator* it : this->Tree->Evaluators) {
     this->Output += it->Evaluate(&context, dagChecker);
 
     this->SeenTargetProperties.insert(context.SeenTargetProperties.cbegin(),
@@ -118,20 +216,10 @@ cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
   , HadContextSensitiveCondition(false)
   , HadHeadSensitiveCondition(false)
 {
-  cmGeneratorExpressionLexer l;
-  std::vector<cmGeneratorExpressionToken> tokens = l.Tokenize(this->Input);
-  this->NeedsEvaluation = l.GetSawGeneratorExpression();
-
-  if (this->NeedsEvaluation) {
-    cmGeneratorExpressionParser p(tokens);
-    p.Parse(this->Evaluators);
-  }
+  this->Tree = GetParseTree(this->Input);
 }
 
-cmCompiledGeneratorExpression::~cmCompiledGeneratorExpression()
-{
-  cmDeleteAll(this->Evaluators);
-}
+cmCompiledGeneratorExpression::~cmCompiledGeneratorExpression() = default;
 
 std::string cmGeneratorExpression::StripEmptyListElements(
   const std::string& input)
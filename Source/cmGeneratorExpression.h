@@ -15,8 +15,10 @@
 #include <vector>
 
 class cmCompiledGeneratorExpression;
+class cmCompiledGeneratorExpressionTree;
 class cmGeneratorTarget;
 class cmLocalGenerator;
+class cmMemoryReport;
 struct cmGeneratorExpressionContext;
 struct cmGeneratorExpressionDAGChecker;
 struct cmGeneratorExpressionEvaluator;
@@ -78,6 +80,13 @@ public:
 
   static std::string StripEmptyListElements(const std::string& input);
 
+  /** Release the parse trees shared by identical expressions.  Trees
+      still referenced by compiled expressions stay alive.  */
+  static void ClearParseTreeCache();
+
+  /** Add the cached parse trees to a memory report.  */
+  static void ReportMemory(cmMemoryReport& report);
+
   static inline bool StartsWithGeneratorExpression(const std::string& input)
   {
     return input.length() >= 2 && input[0] == '$' && input[1] == '<';
@@ -160,9 +169,10 @@ private:
   friend class cmGeneratorExpression;
 
   cmListFileBacktrace Backtrace;
-  std::vector<cmGeneratorExpressionEvaluator*> Evaluators;
+  // The parse tree is immutable and shared by all compiled expressions
+  // with the same input.  The members below hold the evaluation state.
+  std::shared_ptr<cmCompiledGeneratorExpressionTree const> Tree;
   const std::string Input;
-  bool NeedsEvaluation;
   bool EvaluateForBuildsystem;
   bool Quiet;
 
@@ -89,8 +89,6 @@ struct GeneratorExpressionContent : public cmGeneratorExpressionEvaluator
 
   std::string GetOriginalExpression() const;
 
-  ~GeneratorExpressionContent() override;
-
 private:
   std::string EvaluateParameters(const cmGeneratorExpressionNode* node,
                                  const std::string& identifier,
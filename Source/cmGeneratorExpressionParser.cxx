@@ -3,6 +3,7 @@
 #include "cmGeneratorExpressionParser.h"
 
 #include "cmAlgorithms.h"
+#include "cmArena.h"
 #include "cmGeneratorExpressionEvaluator.h"
 
 #include <cassert>
@@ -10,8 +11,9 @@
 #include <utility>
 
 cmGeneratorExpressionParser::cmGeneratorExpressionParser(
-  std::vector<cmGeneratorExpressionToken> tokens)
+  std::vector<cmGeneratorExpressionToken> tokens, cmArena& arena)
   : Tokens(std::move(tokens))
+  , Arena(arena)
   , NestingLevel(0)
 {
 }
@@ -27,7 +29,7 @@ void cmGeneratorExpressionParser::Parse(
 }
 
 static void extendText(
-  std::vector<cmGeneratorExpressionEvaluator*>& result,
+  cmArena& arena, std::vector<cmGeneratorExpressionEvaluator*>& result,
   std::vector<cmGeneratorExpressionToken>::const_iterator it)
 {
   if (!result.empty() &&
@@ -36,7 +38,8 @@ static void extendText(
     TextContent* textContent = static_cast<TextContent*>(*(result.end() - 1));
     textContent->Extend(it->Length);
   } else {
-    TextContent* textContent = new TextContent(it->Content, it->Length);
+    TextContent* textContent =
+      arena.New<TextContent>(it->Content, it->Length);
     result.push_back(textContent);
   }
 }
@@ -52,7 +55,6 @@ static void extendResult(
     TextContent* textContent = static_cast<TextContent*>(*(result.end() - 1));
     textContent->Extend(
       static_cast<TextContent*>(contents.front())->GetLength());
-    delete contents.front();
     cmAppend(result, contents.begin() + 1, contents.end());
   } else {
     cmAppend(result, contents);
@@ -72,7 +74,7 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
   while (this->it->TokenType != cmGeneratorExpressionToken::EndExpression &&
          this->it->TokenType != cmGeneratorExpressionToken::ColonSeparator) {
     if (this->it->TokenType == cmGeneratorExpressionToken::CommaSeparator) {
-      extendText(identifier, this->it);
+      extendText(this->Arena, identifier, this->it);
       ++this->it;
     } else {
       this->ParseContent(identifier);
@@ -87,9 +89,10 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
 
   if (this->it != this->Tokens.end() &&
       this->it->TokenType == cmGeneratorExpressionToken::EndExpression) {
-    GeneratorExpressionContent* content = new GeneratorExpressionContent(
-      startToken->Content,
-      this->it->Content - startToken->Content + this->it->Length);
+    GeneratorExpressionContent* content =
+      this->Arena.New<GeneratorExpressionContent>(
+        startToken->Content,
+        this->it->Content - startToken->Content + this->it->Length);
     assert(this->it != this->Tokens.end());
     ++this->it;
     --this->NestingLevel;
@@ -127,7 +130,7 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
     }
     while (this->it != this->Tokens.end() &&
            this->it->TokenType == cmGeneratorExpressionToken::ColonSeparator) {
-      extendText(*(parameters.end() - 1), this->it);
+      extendText(this->Arena, *(parameters.end() - 1), this->it);
       assert(this->it != this->Tokens.end());
       ++this->it;
     }
@@ -151,7 +154,7 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
       while (this->it != this->Tokens.end() &&
              this->it->TokenType ==
                cmGeneratorExpressionToken::ColonSeparator) {
-        extendText(*(parameters.end() - 1), this->it);
+        extendText(this->Arena, *(parameters.end() - 1), this->it);
         assert(this->it != this->Tokens.end());
         ++this->it;
       }
@@ -168,10 +171,10 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
     // There was a '$<' in the text, but no corresponding '>'. Rebuild to
     // treat the '$<' as having been plain text, along with the
     // corresponding : and , tokens that might have been found.
-    extendText(result, startToken);
+    extendText(this->Arena, result, startToken);
     extendResult(result, identifier);
     if (!parameters.empty()) {
-      extendText(result, colonToken);
+      extendText(this->Arena, result, colonToken);
 
       auto pit = parameters.begin();
       const auto pend = parameters.end();
@@ -182,7 +185,7 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
           extendResult(result, *pit);
         }
         if (commaIt != commaTokens.end()) {
-          extendText(result, *commaIt);
+          extendText(this->Arena, result, *commaIt);
         } else {
           break;
         }
@@ -194,7 +197,8 @@ void cmGeneratorExpressionParser::ParseGeneratorExpression(
   size_t contentLength =
     ((this->it - 1)->Content - startToken->Content) + (this->it - 1)->Length;
   GeneratorExpressionContent* content =
-    new GeneratorExpressionContent(startToken->Content, contentLength);
+    this->Arena.New<GeneratorExpressionContent>(startToken->Content,
+                                                contentLength);
   content->SetIdentifier(std::move(identifier));
   content->SetParameters(std::move(parameters));
   result.push_back(content);
@@ -222,7 +226,7 @@ void cmGeneratorExpressionParser::ParseContent(
         }
       }
       cmGeneratorExpressionEvaluator* n =
-        new TextContent(this->it->Content, this->it->Length);
+        this->Arena.New<TextContent>(this->it->Content, this->it->Length);
       result.push_back(n);
       assert(this->it != this->Tokens.end());
       ++this->it;
@@ -237,7 +241,7 @@ void cmGeneratorExpressionParser::ParseContent(
     case cmGeneratorExpressionToken::ColonSeparator:
     case cmGeneratorExpressionToken::CommaSeparator:
       if (this->NestingLevel == 0) {
-        extendText(result, this->it);
+        extendText(this->Arena, result, this->it);
       } else {
         assert(false && "Got unexpected syntax token.");
       }
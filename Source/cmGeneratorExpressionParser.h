@@ -9,11 +9,15 @@
 
 #include "cmGeneratorExpressionLexer.h"
 
+class cmArena;
 struct cmGeneratorExpressionEvaluator;
 
 struct cmGeneratorExpressionParser
 {
-  cmGeneratorExpressionParser(std::vector<cmGeneratorExpressionToken> tokens);
+  /** Parse the given tokens.  The evaluators are created in the arena,
+      which owns them.  */
+  cmGeneratorExpressionParser(std::vector<cmGeneratorExpressionToken> tokens,
+                              cmArena& arena);
 
   void Parse(std::vector<cmGeneratorExpressionEvaluator*>& result);
 
@@ -24,6 +28,7 @@ private:
 private:
   std::vector<cmGeneratorExpressionToken>::const_iterator it;
   const std::vector<cmGeneratorExpressionToken> Tokens;
+  cmArena& Arena;
   unsigned int NestingLevel;
 };
 
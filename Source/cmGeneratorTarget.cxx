@@ -32,6 +32,7 @@
 #include "cmGlobalGenerator.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
+#include "cmMemoryReport.h"
 #include "cmMessageType.h"
 #include "cmPropertyMap.h"
 #include "cmRange.h"
@@ -655,6 +656,199 @@ void cmGeneratorTarget::ClearSourcesCache()
   this->Objects.clear();
 }
 
+namespace {
+template <typename Items>
+std::size_t LinkItemBytes(Items const& items)
+{
+  std::size_t bytes = cmMemoryReport::Bytes(items);
+  for (cmLinkItem const& item : items) {
+    bytes += cmMemoryReport::Bytes(item.AsStr());
+  }
+  return bytes;
+}
+
+std::size_t LinkInterfaceBytes(cmLinkInterface const& iface)
+{
+  return LinkItemBytes(iface.Libraries) +
+    cmMemoryReport::Bytes(iface.Languages) + LinkItemBytes(iface.SharedDeps) +
+    LinkItemBytes(iface.WrongConfigLibraries);
+}
+
+std::size_t LinkImplementationBytes(cmLinkImplementation const& impl)
+{
+  return LinkItemBytes(impl.Libraries) +
+    LinkItemBytes(impl.WrongConfigLibraries) +
+    cmMemoryReport::Bytes(impl.Languages);
+}
+
+std::size_t KeyBytes(std::string const& key)
+{
+  return cmMemoryReport::Bytes(key);
+}
+
+template <typename T>
+std::size_t KeyBytes(std::pair<T, std::string> const& key)
+{
+  return cmMemoryReport::Bytes(key.second);
+}
+
+template <typename T>
+std::size_t KeyBytes(std::pair<std::string, T> const& key)
+{
+  return cmMemoryReport::Bytes(key.first);
+}
+
+struct NoBytes
+{
+  template <typename T>
+  std::size_t operator()(T const& /*unused*/) const
+  {
+    return 0;
+  }
+};
+
+// Add the nodes of a per-configuration cache whose values hold
+// heap memory measured by the given function.
+template <typename Map, typename F>
+void AddCache(cmMemoryFootprint& f, Map const& m, F valueBytes)
+{
+  f.Count += m.size();
+  f.Bytes += cmMemoryReport::Bytes(m);
+  for (auto const& i : m) {
+    f.Bytes += KeyBytes(i.first) + valueBytes(i.second);
+  }
+}
+}
+
+void cmGeneratorTarget::ReportMemory(cmMemoryReport& report) const
+{
+  static std::string const targets = "generator-targets";
+
+  report.Add(targets, "generator-targets", 1, sizeof(cmGeneratorTarget));
+
+  // The entries own the compiled generator expressions reported by
+  // the generator expression subsystem.
+  cmMemoryFootprint entries;
+  for (auto const* e :
+       { &this->IncludeDirectoriesEntries, &this->CompileOptionsEntries,
+         &this->CompileFeaturesEntries, &this->CompileDefinitionsEntries,
+         &this->LinkOptionsEntries, &this->LinkDirectoriesEntries,
+         &this->PrecompileHeadersEntries, &this->SourceEntries }) {
+    entries.Count += e->size();
+    entries.Bytes +=
+      cmMemoryReport::Bytes(*e) + e->size() * sizeof(TargetPropertyEntry);
+  }
+  report.Add(targets, "property-entries", entries);
+
+  NoBytes const none;
+
+  cmMemoryFootprint link;
+  auto headToInterface = [](cmHeadToLinkInterfaceMap const& hm) {
+    std::size_t bytes = cmMemoryReport::Bytes(hm);
+    for (auto const& h : hm) {
+      bytes += LinkInterfaceBytes(h.second);
+    }
+    return bytes;
+  };
+  AddCache(link, this->LinkInterfaceMap, headToInterface);
+  AddCache(link, this->LinkInterfaceUsageRequirementsOnlyMap, headToInterface);
+  AddCache(link, this->LinkImplMap,
+           [](HeadToLinkImplementationMap const& hm) {
+             std::size_t bytes = cmMemoryReport::Bytes(hm);
+             for (auto const& h : hm) {
+               bytes += LinkImplementationBytes(h.second);
+             }
+             return bytes;
+           });
+  AddCache(link, this->LinkImplClosureMap,
+           [](LinkImplClosure const& c) { return cmMemoryReport::Bytes(c); });
+  AddCache(link, this->LinkClosureMap, [](LinkClosure const& c) {
+    return cmMemoryReport::Bytes(c.LinkerLanguage) +
+      cmMemoryReport::Bytes(c.Languages);
+  });
+  AddCache(link, this->LinkInformation, none);
+  report.Add(targets, "link-caches", link);
+
+  cmMemoryFootprint sources;
+  AddCache(sources, this->KindedSourcesMap, [](KindedSources const& ks) {
+    return cmMemoryReport::Bytes(ks.Sources) +
+      cmMemoryReport::Bytes(ks.ExpectedResxHeaders) +
+      cmMemoryReport::Bytes(ks.ExpectedXamlHeaders) +
+      cmMemoryReport::Bytes(ks.ExpectedXamlSources);
+  });
+  sources.Count += this->AllConfigSources.size();
+  sources.Bytes += cmMemoryReport::Bytes(this->AllConfigSources);
+  for (AllConfigSource const& acs : this->AllConfigSources) {
+    sources.Bytes += cmMemoryReport::Bytes(acs.Configs);
+  }
+  sources.Count += this->SourceDepends.size() + this->Objects.size() +
+    this->SourceFlagsMap.size();
+  sources.Bytes += cmMemoryReport::Bytes(this->SourceDepends) +
+    cmMemoryReport::Bytes(this->Objects) +
+    cmMemoryReport::Bytes(this->SourceFlagsMap);
+  for (auto const& sd : this->SourceDepends) {
+    sources.Bytes += cmMemoryReport::Bytes(sd.second.Depends);
+  }
+  for (auto const& o : this->Objects) {
+    sources.Bytes += cmMemoryReport::Bytes(o.second);
+  }
+  report.Add(targets, "source-caches", sources);
+
+  cmMemoryFootprint outputs;
+  AddCache(outputs, this->OutputInfoMap, [](OutputInfo const& oi) {
+    return cmMemoryReport::Bytes(oi.OutDir) +
+      cmMemoryReport::Bytes(oi.ImpDir) + cmMemoryReport::Bytes(oi.PdbDir);
+  });
+  AddCache(outputs, this->OutputNameMap,
+           [](std::string const& n) { return cmMemoryReport::Bytes(n); });
+  AddCache(outputs, this->CompileInfoMap, [](CompileInfo const& ci) {
+    return cmMemoryReport::Bytes(ci.CompilePdbDir);
+  });
+  AddCache(outputs, this->ImportInfoMap, [](ImportInfo const& ii) {
+    return cmMemoryReport::Bytes(ii.Location) +
+      cmMemoryReport::Bytes(ii.SOName) +
+      cmMemoryReport::Bytes(ii.ImportLibrary) +
+      cmMemoryReport::Bytes(ii.LibName) + cmMemoryReport::Bytes(ii.Languages) +
+      cmMemoryReport::Bytes(ii.Libraries) +
+      cmMemoryReport::Bytes(ii.LibrariesProp) +
+      cmMemoryReport::Bytes(ii.SharedDeps);
+  });
+  AddCache(outputs, this->ModuleDefinitionInfoMap,
+           [](ModuleDefinitionInfo const& mdi) {
+             return cmMemoryReport::Bytes(mdi.DefFile) +
+               cmMemoryReport::Bytes(mdi.Sources);
+           });
+  report.Add(targets, "output-caches", outputs);
+
+  cmMemoryFootprint other;
+  AddCache(other, this->SystemIncludesCache,
+           [](std::vector<std::string> const& v) {
+             return cmMemoryReport::Bytes(v);
+           });
+  AddCache(other, this->CompatibleInterfacesMap,
+           [](CompatibleInterfaces const& ci) {
+             return cmMemoryReport::Bytes(ci.PropsBool) +
+               cmMemoryReport::Bytes(ci.PropsString) +
+               cmMemoryReport::Bytes(ci.PropsNumberMax) +
+               cmMemoryReport::Bytes(ci.PropsNumberMin);
+           });
+  AddCache(other, this->MaybeInterfacePropertyExists, none);
+  AddCache(other, this->DebugCompatiblePropertiesDone, none);
+  auto stringBytes = [](std::string const& v) {
+    return cmMemoryReport::Bytes(v);
+  };
+  AddCache(other, this->PchHeaders, stringBytes);
+  AddCache(other, this->PchSources, stringBytes);
+  AddCache(other, this->PchObjectFiles, stringBytes);
+  AddCache(other, this->MaxLanguageStandards, stringBytes);
+  other.Count += this->LinkImplicitNullProperties.size() +
+    this->UtilityItems.size();
+  other.Bytes +=
+    cmMemoryReport::Bytes(this->LinkImplicitNullProperties) +
+    cmMemoryReport::Bytes(this->UtilityItems);
+  report.Add(targets, "other-caches", other);
+}
+
 void cmGeneratorTarget::AddSourceCommon(const std::string& src, bool before)
 {
   this->SourceEntries.insert(
@@ -6338,6 +6532,57 @@ void cmGeneratorTarget::ComputeLinkImplementationLibraries(
   const std::string& config, cmOptionalLinkImplementation& impl,
   cmGeneratorTarget const* head) const
 {
+  // Multi-configuration generators ask for every configuration.  If the
+  // libraries did not depend on the configuration for another one then
+  // reuse them.  Only the libraries of other configurations (for the
+  // OLD behavior of CMP0003) have to be computed.
+  cmOptionalLinkImplementation const* shared = nullptr;
+  for (auto const& hm : this->LinkImplMap) {
+    auto const hi = hm.second.find(head);
+    if (hi != hm.second.end() && hi->second.LibrariesConfigIndependent) {
+      shared = &hi->second;
+      break;
+    }
+  }
+  if (shared) {
+    impl.Libraries = shared->Libraries;
+    impl.HadHeadSensitiveCondition = shared->HadHeadSensitiveCondition;
+    impl.LibrariesConfigIndependent = true;
+  } else {
+    this->ComputeLinkImplementationEntries(config, impl, head);
+  }
+
+  // Get the list of configurations considered to be DEBUG.
+  std::vector<std::string> debugConfigs =
+    this->Makefile->GetCMakeInstance()->GetDebugConfigs();
+
+  cmTargetLinkLibraryType linkType =
+    CMP0003_ComputeLinkType(config, debugConfigs);
+  cmTarget::LinkLibraryVectorType const& oldllibs =
+    this->Target->GetOriginalLinkLibraries();
+  for (cmTarget::LibraryID const& oldllib : oldllibs) {
+    if (oldllib.second != GENERAL_LibraryType && oldllib.second != linkType) {
+      std::string name = this->CheckCMP0004(oldllib.first);
+      if (name == this->GetName() || name.empty()) {
+        continue;
+      }
+      // Support OLD behavior for CMP0003.
+      impl.WrongConfigLibraries.push_back(
+        this->ResolveLinkItem(name, cmListFileBacktrace()));
+    }
+  }
+}
+
+void cmGeneratorTarget::ComputeLinkImplementationEntries(
+  const std::string& config, cmOptionalLinkImplementation& impl,
+  cmGeneratorTarget const* head) const
+{
+  // The result can be shared with other configurations unless an entry
+  // contains a generator expression or a diagnostic was issued for it.
+  // Not every expression that reads the configuration reports a context
+  // sensitive condition, e.g. $<TARGET_LINKER_FILE:...>, so only plain
+  // entries are known to give the same result for every configuration.
+  bool configIndependent = true;
   cmStringRange entryRange = this->Target->GetLinkImplementationEntries();
   cmBacktraceRange btRange = this->Target->GetLinkImplementationBacktraces();
   cmBacktraceRange::const_iterator btIt = btRange.begin();
@@ -6356,6 +6601,9 @@ void cmGeneratorTarget::ComputeLinkImplementationLibraries(
     if (cge->GetHadHeadSensitiveCondition()) {
       impl.HadHeadSensitiveCondition = true;
     }
+    if (cmGeneratorExpression::Find(*le) != std::string::npos) {
+      configIndependent = false;
+    }
 
     for (std::string const& lib : llibs) {
       // Skip entries that resolve to the target itself or are empty.
@@ -6380,6 +6628,7 @@ void cmGeneratorTarget::ComputeLinkImplementationLibraries(
           }
 
           if (!noMessage) {
+            configIndependent = false;
             e << "Target \"" << this->GetName() << "\" links to itself.";
             this->LocalGenerator->GetCMakeInstance()->IssueMessage(
               messageType, e.str(), this->GetBacktrace());
@@ -6404,26 +6653,7 @@ void cmGeneratorTarget::ComputeLinkImplementationLibraries(
     }
     cge->GetMaxLanguageStandard(this, this->MaxLanguageStandards);
   }
-
-  // Get the list of configurations considered to be DEBUG.
-  std::vector<std::string> debugConfigs =
-    this->Makefile->GetCMakeInstance()->GetDebugConfigs();
-
-  cmTargetLinkLibraryType linkType =
-    CMP0003_ComputeLinkType(config, debugConfigs);
-  cmTarget::LinkLibraryVectorType const& oldllibs =
-    this->Target->GetOriginalLinkLibraries();
-  for (cmTarget::LibraryID const& oldllib : oldllibs) {
-    if (oldllib.second != GENERAL_LibraryType && oldllib.second != linkType) {
-      std::string name = this->CheckCMP0004(oldllib.first);
-      if (name == this->GetName() || name.empty()) {
-        continue;
-      }
-      // Support OLD behavior for CMP0003.
-      impl.WrongConfigLibraries.push_back(
-        this->ResolveLinkItem(name, cmListFileBacktrace()));
-    }
-  }
+  impl.LibrariesConfigIndependent = configIndependent;
 }
 
 cmGeneratorTarget::TargetOrString cmGeneratorTarget::ResolveTargetReference(
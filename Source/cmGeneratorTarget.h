@@ -23,6 +23,7 @@ class cmCustomCommand;
 class cmGlobalGenerator;
 class cmLocalGenerator;
 class cmMakefile;
+class cmMemoryReport;
 class cmSourceFile;
 class cmTarget;
 
@@ -356,6 +357,9 @@ public:
   void ComputeLinkImplementationLibraries(const std::string& config,
                                           cmOptionalLinkImplementation& impl,
                                           const cmGeneratorTarget* head) const;
+  void ComputeLinkImplementationEntries(const std::string& config,
+                                        cmOptionalLinkImplementation& impl,
+                                        const cmGeneratorTarget* head) const;
 
   struct TargetOrString
   {
@@ -565,6 +569,9 @@ public:
    */
   void ClearSourcesCache();
 
+  /** Add the target and its cached meta data to a memory report.  */
+  void ReportMemory(cmMemoryReport& report) const;
+
   void AddSource(const std::string& src, bool before = false);
   void AddTracedSources(std::vector<std::string> const& srcs);
 
@@ -34,6 +34,7 @@
 #include "cmMSVC60LinkLineComputer.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
+#include "cmPathCache.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
 #include "cmSourceFile.h"
@@ -1175,6 +1176,7 @@ void cmGlobalGenerator::Configure()
 {
   this->FirstTimeProgress = 0.0f;
   this->ClearGeneratorMembers();
+  this->CMakeInstance->GetPathCache()->Clear();
 
   cmStateSnapshot snapshot = this->CMakeInstance->GetCurrentSnapshot();
 
@@ -1639,7 +1641,10 @@ void cmGlobalGenerator::ClearGeneratorMembers()
   this->ProjectMap.clear();
   this->RuleHashes.clear();
   this->DirectoryContentMap.clear();
+  this->DirectoryContentIndex.clear();
   this->BinaryDirectories.clear();
+
+  cmGeneratorExpression::ClearParseTreeCache();
 }
 
 void cmGlobalGenerator::ComputeTargetObjectDirectory(
@@ -2743,7 +2748,9 @@ void cmGlobalGenerator::AddToManifest(std::string const& f)
   std::string file = cmSystemTools::GetFilenameName(f);
   DirectoryContent& dc = this->DirectoryContentMap[dir];
   dc.Generated.insert(file);
-  dc.All.insert(file);
+  if (dc.All.insert(file).second) {
+    this->DirectoryContentIndex[file].push_back(dir);
+  }
 }
 
 std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
@@ -2753,6 +2760,14 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
   if (needDisk) {
     long mt = cmSystemTools::ModifiedTime(dir);
     if (mt != dc.LastDiskTime) {
+      // Drop the previously loaded disk content from the index.
+      for (std::string const& f : dc.All) {
+        if (dc.Generated.find(f) == dc.Generated.end()) {
+          std::vector<std::string>& dirs = this->DirectoryContentIndex[f];
+          dirs.erase(std::remove(dirs.begin(), dirs.end(), dir), dirs.end());
+        }
+      }
+
       // Reset to non-loaded directory content.
       dc.All = dc.Generated;
 
@@ -2762,8 +2777,9 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
         unsigned long n = d.GetNumberOfFiles();
         for (unsigned long i = 0; i < n; ++i) {
           const char* f = d.GetFile(i);
-          if (strcmp(f, ".") != 0 && strcmp(f, "..") != 0) {
-            dc.All.insert(f);
+          if (strcmp(f, ".") != 0 && strcmp(f, "..") != 0 &&
+              dc.All.insert(f).second) {
+            this->DirectoryContentIndex[f].push_back(dir);
           }
         }
       }
@@ -2773,6 +2789,14 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
   return dc.All;
 }
 
+std::vector<std::string> const& cmGlobalGenerator::GetDirectoriesContaining(
+  std::string const& name) const
+{
+  static std::vector<std::string> const empty;
+  auto i = this->DirectoryContentIndex.find(name);
+  return i != this->DirectoryContentIndex.end() ? i->second : empty;
+}
+
 void cmGlobalGenerator::AddRuleHash(const std::vector<std::string>& outputs,
                                     std::string const& content)
 {
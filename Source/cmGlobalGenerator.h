@@ -351,6 +351,12 @@ public:
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Get the directories whose cached content lists the given file
+      name.  Only directories already loaded by GetDirectoryContent or
+      holding files added to the manifest are considered.  */
+  std::vector<std::string> const& GetDirectoriesContaining(
+    std::string const& name) const;
+
   void IndexTarget(cmTarget* t);
   void IndexGeneratorTarget(cmGeneratorTarget* gt);
 
@@ -652,6 +658,10 @@ private:
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
 
+  // Index from file name to the directories whose content lists it.
+  std::unordered_map<std::string, std::vector<std::string>>
+    DirectoryContentIndex;
+
   // Set of binary directories on disk.
   std::set<std::string> BinaryDirectories;
 
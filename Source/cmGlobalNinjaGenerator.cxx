@@ -9,13 +9,17 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdio>
+#include <cstdlib>
 #include <iterator>
+#include <map>
 #include <sstream>
+#include <string>
 
 #include <cm/memory>
 
 #include "cmAlgorithms.h"
 #include "cmDocumentationEntry.h"
+#include "cmFileTime.h"
 #include "cmFortranParser.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpressionEvaluationFile.h"
@@ -834,11 +838,30 @@ void cmGlobalNinjaGenerator::AddAdditionalCleanFile(std::string fileName)
 }
 
 void cmGlobalNinjaGenerator::AddCXXCompileCommand(
-  const std::string& commandLine, const std::string& sourceFile)
+  cmGeneratorTarget const* target, const std::string& commandLine,
+  const std::string& sourceFile)
 {
   // Compute Ninja's build file path.
   std::string buildFileDir =
     this->GetCMakeInstance()->GetHomeOutputDirectory();
+
+  std::string sourceFileName = sourceFile;
+  if (!cmSystemTools::FileIsFullPath(sourceFileName)) {
+    sourceFileName = cmSystemTools::CollapseFullPath(
+      sourceFileName, this->GetCMakeInstance()->GetHomeOutputDirectory());
+  }
+
+  std::string const shardFile =
+    cmCompileCommandsShards::GetShardFile(target);
+  if (!shardFile.empty()) {
+    if (this->ComputingUnknownDependencies) {
+      this->CombinedBuildOutputs.insert(this->ConvertToNinjaPath(shardFile));
+    }
+    this->CompileCommandsShards.Add(shardFile, buildFileDir, commandLine,
+                                    sourceFileName);
+    return;
+  }
+
   if (!this->CompileCommandsStream) {
     std::string buildFilePath = buildFileDir + "/compile_commands.json";
     if (this->ComputingUnknownDependencies) {
@@ -854,12 +877,6 @@ void cmGlobalNinjaGenerator::AddCXXCompileCommand(
     *this->CompileCommandsStream << "," << std::endl;
   }
 
-  std::string sourceFileName = sourceFile;
-  if (!cmSystemTools::FileIsFullPath(sourceFileName)) {
-    sourceFileName = cmSystemTools::CollapseFullPath(
-      sourceFileName, this->GetCMakeInstance()->GetHomeOutputDirectory());
-  }
-
   /* clang-format off */
   *this->CompileCommandsStream << "\n{\n"
      << R"(  "directory": ")"
@@ -874,10 +891,13 @@ void cmGlobalNinjaGenerator::AddCXXCompileCommand(
 
 void cmGlobalNinjaGenerator::CloseCompileCommandsStream()
 {
+  bool const wroteCompileCommands = this->CompileCommandsStream != nullptr;
   if (this->CompileCommandsStream) {
     *this->CompileCommandsStream << "\n]";
     this->CompileCommandsStream.reset();
   }
+  this->CompileCommandsShards.Write(
+    this->GetCMakeInstance()->GetHomeOutputDirectory(), wroteCompileCommands);
 }
 
 void cmGlobalNinjaGenerator::WriteDisclaimer(std::ostream& os)
@@ -1831,6 +1851,86 @@ struct cmDyndepObjectInfo
   std::vector<std::string> Requires;
 };
 
+namespace {
+// The information taken from a ddi file when it had the given time.
+struct cmDyndepCacheEntry
+{
+  cmFileTime::NSC Time = 0;
+  cmDyndepObjectInfo Info;
+};
+
+using cmDyndepCache = std::map<std::string, cmDyndepCacheEntry>;
+
+#define DYNDEP_CACHE_HEADER "# cmake_ninja_dyndep cache 1"
+
+bool ReadDyndepCacheList(std::istream& is, std::vector<std::string>& list)
+{
+  std::string line;
+  if (!cmSystemTools::GetLineFromStream(is, line)) {
+    return false;
+  }
+  char* end = nullptr;
+  unsigned long const count = std::strtoul(line.c_str(), &end, 10);
+  if (line.empty() || *end != '\0') {
+    return false;
+  }
+  for (unsigned long i = 0; i < count; ++i) {
+    if (!cmSystemTools::GetLineFromStream(is, line)) {
+      return false;
+    }
+    list.push_back(line);
+  }
+  return true;
+}
+
+// Read the cache of a previous run.  Each entry lists the ddi file, its
+// modification time, the object and the counted lists of the modules
+// it provides and requires, one per line.
+void ReadDyndepCache(std::string const& file, cmDyndepCache& cache)
+{
+  cmsys::ifstream fin(file.c_str());
+  std::string line;
+  if (!fin || !cmSystemTools::GetLineFromStream(fin, line) ||
+      line != DYNDEP_CACHE_HEADER) {
+    return;
+  }
+  std::string ddi;
+  while (cmSystemTools::GetLineFromStream(fin, ddi)) {
+    cmDyndepCacheEntry entry;
+    char* end = nullptr;
+    if (cmSystemTools::GetLineFromStream(fin, line) && !line.empty()) {
+      entry.Time = std::strtoll(line.c_str(), &end, 10);
+    }
+    if (end == nullptr || *end != '\0' ||
+        !cmSystemTools::GetLineFromStream(fin, entry.Info.Object) ||
+        !ReadDyndepCacheList(fin, entry.Info.Provides) ||
+        !ReadDyndepCacheList(fin, entry.Info.Requires)) {
+      cache.clear();
+      return;
+    }
+    cache[ddi] = std::move(entry);
+  }
+}
+
+void WriteDyndepCache(std::string const& file, cmDyndepCache const& cache)
+{
+  cmGeneratedFileStream fout(file);
+  fout << DYNDEP_CACHE_HEADER "\n";
+  for (auto const& c : cache) {
+    cmDyndepObjectInfo const& info = c.second.Info;
+    fout << c.first << '\n' << c.second.Time << '\n' << info.Object << '\n';
+    fout << info.Provides.size() << '\n';
+    for (std::string const& p : info.Provides) {
+      fout << p << '\n';
+    }
+    fout << info.Requires.size() << '\n';
+    for (std::string const& r : info.Requires) {
+      fout << r << '\n';
+    }
+  }
+}
+}
+
 bool cmGlobalNinjaGenerator::WriteDyndepFile(
   std::string const& dir_top_src, std::string const& dir_top_bld,
   std::string const& dir_cur_src, std::string const& dir_cur_bld,
@@ -1854,8 +1954,28 @@ bool cmGlobalNinjaGenerator::WriteDyndepFile(
     this->LocalGenerators.push_back(lgd.release());
   }
 
+  // The dyndep file is regenerated whenever one of the ddi files changes.
+  // Keep what was taken from the ddi files in the previous run so that
+  // only the changed ones have to be parsed again.
+  std::string const cache_file = cmStrCat(
+    cmSystemTools::GetFilenamePath(arg_dd), '/', arg_lang, "DyndepCache.txt");
+  cmDyndepCache cache;
+  ReadDyndepCache(cache_file, cache);
+  cmDyndepCache new_cache;
+  bool cache_changed = false;
+
   std::vector<cmDyndepObjectInfo> objects;
   for (std::string const& arg_ddi : arg_ddis) {
+    cmFileTime ddi_time;
+    bool const ddi_time_known = ddi_time.Load(arg_ddi);
+    auto const cached = cache.find(arg_ddi);
+    if (ddi_time_known && cached != cache.end() &&
+        cached->second.Time == ddi_time.GetNS()) {
+      objects.push_back(cached->second.Info);
+      new_cache[arg_ddi] = std::move(cached->second);
+      continue;
+    }
+
     // Load the ddi file and compute the module file paths it provides.
     Json::Value ddio;
     Json::Value const& ddi = ddio;
@@ -1882,8 +2002,18 @@ bool cmGlobalNinjaGenerator::WriteDyndepFile(
         info.Requires.push_back(ddi_require.asString());
       }
     }
+    if (ddi_time_known) {
+      cmDyndepCacheEntry& entry = new_cache[arg_ddi];
+      entry.Time = ddi_time.GetNS();
+      entry.Info = info;
+    }
+    cache_changed = true;
     objects.push_back(std::move(info));
   }
+  // Entries of ddi files that are no longer used are dropped.
+  if (new_cache.size() != cache.size()) {
+    cache_changed = true;
+  }
 
   // Map from module name to module file path, if known.
   std::map<std::string, std::string> mod_files;
@@ -1955,6 +2085,10 @@ bool cmGlobalNinjaGenerator::WriteDyndepFile(
   cmGeneratedFileStream tmf(target_mods_file);
   tmf << tm;
 
+  if (cache_changed) {
+    WriteDyndepCache(cache_file, new_cache);
+  }
+
   return true;
 }
 
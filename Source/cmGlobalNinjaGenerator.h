@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "cmCompileCommandsShards.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGlobalCommonGenerator.h"
 #include "cmGlobalGenerator.h"
@@ -237,7 +238,8 @@ public:
     return "CMakeFiles/clean.additional";
   }
 
-  void AddCXXCompileCommand(const std::string& commandLine,
+  void AddCXXCompileCommand(cmGeneratorTarget const* target,
+                            const std::string& commandLine,
                             const std::string& sourceFile);
 
   /**
@@ -393,6 +395,7 @@ private:
   /// edge of the compilation DAG).
   std::unique_ptr<cmGeneratedFileStream> RulesFileStream;
   std::unique_ptr<cmGeneratedFileStream> CompileCommandsStream;
+  cmCompileCommandsShards CompileCommandsShards;
 
   /// The set of rules added to the generated build system.
   std::unordered_set<std::string> Rules;
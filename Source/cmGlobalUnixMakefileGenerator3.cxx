@@ -155,17 +155,28 @@ void cmGlobalUnixMakefileGenerator3::Generate()
   this->WriteMainMakefile2();
   this->WriteMainCMakefile();
 
+  bool const wroteCompileCommands = this->CommandDatabase != nullptr;
   if (this->CommandDatabase != nullptr) {
     *this->CommandDatabase << std::endl << "]";
     delete this->CommandDatabase;
     this->CommandDatabase = nullptr;
   }
+  this->CompileCommandsShards.Write(
+    this->GetCMakeInstance()->GetHomeOutputDirectory(), wroteCompileCommands);
 }
 
 void cmGlobalUnixMakefileGenerator3::AddCXXCompileCommand(
-  const std::string& sourceFile, const std::string& workingDirectory,
-  const std::string& compileCommand)
+  cmGeneratorTarget const* target, const std::string& sourceFile,
+  const std::string& workingDirectory, const std::string& compileCommand)
 {
+  std::string const shardFile =
+    cmCompileCommandsShards::GetShardFile(target);
+  if (!shardFile.empty()) {
+    this->CompileCommandsShards.Add(shardFile, workingDirectory,
+                                    compileCommand, sourceFile);
+    return;
+  }
+
   if (this->CommandDatabase == nullptr) {
     std::string commandDatabaseName =
       this->GetCMakeInstance()->GetHomeOutputDirectory() +
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "cmCompileCommandsShards.h"
 #include "cmGeneratorTarget.h"
 #include "cmGlobalCommonGenerator.h"
 #include "cmGlobalGeneratorFactory.h"
@@ -137,7 +138,8 @@ public:
   /** Record per-target progress information.  */
   void RecordTargetProgress(cmMakefileTargetGenerator* tg);
 
-  void AddCXXCompileCommand(const std::string& sourceFile,
+  void AddCXXCompileCommand(cmGeneratorTarget const* target,
+                            const std::string& sourceFile,
                             const std::string& workingDirectory,
                             const std::string& compileCommand);
 
@@ -230,6 +232,7 @@ protected:
   size_t CountProgressMarksInAll(cmLocalGenerator* lg);
 
   cmGeneratedFileStream* CommandDatabase;
+  cmCompileCommandsShards CompileCommandsShards;
 
 private:
   const char* GetBuildIgnoreErrorsFlag() const override { return "-i"; }
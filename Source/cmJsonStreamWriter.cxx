@@ -0,0 +1,179 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmJsonStreamWriter.h"
+
+#include "cm_jsoncpp_writer.h"
+
+#include <cassert>
+#include <ostream>
+
+namespace {
+void WriteIndent(std::ostream& out, std::string::size_type depth)
+{
+  out << '\n';
+  for (; depth > 0; --depth) {
+    out << '\t';
+  }
+}
+}
+
+cmJsonStreamWriter::cmJsonStreamWriter(std::ostream& out)
+  : Out(out)
+{
+}
+
+void cmJsonStreamWriter::BeginObject()
+{
+  this->BeginContainer(true);
+}
+
+void cmJsonStreamWriter::EndObject()
+{
+  this->EndContainer(true);
+}
+
+void cmJsonStreamWriter::BeginArray()
+{
+  this->BeginContainer(false);
+}
+
+void cmJsonStreamWriter::EndArray()
+{
+  this->EndContainer(false);
+}
+
+void cmJsonStreamWriter::Key(std::string const& key)
+{
+  assert(!this->Containers.empty() && this->Containers.back().IsObject);
+  Container& object = this->Containers.back();
+  assert(!object.IsOpen || object.LastKey < key);
+  object.LastKey = key;
+
+  // The members are indented one level deeper than the braces.
+  this->OpenContainer();
+  WriteIndent(this->Out, this->Containers.size());
+  this->Out << Json::valueToQuotedString(key.c_str()) << " : ";
+}
+
+void cmJsonStreamWriter::Value(std::string const& value)
+{
+  this->Write(Json::valueToQuotedString(value.c_str()));
+}
+
+void cmJsonStreamWriter::Value(const char* value)
+{
+  this->Write(Json::valueToQuotedString(value));
+}
+
+void cmJsonStreamWriter::Value(bool value)
+{
+  this->Write(Json::valueToString(value));
+}
+
+void cmJsonStreamWriter::Value(int value)
+{
+  this->Write(Json::valueToString(Json::LargestInt(value)));
+}
+
+void cmJsonStreamWriter::Value(unsigned int value)
+{
+  this->Write(Json::valueToString(Json::LargestUInt(value)));
+}
+
+void cmJsonStreamWriter::Value(Json::Value const& value)
+{
+  switch (value.type()) {
+    case Json::nullValue:
+      this->Write("null");
+      break;
+    case Json::intValue:
+      this->Write(Json::valueToString(value.asLargestInt()));
+      break;
+    case Json::uintValue:
+      this->Write(Json::valueToString(value.asLargestUInt()));
+      break;
+    case Json::realValue:
+      this->Write(Json::valueToString(value.asDouble()));
+      break;
+    case Json::stringValue:
+      this->Value(value.asString());
+      break;
+    case Json::booleanValue:
+      this->Value(value.asBool());
+      break;
+    case Json::arrayValue:
+      this->BeginArray();
+      for (Json::Value const& element : value) {
+        this->Value(element);
+      }
+      this->EndArray();
+      break;
+    case Json::objectValue:
+      // The member names are sorted.
+      this->BeginObject();
+      for (std::string const& name : value.getMemberNames()) {
+        this->Key(name);
+        this->Value(value[name]);
+      }
+      this->EndObject();
+      break;
+  }
+}
+
+void cmJsonStreamWriter::BeginContainer(bool isObject)
+{
+  bool const isMember =
+    !this->Containers.empty() && this->Containers.back().IsObject;
+  this->BeginValue();
+  this->Containers.emplace_back();
+  this->Containers.back().IsObject = isObject;
+  this->Containers.back().IsMember = isMember;
+}
+
+void cmJsonStreamWriter::EndContainer(bool isObject)
+{
+  assert(!this->Containers.empty() &&
+         this->Containers.back().IsObject == isObject);
+  bool const isOpen = this->Containers.back().IsOpen;
+  this->Containers.pop_back();
+  if (!isOpen) {
+    this->Out << (isObject ? "{}" : "[]");
+    return;
+  }
+
+  // The closing bracket is indented as the opening one.
+  WriteIndent(this->Out, this->Containers.size());
+  this->Out << (isObject ? '}' : ']');
+}
+
+void cmJsonStreamWriter::OpenContainer()
+{
+  Container& container = this->Containers.back();
+  if (container.IsOpen) {
+    this->Out << ',';
+    return;
+  }
+  container.IsOpen = true;
+  if (container.IsMember) {
+    WriteIndent(this->Out, this->Containers.size() - 1);
+  }
+  this->Out << (container.IsObject ? '{' : '[');
+}
+
+void cmJsonStreamWriter::BeginValue()
+{
+  // The separator of an object member is written with its name.
+  if (this->Containers.empty() || this->Containers.back().IsObject) {
+    return;
+  }
+
+  // An array element is indented by the number of containers around it.
+  this->OpenContainer();
+  WriteIndent(this->Out, this->Containers.size());
+}
+
+void cmJsonStreamWriter::Write(std::string const& text)
+{
+  this->BeginValue();
+  this->Out << text;
+}
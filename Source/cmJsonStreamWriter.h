@@ -0,0 +1,74 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmJsonStreamWriter_h
+#define cmJsonStreamWriter_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cm_jsoncpp_value.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/** \class cmJsonStreamWriter
+ * \brief Serialize JSON while it is produced.
+ *
+ * Values are written to the output stream as soon as they are given, so
+ * that no Json::Value tree needs to be built first.  The text is the same
+ * as that of a Json::StreamWriter created with the default settings of a
+ * Json::StreamWriterBuilder as long as the members of each object are
+ * written in name order, the order in which such a writer puts them.
+ * Each writer holds its own state, so writers of different documents may
+ * be used on different threads.
+ */
+class cmJsonStreamWriter
+{
+public:
+  explicit cmJsonStreamWriter(std::ostream& out);
+
+  cmJsonStreamWriter(cmJsonStreamWriter const&) = delete;
+  cmJsonStreamWriter& operator=(cmJsonStreamWriter const&) = delete;
+
+  /** Start or end an object or array.  */
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+
+  /** Name the member of the current object that is written next.  The
+      members of an object must be named in ascending order.  */
+  void Key(std::string const& key);
+
+  /** Write a value as the next array element or object member.  */
+  void Value(std::string const& value);
+  void Value(const char* value);
+  void Value(bool value);
+  void Value(int value);
+  void Value(unsigned int value);
+  void Value(Json::Value const& value);
+
+private:
+  struct Container
+  {
+    bool IsObject = false;
+    // An object member holding a non-empty container starts it on a
+    // line of its own.
+    bool IsMember = false;
+    // The opening bracket is written with the first element, when it is
+    // known whether the container is empty.
+    bool IsOpen = false;
+    std::string LastKey;
+  };
+
+  void BeginContainer(bool isObject);
+  void EndContainer(bool isObject);
+  void OpenContainer();
+  void BeginValue();
+  void Write(std::string const& text);
+
+  std::ostream& Out;
+  std::vector<Container> Containers;
+};
+
+#endif
@@ -107,6 +107,10 @@ struct cmOptionalLinkImplementation : public cmLinkImplementation
   bool LibrariesDone = false;
   bool LanguagesDone = false;
   bool HadHeadSensitiveCondition = false;
+
+  // Whether the libraries are the same for all configurations, so that
+  // other configurations can reuse them instead of evaluating again.
+  bool LibrariesConfigIndependent = false;
 };
 
 /** Compute the link type to use for the given configuration.  */
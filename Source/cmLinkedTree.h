@@ -6,6 +6,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <cassert>
+#include <cstddef>
 #include <vector>
 
 /**
@@ -171,6 +172,16 @@ public:
     this->Data.clear();
   }
 
+  /** Get the stored nodes, including those no longer referenced.  */
+  std::vector<T> const& GetNodes() const { return this->Data; }
+
+  /** Get the bytes allocated for the nodes and their links.  */
+  std::size_t GetCapacityBytes() const
+  {
+    return this->Data.capacity() * sizeof(T) +
+      this->UpPositions.capacity() * sizeof(PositionType);
+  }
+
 private:
   T& GetReference(PositionType pos) { return this->Data[pos]; }
 
@@ -11,10 +11,13 @@
 #include "cmSystemTools.h"
 
 #include <cassert>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <utility>
 
+#include <cm/memory>
+
 cmCommandContext::cmCommandName& cmCommandContext::cmCommandName::operator=(
   std::string const& name)
 {
@@ -42,6 +45,9 @@ struct cmListFileParser
   const char* FileName;
   cmListFileLexer* Lexer;
   cmListFileFunction Function;
+  // Arguments of the function being parsed.  Reused across functions
+  // so that its capacity is not built up again for each of them.
+  std::vector<cmListFileArgument> Arguments;
   enum
   {
     SeparationOkay,
@@ -68,12 +74,18 @@ cmListFileParser::~cmListFileParser()
 
 void cmListFileParser::IssueFileOpenError(const std::string& text) const
 {
+  if (!this->Messenger) {
+    return;
+  }
   this->Messenger->IssueMessage(MessageType::FATAL_ERROR, text,
                                 this->Backtrace);
 }
 
 void cmListFileParser::IssueError(const std::string& text) const
 {
+  if (!this->Messenger) {
+    return;
+  }
   cmListFileContext lfc;
   lfc.FilePath = this->FileName;
   lfc.Line = cmListFileLexer_GetCurrentLine(this->Lexer);
@@ -120,7 +132,7 @@ bool cmListFileParser::ParseFile()
       if (haveNewline) {
         haveNewline = false;
         if (this->ParseFunction(token->text, token->line)) {
-          this->ListFile->Functions.push_back(this->Function);
+          this->ListFile->Functions.push_back(std::move(this->Function));
         } else {
           return false;
         }
@@ -168,6 +180,7 @@ bool cmListFileParser::ParseFunction(const char* name, long line)
   this->Function = cmListFileFunction();
   this->Function.Name = name;
   this->Function.Line = line;
+  this->Arguments.clear();
 
   // Command name has already been parsed.  Read the left paren.
   cmListFileLexer_Token* token;
@@ -209,6 +222,10 @@ bool cmListFileParser::ParseFunction(const char* name, long line)
       }
     } else if (token->type == cmListFileLexer_Token_ParenRight) {
       if (parenDepth == 0) {
+        // Store the arguments without spare capacity.
+        this->Function.Arguments.assign(
+          std::make_move_iterator(this->Arguments.begin()),
+          std::make_move_iterator(this->Arguments.end()));
         return true;
       }
       parenDepth--;
@@ -247,6 +264,9 @@ bool cmListFileParser::ParseFunction(const char* name, long line)
     }
   }
 
+  if (!this->Messenger) {
+    return false;
+  }
   std::ostringstream error;
   cmListFileContext lfc;
   lfc.FilePath = this->FileName;
@@ -262,10 +282,16 @@ bool cmListFileParser::ParseFunction(const char* name, long line)
 bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
                                    cmListFileArgument::Delimiter delim)
 {
-  this->Function.Arguments.emplace_back(token->text, delim, token->line);
+  this->Arguments.emplace_back(std::string(token->text, token->length),
+                               delim, token->line);
   if (this->Separation == SeparationOkay) {
     return true;
   }
+  // Without a messenger even a warning fails the parse so that the
+  // file is parsed again by someone who can report it.
+  if (!this->Messenger) {
+    return false;
+  }
   bool isError = (this->Separation == SeparationError ||
                   delim == cmListFileArgument::Bracket);
   std::ostringstream m;
@@ -287,38 +313,80 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
   return true;
 }
 
+namespace {
+std::string const EmptyBacktraceString;
+}
+
 // We hold either the bottom scope of a directory or a call/file context.
-// Discriminate these cases via the parent pointer.
+// Discriminate these cases via the parent pointer.  A context holds only
+// handles to strings interned by the cmState of the bottom scope, which
+// keeps them until its next Reset.  The cmListFileContext is built when
+// first asked for, which is rare compared to the number of frames.
+// Entries are shared and lazily updated without synchronization, so
+// backtraces may be used only from the main thread.
 struct cmListFileBacktrace::Entry
 {
+  struct Frame
+  {
+    std::string const* FilePath;
+    std::string const* Name;
+    long Line;
+  };
+
   Entry(cmStateSnapshot bottom)
     : Bottom(bottom)
+    , State(bottom.GetState())
   {
   }
 
-  Entry(std::shared_ptr<Entry const> parent, cmListFileContext lfc)
-    : Context(std::move(lfc))
+  Entry(std::shared_ptr<Entry const> parent, Frame const& frame)
+    : Context(frame)
+    , State(parent->State)
     , Parent(std::move(parent))
   {
   }
 
   ~Entry()
   {
-    if (this->Parent) {
-      this->Context.~cmListFileContext();
-    } else {
+    if (!this->Parent) {
       this->Bottom.~cmStateSnapshot();
     }
   }
 
   bool IsBottom() const { return !this->Parent; }
 
+  bool Matches(Frame const& frame) const
+  {
+    return this->Context.FilePath == frame.FilePath &&
+      this->Context.Name == frame.Name && this->Context.Line == frame.Line;
+  }
+
+  cmListFileContext const& GetContext() const
+  {
+    if (!this->Materialized) {
+      auto lfc = cm::make_unique<cmListFileContext>();
+      lfc->FilePath = *this->Context.FilePath;
+      lfc->Name = *this->Context.Name;
+      lfc->Line = this->Context.Line;
+      this->Materialized = std::move(lfc);
+    }
+    return *this->Materialized;
+  }
+
   union
   {
     cmStateSnapshot Bottom;
-    cmListFileContext Context;
+    Frame Context;
   };
+  // The state of the bottom scope, which interns the strings of the
+  // frames.  Pushing a frame needs it without walking to the bottom.
+  cmState* State;
   std::shared_ptr<Entry const> Parent;
+
+  // The most recent frame pushed on top of this one.  A call repeated
+  // from the same place, e.g. in a loop, shares its frame.
+  mutable std::weak_ptr<Entry const> LastChild;
+  mutable std::unique_ptr<cmListFileContext const> Materialized;
 };
 
 cmListFileBacktrace::cmListFileBacktrace(cmStateSnapshot const& snapshot)
@@ -326,13 +394,6 @@ cmListFileBacktrace::cmListFileBacktrace(cmStateSnapshot const& snapshot)
 {
 }
 
-/* NOLINTNEXTLINE(performance-unnecessary-value-param) */
-cmListFileBacktrace::cmListFileBacktrace(std::shared_ptr<Entry const> parent,
-                                         cmListFileContext const& lfc)
-  : TopEntry(std::make_shared<Entry const>(std::move(parent), lfc))
-{
-}
-
 cmListFileBacktrace::cmListFileBacktrace(std::shared_ptr<Entry const> top)
   : TopEntry(std::move(top))
 {
@@ -356,17 +417,30 @@ cmListFileBacktrace cmListFileBacktrace::Push(std::string const& file) const
   // any specific line or command invocation within it.  This context
   // is useful to print when it is at the top but otherwise can be
   // skipped during call stack printing.
-  cmListFileContext lfc;
-  lfc.FilePath = file;
-  return this->Push(lfc);
+  return this->Push(file, EmptyBacktraceString, 0);
 }
 
 cmListFileBacktrace cmListFileBacktrace::Push(
   cmListFileContext const& lfc) const
+{
+  return this->Push(lfc.FilePath, lfc.Name, lfc.Line);
+}
+
+cmListFileBacktrace cmListFileBacktrace::Push(std::string const& file,
+                                              std::string const& name,
+                                              long line) const
 {
   assert(this->TopEntry);
   assert(!this->TopEntry->IsBottom() || this->TopEntry->Bottom.IsValid());
-  return cmListFileBacktrace(this->TopEntry, lfc);
+  cmState* state = this->TopEntry->State;
+  Entry::Frame const frame = { state->InternBacktraceString(file),
+                               state->InternBacktraceString(name), line };
+  std::shared_ptr<Entry const> child = this->TopEntry->LastChild.lock();
+  if (!child || !child->Matches(frame)) {
+    child = std::make_shared<Entry const>(this->TopEntry, frame);
+    this->TopEntry->LastChild = child;
+  }
+  return cmListFileBacktrace(std::move(child));
 }
 
 cmListFileBacktrace cmListFileBacktrace::Pop() const
@@ -380,7 +454,7 @@ cmListFileContext const& cmListFileBacktrace::Top() const
 {
   assert(this->TopEntry);
   assert(!this->TopEntry->IsBottom());
-  return this->TopEntry->Context;
+  return this->TopEntry->GetContext();
 }
 
 void cmListFileBacktrace::PrintTitle(std::ostream& out) const
@@ -389,7 +463,7 @@ void cmListFileBacktrace::PrintTitle(std::ostream& out) const
   if (!this->TopEntry || this->TopEntry->IsBottom()) {
     return;
   }
-  cmListFileContext lfc = this->TopEntry->Context;
+  cmListFileContext lfc = this->TopEntry->GetContext();
   cmStateSnapshot bottom = this->GetBottom();
   if (!bottom.GetState()->GetIsInTryCompile()) {
     lfc.FilePath = bottom.GetDirectory().ConvertToRelPathIfNotContained(
@@ -411,7 +485,7 @@ void cmListFileBacktrace::PrintCallStack(std::ostream& out) const
   cmStateSnapshot bottom = this->GetBottom();
   for (Entry const* cur = this->TopEntry->Parent.get(); !cur->IsBottom();
        cur = cur->Parent.get()) {
-    if (cur->Context.Name.empty()) {
+    if (cur->Context.Name->empty()) {
       // Skip this whole-file scope.  When we get here we already will
       // have printed a more-specific context within the file.
       continue;
@@ -420,7 +494,10 @@ void cmListFileBacktrace::PrintCallStack(std::ostream& out) const
       first = false;
       out << "Call Stack (most recent call first):\n";
     }
-    cmListFileContext lfc = cur->Context;
+    cmListFileContext lfc;
+    lfc.Name = *cur->Context.Name;
+    lfc.Line = cur->Context.Line;
+    lfc.FilePath = *cur->Context.FilePath;
     if (!bottom.GetState()->GetIsInTryCompile()) {
       lfc.FilePath = bottom.GetDirectory().ConvertToRelPathIfNotContained(
         bottom.GetState()->GetSourceDirectory(), lfc.FilePath);
@@ -118,6 +118,8 @@ public:
   // Get a backtrace with the given call context added to the top.
   // May not be called until after construction with a valid snapshot.
   cmListFileBacktrace Push(cmListFileContext const& lfc) const;
+  cmListFileBacktrace Push(std::string const& file, std::string const& name,
+                           long line) const;
 
   // Get a backtrace with the top level removed.
   // May not be called until after a matching Push.
@@ -142,8 +144,6 @@ public:
 private:
   struct Entry;
   std::shared_ptr<Entry const> TopEntry;
-  cmListFileBacktrace(std::shared_ptr<Entry const> parent,
-                      cmListFileContext const& lfc);
   cmListFileBacktrace(std::shared_ptr<Entry const> top);
 };
 
@@ -181,6 +181,8 @@ std::vector<BT<std::string>> ExpandListWithBacktrace(
 
 struct cmListFile
 {
+  // Parse the given file.  Without a messenger nothing is reported and
+  // anything that would produce a diagnostic fails the parse.
   bool ParseFile(const char* path, cmMessenger* messenger,
                  cmListFileBacktrace const& lfbt);
 
@@ -0,0 +1,246 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmListFilePrefetcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cm/memory>
+
+#include "cmFileTime.h"
+#include "cmListFileCache.h"
+#include "cmState.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+class cmListFilePrefetcherInternals
+{
+public:
+  void Run();
+  void Follow(std::string const& path, std::string const& sourceDirectory,
+              cmListFile const& listFile);
+  void Enqueue(std::string const& path, std::string const& sourceDirectory);
+
+  enum class Status
+  {
+    Queued,
+    Parsing,
+    Parsed,
+    // The file was taken, or the caller parsed it itself.
+    Taken
+  };
+
+  struct File
+  {
+    Status State = Status::Queued;
+    cmFileTime Time;
+    unsigned long Length = 0;
+    std::shared_ptr<cmListFile const> ListFile;
+  };
+
+  // A file to parse and the source directory relative paths in it are
+  // relative to.
+  struct Work
+  {
+    std::string Path;
+    std::string SourceDirectory;
+  };
+
+  std::string Directory;
+  std::mutex Mutex;
+  std::condition_variable WorkAvailable;
+  std::condition_variable FileParsed;
+  std::deque<Work> Queue;
+  std::unordered_map<std::string, File> Files;
+  std::vector<std::thread> Threads;
+  // Number of files being parsed, which may lead to more work.
+  unsigned int Parsing = 0;
+  bool Stop = false;
+};
+
+namespace {
+// Get the path named by a literal argument, or an empty string if the
+// argument is evaluated when the command runs.
+std::string LiteralPath(cmListFileArgument const& arg,
+                        std::string const& sourceDirectory)
+{
+  std::string path = arg.Value;
+  if (path.empty() || path.find_first_of("$@;\\") != std::string::npos) {
+    return std::string();
+  }
+  while (path.size() > 1 && path.back() == '/') {
+    path.pop_back();
+  }
+  if (!cmSystemTools::FileIsFullPath(path)) {
+    path = cmStrCat(sourceDirectory, '/', path);
+  }
+  return path;
+}
+}
+
+void cmListFilePrefetcherInternals::Follow(std::string const& path,
+                                           std::string const& sourceDirectory,
+                                           cmListFile const& listFile)
+{
+  // Commands of included files run with the source directory of the
+  // including CMakeLists.txt, so only those add subdirectories.
+  bool const isDirectory =
+    cmSystemTools::GetFilenameName(path) == "CMakeLists.txt";
+  for (cmListFileFunction const& func : listFile.Functions) {
+    if (func.Arguments.empty()) {
+      continue;
+    }
+    std::string const target =
+      LiteralPath(func.Arguments[0], sourceDirectory);
+    if (target.empty()) {
+      continue;
+    }
+    if (isDirectory && func.Name.Lower == "add_subdirectory") {
+      this->Enqueue(target + "/CMakeLists.txt", target);
+    } else if (func.Name.Lower == "include" &&
+               cmHasLiteralSuffix(target, ".cmake")) {
+      // Other names are modules looked up in CMAKE_MODULE_PATH.
+      this->Enqueue(target, sourceDirectory);
+    }
+  }
+}
+
+void cmListFilePrefetcherInternals::Enqueue(std::string const& path,
+                                            std::string const& sourceDirectory)
+{
+  if (!cmSystemTools::IsSubDirectory(path, this->Directory)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->Stop || !this->Files.emplace(path, File()).second) {
+      return;
+    }
+    this->Queue.push_back(Work{ path, sourceDirectory });
+  }
+  this->WorkAvailable.notify_one();
+}
+
+void cmListFilePrefetcherInternals::Run()
+{
+  for (;;) {
+    Work work;
+    {
+      std::unique_lock<std::mutex> lock(this->Mutex);
+      this->WorkAvailable.wait(lock, [this] {
+        return this->Stop || !this->Queue.empty() || this->Parsing == 0;
+      });
+      if (this->Stop || this->Queue.empty()) {
+        // Nothing being parsed is left to add more work.
+        this->WorkAvailable.notify_all();
+        return;
+      }
+      work = std::move(this->Queue.front());
+      this->Queue.pop_front();
+      File& file = this->Files[work.Path];
+      if (file.State != Status::Queued) {
+        continue;
+      }
+      file.State = Status::Parsing;
+      ++this->Parsing;
+    }
+
+    // Look at the file before parsing it, as cmState does, so that a
+    // change made while parsing is noticed when the file is taken.
+    File parsed;
+    if (parsed.Time.Load(work.Path)) {
+      parsed.Length = cmSystemTools::FileLength(work.Path);
+      auto listFile = std::make_shared<cmListFile>();
+      if (listFile->ParseFile(work.Path.c_str(), nullptr,
+                              cmListFileBacktrace())) {
+        this->Follow(work.Path, work.SourceDirectory, *listFile);
+        parsed.ListFile = std::move(listFile);
+      }
+    }
+    parsed.State = Status::Parsed;
+
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Files[work.Path] = std::move(parsed);
+      --this->Parsing;
+    }
+    this->FileParsed.notify_all();
+    this->WorkAvailable.notify_all();
+  }
+}
+
+unsigned int cmListFilePrefetcher::GetThreadCount()
+{
+  // The main thread is busy configuring the project.
+  unsigned int const threadCount = std::thread::hardware_concurrency();
+  return threadCount > 1 ? threadCount - 1 : 0;
+}
+
+cmListFilePrefetcher::cmListFilePrefetcher(cmState* state,
+                                           std::string directory)
+  : State(state)
+  , Directory(std::move(directory))
+  , Internal(cm::make_unique<cmListFilePrefetcherInternals>())
+{
+  cmListFilePrefetcherInternals* internal = this->Internal.get();
+  internal->Directory = this->Directory;
+  internal->Enqueue(this->Directory + "/CMakeLists.txt", this->Directory);
+  unsigned int const threadCount = std::max(GetThreadCount(), 1u);
+  for (unsigned int i = 0; i < threadCount; ++i) {
+    internal->Threads.emplace_back([internal] { internal->Run(); });
+  }
+  this->State->AddListFilePrefetcher(this);
+}
+
+cmListFilePrefetcher::~cmListFilePrefetcher()
+{
+  this->State->RemoveListFilePrefetcher(this);
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    this->Internal->Stop = true;
+  }
+  this->Internal->WorkAvailable.notify_all();
+  for (std::thread& thread : this->Internal->Threads) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<cmListFile const> cmListFilePrefetcher::Take(
+  std::string const& path)
+{
+  using Status = cmListFilePrefetcherInternals::Status;
+  if (!cmSystemTools::IsSubDirectory(path, this->Directory)) {
+    return nullptr;
+  }
+
+  cmListFilePrefetcherInternals::File file;
+  {
+    std::unique_lock<std::mutex> lock(this->Internal->Mutex);
+    auto it = this->Internal->Files.find(path);
+    if (it == this->Internal->Files.end()) {
+      // Not found yet.  Keep the workers from parsing it later.
+      this->Internal->Files[path].State = Status::Taken;
+      return nullptr;
+    }
+    this->Internal->FileParsed.wait(
+      lock, [&it] { return it->second.State != Status::Parsing; });
+    std::swap(file, it->second);
+    it->second.State = Status::Taken;
+  }
+
+  if (file.State != Status::Parsed || !file.ListFile) {
+    return nullptr;
+  }
+  cmFileTime time;
+  if (!time.Load(path) || !time.Equal(file.Time) ||
+      cmSystemTools::FileLength(path) != file.Length) {
+    return nullptr;
+  }
+  return file.ListFile;
+}
@@ -0,0 +1,54 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmListFilePrefetcher_h
+#define cmListFilePrefetcher_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <memory>
+#include <string>
+
+class cmState;
+struct cmListFile;
+class cmListFilePrefetcherInternals;
+
+/** \class cmListFilePrefetcher
+ * \brief Parse the CMake language files of a source tree in the background.
+ *
+ * While a subdirectory added with add_subdirectory() is configured, worker
+ * threads parse its CMakeLists.txt ahead of time.  They follow the
+ * add_subdirectory() and include() calls of the parsed files whose file
+ * or directory argument is a literal path below the subdirectory, so only
+ * files the configure step is likely to read are parsed.  The files are
+ * still read in the order in which the configure step needs them, since
+ * cmState::ParseListFile takes the results from the prefetchers registered
+ * with it.  Files that fail to parse, or would produce a diagnostic, are
+ * left to be parsed again by the caller.
+ */
+class cmListFilePrefetcher
+{
+public:
+  cmListFilePrefetcher(cmState* state, std::string directory);
+  ~cmListFilePrefetcher();
+
+  cmListFilePrefetcher(cmListFilePrefetcher const&) = delete;
+  cmListFilePrefetcher& operator=(cmListFilePrefetcher const&) = delete;
+
+  /** Get the number of worker threads worth starting.  Without a spare
+      processor prefetching would only slow the main thread down.  */
+  static unsigned int GetThreadCount();
+
+  /** Get the directory whose files are parsed.  */
+  std::string const& GetDirectory() const { return this->Directory; }
+
+  /** Take the parsed file of the given path.  Waits for a file that is
+      being parsed.  Returns nullptr if the caller must parse the file.  */
+  std::shared_ptr<cmListFile const> Take(std::string const& path);
+
+private:
+  cmState* State;
+  std::string const Directory;
+  std::unique_ptr<cmListFilePrefetcherInternals> Internal;
+};
+
+#endif
@@ -19,6 +19,7 @@
 #include "cmLinkLineComputer.h"
 #include "cmLinkLineDeviceComputer.h"
 #include "cmMakefile.h"
+#include "cmPathCache.h"
 #include "cmRulePlaceholderExpander.h"
 #include "cmSourceFile.h"
 #include "cmSourceFileLocation.h"
@@ -991,6 +992,9 @@ std::vector<BT<std::string>> cmLocalGenerator::GetIncludeDirectoriesImplicit(
     }
   }
 
+  // Real paths of the directories are compared many times per target.
+  cmPathCache* pathCache = this->GetCMakeInstance()->GetPathCache();
+
   // Implicit include directories
   std::vector<std::string> implicitDirs;
   std::set<std::string> implicitSet;
@@ -1036,18 +1040,18 @@ std::vector<BT<std::string>> cmLocalGenerator::GetIncludeDirectoriesImplicit(
     }
 
     for (std::string const& i : impDirVec) {
-      if (implicitSet.insert(cmSystemTools::GetRealPath(i)).second) {
+      if (implicitSet.insert(pathCache->GetRealPath(i)).second) {
         implicitDirs.emplace_back(i);
       }
     }
   }
 
   // Checks if this is not an excluded (implicit) include directory.
-  auto notExcluded = [this, &implicitSet, &implicitExclude,
+  auto notExcluded = [this, pathCache, &implicitSet, &implicitExclude,
                       &lang](std::string const& dir) {
     return (
       // Do not exclude directories that are not in an excluded set.
-      ((!cmContains(implicitSet, cmSystemTools::GetRealPath(dir))) &&
+      ((!cmContains(implicitSet, pathCache->GetRealPath(dir))) &&
        (!cmContains(implicitExclude, dir)))
       // Do not exclude entries of the CPATH environment variable even though
       // they are implicitly searched by the compiler.  They are meant to be
@@ -1100,7 +1104,7 @@ std::vector<BT<std::string>> cmLocalGenerator::GetIncludeDirectoriesImplicit(
   if (!stripImplicitDirs) {
     // Append implicit directories that were requested by the user only
     for (BT<std::string> const& udr : userDirs) {
-      if (cmContains(implicitSet, cmSystemTools::GetRealPath(udr.Value))) {
+      if (cmContains(implicitSet, pathCache->GetRealPath(udr.Value))) {
         emitBT(udr);
       }
     }
@@ -1792,16 +1796,17 @@ bool cmLocalGenerator::GetRealDependency(const std::string& inName,
     // make sure it is not just a coincidence that the target name
     // found is part of the inName
     if (cmSystemTools::FileIsFullPath(inName)) {
+      cmPathCache* pathCache = this->GetCMakeInstance()->GetPathCache();
       std::string tLocation;
       if (target->GetType() >= cmStateEnums::EXECUTABLE &&
           target->GetType() <= cmStateEnums::MODULE_LIBRARY) {
         tLocation = target->GetLocation(config);
         tLocation = cmSystemTools::GetFilenamePath(tLocation);
-        tLocation = cmSystemTools::CollapseFullPath(tLocation);
+        tLocation = pathCache->CollapseFullPath(tLocation);
       }
       std::string depLocation =
         cmSystemTools::GetFilenamePath(std::string(inName));
-      depLocation = cmSystemTools::CollapseFullPath(depLocation);
+      depLocation = pathCache->CollapseFullPath(depLocation);
       if (depLocation != tLocation) {
         // it is a full path to a depend that has the same name
         // as a target but is in a different location so do not use
@@ -3207,7 +3212,11 @@ std::string const& cmLocalGenerator::GetCurrentSourceDirectory() const
 std::string cmLocalGenerator::MaybeConvertToRelativePath(
   std::string const& local_path, std::string const& remote_path) const
 {
-  return this->StateSnapshot.GetDirectory().ConvertToRelPathIfNotContained(
+  if (!this->StateSnapshot.GetDirectory().ContainsBoth(local_path,
+                                                        remote_path)) {
+    return remote_path;
+  }
+  return this->GetCMakeInstance()->GetPathCache()->ForceToRelativePath(
     local_path, remote_path);
 }
 
@@ -40,6 +40,8 @@
 // Include dependency scanners for supported languages.  Only the
 // C/C++ scanner is needed for bootstrapping CMake.
 #include "cmDependsC.h"
+#include "cmDependsCompiler.h"
+#include "cmDependsDatabase.h"
 #ifndef CMAKE_BOOTSTRAP
 #  include "cmDependsFortran.h"
 #  include "cmDependsJava.h"
@@ -1297,7 +1299,10 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
   this->CheckMultipleOutputs(verbose);
 
   std::string const targetDir = cmSystemTools::GetFilenamePath(tgtInfo);
-  std::string const internalDependFile = targetDir + "/depend.internal";
+  bool const useDatabase =
+    this->Makefile->IsOn("CMAKE_DEPENDS_USE_DATABASE");
+  std::string const internalDependFile =
+    targetDir + (useDatabase ? "/depend.db" : "/depend.internal");
   std::string const dependFile = targetDir + "/depend.make";
 
   // If the target DependInfo.cmake file has changed since the last
@@ -1320,6 +1325,19 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
     }
   }
 
+  // Consolidate the depfiles written by the compiler during the previous
+  // build for languages that do not use the dependency scanners.
+  if (const char* depFiles =
+        this->Makefile->GetDefinition("CMAKE_DEPENDS_DEPENDENCY_FILES")) {
+    cmDependsCompiler depsCompiler(this, targetDir);
+    depsCompiler.SetVerbose(verbose);
+    depsCompiler.SetFileTimeCache(ftc);
+    depsCompiler.SetUseDatabase(useDatabase);
+    if (!depsCompiler.Update(cmExpandedList(depFiles))) {
+      return false;
+    }
+  }
+
   // If the directory information is newer than depend.internal, include dirs
   // may have changed. In this case discard all old dependencies.
   bool needRescanDirInfo = false;
@@ -1350,6 +1368,7 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
     cmDependsC checker;
     checker.SetVerbose(verbose);
     checker.SetFileTimeCache(ftc);
+    checker.SetUseDatabase(useDatabase);
     // cmDependsC::Check() fills the vector validDependencies() with the
     // dependencies for those files where they are still valid, i.e. neither
     // the files themselves nor any files they depend on have changed.
@@ -1362,6 +1381,12 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
     // actually scanned again, instead of all files for this target.
     needRescanDependencies =
       !checker.Check(dependFile, internalDependFile, validDependencies);
+
+    // The database checker stores the valid dependencies only when some
+    // of them must be rescanned, but they are needed for new sources too.
+    if (useDatabase && !needRescanDependencies && needRescanDependInfo) {
+      cmDependsDatabase::Load(internalDependFile, validDependencies);
+    }
   }
 
   if (needRescanDependInfo || needRescanDirInfo || needRescanDependencies) {
@@ -1434,15 +1459,38 @@ bool cmLocalUnixMakefileGenerator3::ScanDependencies(
 
   // Open the cmake dependency tracking file.  This should not be
   // copy-if-different because dependencies are re-scanned when it is
-  // older than the DependInfo.cmake.
-  cmGeneratedFileStream internalRuleFileStream(
-    internalDependFile, false, this->GlobalGenerator->GetMakefileEncoding());
-  if (!internalRuleFileStream) {
-    return false;
+  // older than the DependInfo.cmake.  When the dependencies are kept in
+  // a database the scanners collect them in memory and the make depends
+  // file gets rules only for the headers generated by the target: the
+  // objects are removed by the next dependency check instead when one
+  // of their other dependees changes.
+  bool const useDatabase = mf->IsOn("CMAKE_DEPENDS_USE_DATABASE");
+  std::unique_ptr<cmGeneratedFileStream> internalFileStream;
+  std::ostringstream unusedInternalStream;
+  cmDepends::DependencyMap databaseDeps;
+  std::set<std::string> generatedFiles;
+  if (useDatabase) {
+    std::vector<std::string> generated = cmExpandedList(
+      mf->GetSafeDefinition("CMAKE_DEPENDS_GENERATED_FILES"));
+    generatedFiles.insert(generated.begin(), generated.end());
+  } else {
+    internalFileStream = cm::make_unique<cmGeneratedFileStream>(
+      internalDependFile, false, this->GlobalGenerator->GetMakefileEncoding());
+    if (!*internalFileStream) {
+      return false;
+    }
+    this->WriteDisclaimer(*internalFileStream);
   }
+  std::ostream& internalRuleFileStream = useDatabase
+    ? static_cast<std::ostream&>(unusedInternalStream)
+    : *internalFileStream;
 
   this->WriteDisclaimer(ruleFileStream);
-  this->WriteDisclaimer(internalRuleFileStream);
+  if (useDatabase) {
+    ruleFileStream << "# The dependencies are stored in "
+                   << cmSystemTools::GetFilenameName(internalDependFile)
+                   << ".\n";
+  }
 
   // for each language we need to scan, scan it
   std::vector<std::string> langs =
@@ -1472,10 +1520,16 @@ bool cmLocalUnixMakefileGenerator3::ScanDependencies(
         this->GlobalGenerator->GetCMakeInstance()->GetFileTimeCache());
       scanner->SetLanguage(lang);
       scanner->SetTargetDirectory(targetDir);
+      if (useDatabase) {
+        scanner->SetDependencyMap(&databaseDeps, &generatedFiles);
+      }
       scanner->Write(ruleFileStream, internalRuleFileStream);
     }
   }
 
+  if (useDatabase) {
+    return cmDependsDatabase::Save(internalDependFile, databaseDeps);
+  }
   return true;
 }
 
@@ -1732,6 +1786,7 @@ void cmLocalUnixMakefileGenerator3::ClearDependencies(cmMakefile* mf,
     // regeneration.
     std::string internalDependFile = dir + "/depend.internal";
     cmSystemTools::RemoveFile(internalDependFile);
+    cmSystemTools::RemoveFile(dir + "/depend.db");
   }
 }
 
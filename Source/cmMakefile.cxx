@@ -52,6 +52,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #ifndef CMAKE_BOOTSTRAP
+#  include "cmListFilePrefetcher.h"
 #  include "cmVariableWatch.h"
 #endif
 
@@ -343,9 +344,9 @@ public:
                  cmExecutionStatus& status)
     : Makefile(mf)
   {
-    cmListFileContext const& lfc = cmListFileContext::FromCommandContext(
-      cc, this->Makefile->StateSnapshot.GetExecutionListFile());
-    this->Makefile->Backtrace = this->Makefile->Backtrace.Push(lfc);
+    this->Makefile->Backtrace = this->Makefile->Backtrace.Push(
+      this->Makefile->StateSnapshot.GetExecutionListFile(),
+      cc.Name.Original, cc.Line);
     ++this->Makefile->RecursionDepth;
     this->Makefile->ExecutionStatusStack.push_back(&status);
   }
@@ -390,7 +391,8 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
 
   // Check for maximum recursion depth.
   int depth = CMake_DEFAULT_RECURSION_LIMIT;
-  const char* depthStr = this->GetDefinition("CMAKE_MAXIMUM_RECURSION_DEPTH");
+  static std::string const depthVar = "CMAKE_MAXIMUM_RECURSION_DEPTH";
+  const char* depthStr = this->GetDefinition(depthVar);
   if (depthStr) {
     std::istringstream s(depthStr);
     int d;
@@ -417,6 +419,7 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
       }
       // Try invoking the command.
       bool invokeSucceeded = command(lff.Arguments, status);
+      this->TrimCommandArguments();
       bool hadNestedError = status.GetNestedError();
       if (!invokeSucceeded || hadNestedError) {
         if (!hadNestedError) {
@@ -584,13 +587,13 @@ bool cmMakefile::ReadDependentFile(const std::string& filename,
 
   IncludeScope incScope(this, filenametoread, noPolicyScope);
 
-  cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  std::shared_ptr<cmListFile const> listFile = this->GetState()->ParseListFile(
+    filenametoread, this->GetMessenger(), this->Backtrace);
+  if (!listFile) {
     return false;
   }
 
-  this->ReadListFile(listFile, filenametoread);
+  this->ReadListFile(*listFile, filenametoread);
   if (cmSystemTools::GetFatalErrorOccured()) {
     incScope.Quiet();
   }
@@ -638,13 +641,13 @@ bool cmMakefile::ReadListFile(const std::string& filename)
 
   ListFileScope scope(this, filenametoread);
 
-  cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  std::shared_ptr<cmListFile const> listFile = this->GetState()->ParseListFile(
+    filenametoread, this->GetMessenger(), this->Backtrace);
+  if (!listFile) {
     return false;
   }
 
-  this->ReadListFile(listFile, filenametoread);
+  this->ReadListFile(*listFile, filenametoread);
   if (cmSystemTools::GetFatalErrorOccured()) {
     scope.Quiet();
   }
@@ -1604,15 +1607,15 @@ void cmMakefile::Configure()
   assert(cmSystemTools::FileExists(currentStart, true));
   this->AddDefinition("CMAKE_PARENT_LIST_FILE", currentStart);
 
-  cmListFile listFile;
-  if (!listFile.ParseFile(currentStart.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  std::shared_ptr<cmListFile const> listFile = this->GetState()->ParseListFile(
+    currentStart, this->GetMessenger(), this->Backtrace);
+  if (!listFile) {
     return;
   }
   if (this->IsRootMakefile()) {
     bool hasVersion = false;
     // search for the right policy command
-    for (cmListFileFunction const& func : listFile.Functions) {
+    for (cmListFileFunction const& func : listFile->Functions) {
       if (func.Name.Lower == "cmake_minimum_required") {
         hasVersion = true;
         break;
@@ -1622,7 +1625,7 @@ void cmMakefile::Configure()
     // non advanced functions or a lot of functions
     if (!hasVersion) {
       bool isProblem = true;
-      if (listFile.Functions.size() < 30) {
+      if (listFile->Functions.size() < 30) {
         // the list of simple commands DO NOT ADD TO THIS LIST!!!!!
         // these commands must have backwards compatibility forever and
         // and that is a lot longer than your tiny mind can comprehend mortal
@@ -1639,7 +1642,7 @@ void cmMakefile::Configure()
         allowedCommands.insert("option");
         allowedCommands.insert("message");
         isProblem = false;
-        for (cmListFileFunction const& func : listFile.Functions) {
+        for (cmListFileFunction const& func : listFile->Functions) {
           if (!cmContains(allowedCommands, func.Name.Lower)) {
             isProblem = true;
             break;
@@ -1658,7 +1661,7 @@ void cmMakefile::Configure()
     }
     bool hasProject = false;
     // search for a project command
-    for (cmListFileFunction const& func : listFile.Functions) {
+    for (cmListFileFunction const& func : listFile->Functions) {
       if (func.Name.Lower == "project") {
         hasProject = true;
         break;
@@ -1682,11 +1685,14 @@ void cmMakefile::Configure()
                                      0);
       project.Arguments.emplace_back("__CMAKE_INJECTED_PROJECT_COMMAND__",
                                      cmListFileArgument::Unquoted, 0);
-      listFile.Functions.insert(listFile.Functions.begin(), project);
+      // The parsed commands are read-only, so insert into a copy.
+      auto withProject = std::make_shared<cmListFile>(*listFile);
+      withProject->Functions.insert(withProject->Functions.begin(), project);
+      listFile = std::move(withProject);
     }
   }
 
-  this->ReadListFile(listFile, currentStart);
+  this->ReadListFile(*listFile, currentStart);
   if (cmSystemTools::GetFatalErrorOccured()) {
     scope.Quiet();
   }
@@ -1782,6 +1788,16 @@ void cmMakefile::AddSubDirectory(const std::string& srcPath,
   }
 
   if (immediate) {
+#ifndef CMAKE_BOOTSTRAP
+    // Parse the listfiles of the subdirectory while it is configured,
+    // unless an enclosing one already does.
+    std::unique_ptr<cmListFilePrefetcher> prefetcher;
+    cmState* state = this->GetState();
+    if (cmListFilePrefetcher::GetThreadCount() > 0 &&
+        !state->GetListFilePrefetcher(srcPath + "/CMakeLists.txt")) {
+      prefetcher = cm::make_unique<cmListFilePrefetcher>(state, srcPath);
+    }
+#endif
     this->ConfigureSubDirectory(subMf);
   } else {
     this->UnConfiguredDirectories.push_back(subMf);
@@ -3359,41 +3375,85 @@ bool cmMakefile::IsLoopBlock() const
   return !this->LoopBlockCounter.empty() && this->LoopBlockCounter.top() > 0;
 }
 
-std::string cmMakefile::GetExecutionFilePath() const
+std::string const& cmMakefile::GetExecutionFilePath() const
 {
   assert(this->StateSnapshot.IsValid());
   return this->StateSnapshot.GetExecutionListFile();
 }
 
+namespace {
+// Whether expanding the argument can not change its value.
+bool IsLiteralArgument(cmListFileArgument const& arg)
+{
+  return arg.Delim == cmListFileArgument::Bracket ||
+    arg.Value.find_first_of("$@\\") == std::string::npos;
+}
+
+// Get the next element of a buffer whose existing elements are reused.
+std::string& NextArgument(std::vector<std::string>& args, std::size_t& count)
+{
+  if (count == args.size()) {
+    args.emplace_back();
+  }
+  return args[count++];
+}
+}
+
 bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
                                  std::vector<std::string>& outArgs,
                                  const char* filename) const
 {
-  std::string efp = this->GetExecutionFilePath();
+  std::size_t const count = outArgs.size();
+  outArgs.reserve(count + inArgs.size());
+  return this->ExpandArgumentsInto(inArgs, outArgs, count, filename);
+}
+
+bool cmMakefile::ExpandArgumentsInto(
+  std::vector<cmListFileArgument> const& inArgs,
+  std::vector<std::string>& outArgs, std::size_t count,
+  const char* filename) const
+{
   if (!filename) {
-    filename = efp.c_str();
+    filename = this->GetExecutionFilePath().c_str();
   }
   std::string value;
-  outArgs.reserve(inArgs.size());
   for (cmListFileArgument const& i : inArgs) {
-    // No expansion in a bracket argument.
-    if (i.Delim == cmListFileArgument::Bracket) {
-      outArgs.push_back(i.Value);
+    // An argument without variable references or escapes is stored as
+    // is, unless it is an unquoted list or empty.
+    if (IsLiteralArgument(i)) {
+      if (i.Delim != cmListFileArgument::Unquoted ||
+          (!i.Value.empty() && i.Value.find(';') == std::string::npos)) {
+        NextArgument(outArgs, count) = i.Value;
+        continue;
+      }
+      value = i.Value;
+    } else if (i.Delim == cmListFileArgument::Quoted) {
+      // A quoted argument is expanded in place as a single argument.
+      std::string& arg = NextArgument(outArgs, count);
+      arg = i.Value;
+      this->ExpandVariablesInString(arg, false, false, false, filename,
+                                    i.Line, false, false);
       continue;
+    } else {
+      // Expand the variables in the argument.
+      value = i.Value;
+      this->ExpandVariablesInString(value, false, false, false, filename,
+                                    i.Line, false, false);
     }
-    // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename, i.Line,
-                                  false, false);
 
-    // If the argument is quoted, it should be one argument.
-    // Otherwise, it may be a list of arguments.
-    if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.push_back(value);
-    } else {
-      cmExpandList(value, outArgs);
+    // An unquoted argument may be a list of arguments.
+    if (value.find(';') == std::string::npos) {
+      if (!value.empty()) {
+        NextArgument(outArgs, count) = value;
+      }
+      continue;
     }
+    // The list elements are appended after the arguments so far.
+    outArgs.resize(count);
+    cmExpandList(value, outArgs);
+    count = outArgs.size();
   }
+  outArgs.resize(count);
   return !cmSystemTools::GetFatalErrorOccured();
 }
 
@@ -3401,9 +3461,8 @@ bool cmMakefile::ExpandArguments(
   std::vector<cmListFileArgument> const& inArgs,
   std::vector<cmExpandedCommandArgument>& outArgs, const char* filename) const
 {
-  std::string efp = this->GetExecutionFilePath();
   if (!filename) {
-    filename = efp.c_str();
+    filename = this->GetExecutionFilePath().c_str();
   }
   std::string value;
   outArgs.reserve(inArgs.size());
@@ -3415,8 +3474,10 @@ bool cmMakefile::ExpandArguments(
     }
     // Expand the variables in the argument.
     value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename, i.Line,
-                                  false, false);
+    if (!IsLiteralArgument(i)) {
+      this->ExpandVariablesInString(value, false, false, false, filename,
+                                    i.Line, false, false);
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -3432,6 +3493,45 @@ bool cmMakefile::ExpandArguments(
   return !cmSystemTools::GetFatalErrorOccured();
 }
 
+std::vector<std::string> const* cmMakefile::ExpandCommandArguments(
+  std::vector<cmListFileArgument> const& args)
+{
+  // The arguments of a command stay valid while it executes nested
+  // commands because those use the buffer of a deeper call depth.
+  std::size_t const depth = static_cast<std::size_t>(this->RecursionDepth);
+  if (this->CommandArgumentBuffers.size() <= depth) {
+    this->CommandArgumentBuffers.resize(depth + 1);
+  }
+  std::vector<std::string>& buffer = this->CommandArgumentBuffers[depth];
+  if (!this->ExpandArgumentsInto(args, buffer, 0, nullptr)) {
+    return nullptr;
+  }
+  return &buffer;
+}
+
+void cmMakefile::TrimCommandArguments()
+{
+  // Only arguments of common sizes are worth keeping for reuse.  Do not
+  // hold on to the memory of a command with very long arguments or very
+  // many of them.
+  static std::size_t const maxRetainedArguments = 256;
+  static std::size_t const maxRetainedCapacity = 1024;
+  std::size_t const depth = static_cast<std::size_t>(this->RecursionDepth);
+  if (depth >= this->CommandArgumentBuffers.size()) {
+    return;
+  }
+  std::vector<std::string>& buffer = this->CommandArgumentBuffers[depth];
+  if (buffer.capacity() > maxRetainedArguments) {
+    std::vector<std::string>().swap(buffer);
+    return;
+  }
+  for (std::string& arg : buffer) {
+    if (arg.capacity() > maxRetainedCapacity) {
+      std::string().swap(arg);
+    }
+  }
+}
+
 void cmMakefile::AddFunctionBlocker(std::unique_ptr<cmFunctionBlocker> fb)
 {
   if (!this->ExecutionStatusStack.empty()) {
@@ -3481,6 +3581,24 @@ void cmMakefile::SetArgcArgv(const std::vector<std::string>& args)
   }
 }
 
+namespace {
+bool IsFullyKnown(cmSourceFileLocation const& loc)
+{
+  return !loc.DirectoryIsAmbiguous() && !loc.ExtensionIsAmbiguous();
+}
+
+std::string FullPathKey(cmSourceFileLocation const& loc)
+{
+  // Names are compared case-insensitively on these platforms.
+#if defined(_WIN32) || defined(__APPLE__)
+  return cmStrCat(loc.GetDirectory(), '/',
+                  cmSystemTools::LowerCase(loc.GetName()));
+#else
+  return cmStrCat(loc.GetDirectory(), '/', loc.GetName());
+#endif
+}
+}
+
 cmSourceFile* cmMakefile::GetSource(const std::string& sourceName,
                                     cmSourceFileLocationKind kind) const
 {
@@ -3497,10 +3615,26 @@ cmSourceFile* cmMakefile::GetSource(const std::string& sourceName,
 #if defined(_WIN32) || defined(__APPLE__)
   name = cmSystemTools::LowerCase(name);
 #endif
-  auto sfsi = this->SourceFileSearchIndex.find(name);
-  if (sfsi != this->SourceFileSearchIndex.end()) {
+
+  // A location without ambiguity matches a fully known source file
+  // only by full path.  Other source files are searched by name.
+  SourceFileMap const* index = &this->SourceFileSearchIndex;
+  if (IsFullyKnown(sfl)) {
+    auto fpsi = this->FullPathFileSearchIndex.find(FullPathKey(sfl));
+    if (fpsi != this->FullPathFileSearchIndex.end()) {
+      return fpsi->second;
+    }
+    index = &this->AmbiguousFileSearchIndex;
+  }
+
+  auto sfsi = index->find(name);
+  if (sfsi != index->end()) {
     for (auto sf : sfsi->second) {
       if (sf->Matches(sfl)) {
+        // The match may have resolved the ambiguity of the source file.
+        if (IsFullyKnown(sf->GetLocation())) {
+          this->IndexSourceFile(sf, name);
+        }
         return sf;
       }
     }
@@ -3524,6 +3658,11 @@ cmSourceFile* cmMakefile::CreateSource(const std::string& sourceName,
   name = cmSystemTools::LowerCase(name);
 #endif
   this->SourceFileSearchIndex[name].push_back(sf);
+  if (IsFullyKnown(sf->GetLocation())) {
+    this->FullPathFileSearchIndex.emplace(FullPathKey(sf->GetLocation()), sf);
+  } else {
+    this->AmbiguousFileSearchIndex[name].push_back(sf);
+  }
   // for "Known" paths add direct lookup (used for faster lookup in GetSource)
   if (kind == cmSourceFileLocationKind::Known) {
     this->KnownFileSearchIndex[sourceName] = sf;
@@ -3532,6 +3671,19 @@ cmSourceFile* cmMakefile::CreateSource(const std::string& sourceName,
   return sf;
 }
 
+void cmMakefile::IndexSourceFile(cmSourceFile* sf,
+                                 std::string const& name) const
+{
+  // Move a source file whose location is now fully known from the
+  // ambiguous index to the full path index.
+  auto& ambiguous = this->AmbiguousFileSearchIndex[name];
+  auto i = std::find(ambiguous.begin(), ambiguous.end(), sf);
+  if (i != ambiguous.end()) {
+    ambiguous.erase(i);
+    this->FullPathFileSearchIndex.emplace(FullPathKey(sf->GetLocation()), sf);
+  }
+}
+
 cmSourceFile* cmMakefile::GetOrCreateSource(const std::string& sourceName,
                                             bool generated,
                                             cmSourceFileLocationKind kind)
@@ -271,7 +271,8 @@ public:
     bool command_expand_lists = false, const std::string& job_pool = "");
 
   /**
-   * Add a subdirectory to the build.
+   * Add a subdirectory to the build.  With immediate configuration its
+   * listfiles are parsed ahead of time by worker threads.
    */
   void AddSubDirectory(const std::string& fullSrcDir,
                        const std::string& fullBinDir, bool excludeFromAll,
@@ -706,6 +707,15 @@ public:
                        std::vector<cmExpandedCommandArgument>& outArgs,
                        const char* filename = nullptr) const;
 
+  /**
+   * Expand the arguments of the command being executed.  The result is
+   * stored in a buffer reused by later commands at the same call depth,
+   * so arguments that fit in the strings left by an earlier command do
+   * not allocate.  Returns nullptr if there was an error.
+   */
+  std::vector<std::string> const* ExpandCommandArguments(
+    std::vector<cmListFileArgument> const& args);
+
   /**
    * Get the instance
    */
@@ -917,7 +927,7 @@ public:
 
   const char* GetDefineFlagsCMP0059() const;
 
-  std::string GetExecutionFilePath() const;
+  std::string const& GetExecutionFilePath() const;
 
   void EnforceDirectoryLevelRules() const;
 
@@ -976,6 +986,15 @@ protected:
   // For "Known" paths we can store a direct filename to cmSourceFile map
   std::unordered_map<std::string, cmSourceFile*> KnownFileSearchIndex;
 
+  // Source files whose directory and extension are both known can only
+  // match locations with exactly the same full path, so they are also
+  // indexed by their full path.  The remaining source files that might
+  // match such a location are kept by Name portion as above.
+  mutable std::unordered_map<std::string, cmSourceFile*>
+    FullPathFileSearchIndex;
+  mutable SourceFileMap AmbiguousFileSearchIndex;
+  void IndexSourceFile(cmSourceFile* sf, std::string const& name) const;
+
   // Tests
   std::map<std::string, cmTest*> Tests;
 
@@ -1010,6 +1029,18 @@ private:
   cmListFileBacktrace Backtrace;
   int RecursionDepth;
 
+  // Expanded command arguments indexed by call depth.  The elements are
+  // reused so that their strings keep their capacity.
+  std::deque<std::vector<std::string>> CommandArgumentBuffers;
+
+  // Release the memory of the arguments of the command just executed
+  // beyond what is worth keeping for reuse.
+  void TrimCommandArguments();
+
+  bool ExpandArgumentsInto(std::vector<cmListFileArgument> const& inArgs,
+                           std::vector<std::string>& outArgs,
+                           std::size_t count, const char* filename) const;
+
   void ReadListFile(cmListFile const& listFile,
                     const std::string& filenametoread);
 
@@ -272,6 +272,22 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
            this->LocalGenerator->GetBinaryDirectory(), dependFileNameFull))
     << "\n\n";
 
+  // Include the dependencies reported by the compiler.
+  std::string compilerDependFileNameFull;
+  if (this->Makefile->IsOn("CMAKE_DEPENDS_USE_COMPILER")) {
+    compilerDependFileNameFull =
+      cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.make");
+    *this->BuildFileStream
+      << "# Include any dependencies generated by the compiler for this "
+         "target.\n"
+      << this->GlobalGenerator->IncludeDirective << " " << root
+      << cmSystemTools::ConvertToOutputPath(
+           this->LocalGenerator->MaybeConvertToRelativePath(
+             this->LocalGenerator->GetBinaryDirectory(),
+             compilerDependFileNameFull))
+      << "\n\n";
+  }
+
   if (!this->NoRuleMessages) {
     // Include the progress variables for the target.
     *this->BuildFileStream
@@ -294,6 +310,16 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
                   << "# This may be replaced when dependencies are built."
                   << std::endl;
   }
+  if (!compilerDependFileNameFull.empty() &&
+      !cmSystemTools::FileExists(compilerDependFileNameFull)) {
+    cmGeneratedFileStream depFileStream(
+      compilerDependFileNameFull, false,
+      this->GlobalGenerator->GetMakefileEncoding());
+    depFileStream << "# Empty compiler generated dependencies file for "
+                  << this->GeneratorTarget->GetName() << ".\n"
+                  << "# This may be replaced when dependencies are built."
+                  << std::endl;
+  }
 
   // Open the flags file.  This should be copy-if-different because the
   // rules may depend on this file itself.
@@ -446,10 +472,31 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   std::string objFullPath =
     cmStrCat(this->LocalGenerator->GetCurrentBinaryDirectory(), '/', obj);
   objFullPath = cmSystemTools::CollapseFullPath(objFullPath);
-  std::string srcFullPath =
-    cmSystemTools::CollapseFullPath(source.GetFullPath());
-  this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
-                                           objFullPath, srcFullPath);
+  if (this->UseCompilerDepfile(lang)) {
+    // The compiler writes the dependencies while building the object.
+    this->CompilerDepfiles[objFullPath] = cmStrCat(objFullPath, ".d");
+  } else {
+    std::string srcFullPath =
+      cmSystemTools::CollapseFullPath(source.GetFullPath());
+    this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
+                                             objFullPath, srcFullPath);
+  }
+}
+
+bool cmMakefileTargetGenerator::UseCompilerDepfile(
+  const std::string& lang) const
+{
+  // Only GCC-compatible depfiles can be consolidated.  Fortran sources
+  // still need the scanner to order module producers before consumers.
+  if (!this->Makefile->IsOn("CMAKE_DEPENDS_USE_COMPILER") ||
+      (lang != "C" && lang != "CXX" && lang != "CUDA") ||
+      this->Makefile->GetSafeDefinition("CMAKE_DEPFILE_FLAGS_" + lang)
+        .empty()) {
+    return false;
+  }
+  std::string const& deptype =
+    this->Makefile->GetSafeDefinition("CMAKE_NINJA_DEPTYPE_" + lang);
+  return deptype.empty() || deptype == "gcc";
 }
 
 void cmMakefileTargetGenerator::WriteObjectBuildFile(
@@ -705,7 +752,8 @@ void cmMakefileTargetGenerator::WriteObjectBuildFile(
       }
 
       this->GlobalGenerator->AddCXXCompileCommand(
-        source.GetFullPath(), workingDirectory, compileCommand);
+        this->GeneratorTarget, source.GetFullPath(), workingDirectory,
+        compileCommand);
     }
 
     // See if we need to use a compiler launcher like ccache or distcc
@@ -790,12 +838,33 @@ void cmMakefileTargetGenerator::WriteObjectBuildFile(
       }
     }
 
+    // Ask the compiler to write the dependencies of the object.  The
+    // flags are not needed for the preprocessor and assembly rules.
+    std::string compileFlags = flags;
+    if (this->UseCompilerDepfile(lang)) {
+      std::string depfileFlags =
+        this->Makefile->GetSafeDefinition("CMAKE_DEPFILE_FLAGS_" + lang);
+      std::string const depFile = cmStrCat(obj, ".d");
+      cmSystemTools::ReplaceString(
+        depfileFlags, "<DEPFILE>",
+        this->LocalGenerator->ConvertToOutputFormat(
+          depFile, cmOutputConverter::SHELL));
+      cmSystemTools::ReplaceString(depfileFlags, "<OBJECT>", shellObj);
+      cmSystemTools::ReplaceString(
+        depfileFlags, "<CMAKE_C_COMPILER>",
+        this->Makefile->GetSafeDefinition("CMAKE_C_COMPILER"));
+      this->LocalGenerator->AppendFlags(compileFlags, depfileFlags);
+      this->CleanFiles.insert(depFile);
+    }
+    vars.Flags = compileFlags.c_str();
+
     // Expand placeholders in the commands.
     for (std::string& compileCommand : compileCommands) {
       compileCommand = cmStrCat(launcher, compileCommand);
       rulePlaceholderExpander->ExpandRuleVariables(this->LocalGenerator,
                                                    compileCommand, vars);
     }
+    vars.Flags = flags.c_str();
 
     // Change the command working directory to the local build tree.
     this->LocalGenerator->CreateCDCommand(
@@ -1038,6 +1107,50 @@ void cmMakefileTargetGenerator::WriteTargetDependRules()
     *this->InfoFileStream << "  )\n\n";
   }
 
+  // Keep the implicit dependencies in a binary database.
+  if (this->Makefile->IsOn("CMAKE_DEPENDS_USE_DATABASE")) {
+    /* clang-format off */
+    *this->InfoFileStream
+      << "\n"
+      << "# Store implicit dependencies in a database instead of\n"
+      << "# depend.make and depend.internal.\n"
+      << "set(CMAKE_DEPENDS_USE_DATABASE 1)\n";
+    /* clang-format on */
+
+    // The make rules still have to name the files generated by this
+    // target so that they are brought up to date before the objects.
+    if (!this->CustomCommandOutputs.empty()) {
+      /* clang-format off */
+      *this->InfoFileStream
+        << "\n"
+        << "# Files generated by the custom commands of this target.\n"
+        << "set(CMAKE_DEPENDS_GENERATED_FILES\n";
+      /* clang-format on */
+      for (std::string const& output : this->CustomCommandOutputs) {
+        *this->InfoFileStream
+          << "  " << cmOutputConverter::EscapeForCMake(output) << "\n";
+      }
+      *this->InfoFileStream << "  )\n";
+    }
+  }
+
+  // Store depfiles written by the compiler for its objects.
+  if (!this->CompilerDepfiles.empty()) {
+    /* clang-format off */
+    *this->InfoFileStream
+      << "\n"
+      << "# Pairs of object files and the dependency files written for them\n"
+      << "# by the compiler.\n"
+      << "set(CMAKE_DEPENDS_DEPENDENCY_FILES\n";
+    /* clang-format on */
+    for (auto const& od : this->CompilerDepfiles) {
+      *this->InfoFileStream
+        << "  " << cmOutputConverter::EscapeForCMake(od.first) << " "
+        << cmOutputConverter::EscapeForCMake(od.second) << "\n";
+    }
+    *this->InfoFileStream << "  )\n";
+  }
+
   // Store list of targets linked directly or transitively.
   {
     /* clang-format off */
@@ -1197,6 +1310,9 @@ void cmMakefileTargetGenerator::GenerateCustomRuleFile(
 
   // Write the rule.
   const std::vector<std::string>& outputs = ccg.GetOutputs();
+  this->CustomCommandOutputs.insert(outputs.begin(), outputs.end());
+  this->CustomCommandOutputs.insert(ccg.GetByproducts().begin(),
+                                    ccg.GetByproducts().end());
   bool symbolic = this->WriteMakeRule(*this->BuildFileStream, nullptr, outputs,
                                       depends, commands);
 
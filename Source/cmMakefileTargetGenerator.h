@@ -100,6 +100,9 @@ protected:
   void WriteObjectDependRules(cmSourceFile const& source,
                               std::vector<std::string>& depends);
 
+  // whether the compiler writes the dependencies of objects of a language
+  bool UseCompilerDepfile(const std::string& lang) const;
+
   // write the build rule for a custom command
   void GenerateCustomRuleFile(cmCustomCommandGenerator const& ccg);
 
@@ -225,6 +228,12 @@ protected:
 
   using MultipleOutputPairsType = std::map<std::string, std::string>;
   MultipleOutputPairsType MultipleOutputPairs;
+
+  // Outputs and byproducts of the custom commands of this target.
+  std::set<std::string> CustomCommandOutputs;
+
+  // Map from object file full path to the depfile written by the compiler.
+  std::map<std::string, std::string> CompilerDepfiles;
   bool WriteMakeRule(std::ostream& os, const char* comment,
                      const std::vector<std::string>& outputs,
                      const std::vector<std::string>& depends,
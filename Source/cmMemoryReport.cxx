@@ -0,0 +1,149 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmMemoryReport.h"
+
+#include <memory>
+#include <utility>
+
+#include "cmGeneratorExpression.h"
+#include "cmGeneratorTarget.h"
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmSourceFile.h"
+#include "cmState.h"
+#include "cmTarget.h"
+#include "cmake.h"
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cm_jsoncpp_value.h"
+#  include "cm_jsoncpp_writer.h"
+
+#  include "cmGeneratedFileStream.h"
+#endif
+
+void cmMemoryReport::Sample(std::string const& phase, cmake const& cm)
+{
+  this->Samples.emplace_back();
+  this->Samples.back().Phase = phase;
+
+  cm.GetState()->ReportMemory(*this);
+
+  cmGlobalGenerator const* gg = cm.GetGlobalGenerator();
+  if (!gg) {
+    return;
+  }
+  for (cmMakefile const* mf : gg->GetMakefiles()) {
+    for (auto const& t : mf->GetTargets()) {
+      t.second.ReportMemory(*this);
+    }
+    for (cmSourceFile const* sf : mf->GetSourceFiles()) {
+      sf->ReportMemory(*this);
+    }
+  }
+  for (cmLocalGenerator const* lg : gg->GetLocalGenerators()) {
+    for (cmGeneratorTarget const* gt : lg->GetGeneratorTargets()) {
+      gt->ReportMemory(*this);
+    }
+  }
+  cmGeneratorExpression::ReportMemory(*this);
+}
+
+void cmMemoryReport::Add(std::string const& subsystem, std::string const& type,
+                         std::size_t count, std::size_t bytes)
+{
+  cmMemoryFootprint& f = this->Samples.back().Subsystems[subsystem][type];
+  f.Count += count;
+  f.Bytes += bytes;
+}
+
+bool cmMemoryReport::Write(std::string const& file) const
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  Json::Value samples = Json::arrayValue;
+  for (SampleType const& sample : this->Samples) {
+    Json::Value subsystems = Json::objectValue;
+    Json::UInt64 sampleBytes = 0;
+    for (auto const& s : sample.Subsystems) {
+      Json::Value types = Json::objectValue;
+      Json::UInt64 subsystemBytes = 0;
+      for (auto const& t : s.second) {
+        Json::Value& type = types[t.first];
+        type["count"] = Json::UInt64(t.second.Count);
+        type["bytes"] = Json::UInt64(t.second.Bytes);
+        subsystemBytes += t.second.Bytes;
+      }
+      Json::Value& subsystem = subsystems[s.first];
+      subsystem["bytes"] = subsystemBytes;
+      subsystem["types"] = std::move(types);
+      sampleBytes += subsystemBytes;
+    }
+    Json::Value value = Json::objectValue;
+    value["phase"] = sample.Phase;
+    value["bytes"] = sampleBytes;
+    value["subsystems"] = std::move(subsystems);
+    samples.append(std::move(value));
+  }
+
+  Json::Value root = Json::objectValue;
+  root["version"] = 1;
+  root["samples"] = std::move(samples);
+
+  cmGeneratedFileStream fout(file);
+  Json::StreamWriterBuilder wbuilder;
+  wbuilder["indentation"] = "  ";
+  std::unique_ptr<Json::StreamWriter> jsonWriter(wbuilder.newStreamWriter());
+  jsonWriter->write(root, &fout);
+  fout << '\n';
+  return fout.Close();
+#else
+  static_cast<void>(file);
+  return false;
+#endif
+}
+
+std::size_t cmMemoryReport::Bytes(std::string const& s)
+{
+  // Short strings are stored inside the object itself.
+  char const* data = s.data();
+  char const* self = reinterpret_cast<char const*>(&s);
+  if (data >= self && data < self + sizeof(s)) {
+    return 0;
+  }
+  return s.capacity() + 1;
+}
+
+std::size_t cmMemoryReport::Bytes(std::vector<std::string> const& v)
+{
+  std::size_t bytes = v.capacity() * sizeof(std::string);
+  for (std::string const& s : v) {
+    bytes += Bytes(s);
+  }
+  return bytes;
+}
+
+std::size_t cmMemoryReport::Bytes(std::set<std::string> const& s)
+{
+  std::size_t bytes = s.size() * (sizeof(std::string) + TreeNodeOverhead);
+  for (std::string const& i : s) {
+    bytes += Bytes(i);
+  }
+  return bytes;
+}
+
+cmMemoryFootprint cmMemoryReport::Measure(
+  std::vector<cmListFileFunction> const& functions)
+{
+  cmMemoryFootprint f;
+  f.Count = functions.size();
+  f.Bytes = Bytes(functions);
+  for (cmListFileFunction const& func : functions) {
+    f.Bytes += Bytes(func.Name.Original) + Bytes(func.Name.Lower) +
+      Bytes(func.Arguments);
+    for (cmListFileArgument const& arg : func.Arguments) {
+      f.Bytes += Bytes(arg.Value);
+    }
+  }
+  return f;
+}
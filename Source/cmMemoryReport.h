@@ -0,0 +1,128 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmMemoryReport_h
+#define cmMemoryReport_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class cmake;
+struct cmListFileArgument;
+struct cmListFileFunction;
+
+/** Number of objects of some type and the heap bytes they hold.  */
+struct cmMemoryFootprint
+{
+  std::size_t Count = 0;
+  std::size_t Bytes = 0;
+
+  cmMemoryFootprint& operator+=(cmMemoryFootprint const& r)
+  {
+    this->Count += r.Count;
+    this->Bytes += r.Bytes;
+    return *this;
+  }
+};
+
+/** \class cmMemoryReport
+ * \brief Account for the memory held by the main data structures.
+ *
+ * A sample walks the live state of a cmake instance and adds up the
+ * objects of each subsystem by type.  The byte counts are estimates
+ * computed from object sizes, container capacities and the usual
+ * node overhead of the standard containers.  They do not include
+ * allocator overhead or memory not reachable from the walked state.
+ */
+class cmMemoryReport
+{
+public:
+  /** Take a sample named after the step that just finished.  */
+  void Sample(std::string const& phase, cmake const& cm);
+
+  /** Add objects of a type owned by a subsystem to the current sample.  */
+  void Add(std::string const& subsystem, std::string const& type,
+           std::size_t count, std::size_t bytes);
+  void Add(std::string const& subsystem, std::string const& type,
+           cmMemoryFootprint const& footprint)
+  {
+    this->Add(subsystem, type, footprint.Count, footprint.Bytes);
+  }
+
+  /** Write all samples taken so far as JSON.  */
+  bool Write(std::string const& file) const;
+
+  // -- Size estimates of common members
+
+  /** Heap bytes held by a string beyond its own size.  */
+  static std::size_t Bytes(std::string const& s);
+
+  template <typename T>
+  static std::size_t Bytes(std::vector<T> const& v)
+  {
+    return v.capacity() * sizeof(T);
+  }
+
+  static std::size_t Bytes(std::vector<std::string> const& v);
+  static std::size_t Bytes(std::set<std::string> const& s);
+
+  template <typename K, typename V, typename C>
+  static std::size_t Bytes(std::map<K, V, C> const& m)
+  {
+    return m.size() * (sizeof(typename std::map<K, V, C>::value_type) +
+                       TreeNodeOverhead);
+  }
+
+  template <typename T, typename C>
+  static std::size_t Bytes(std::set<T, C> const& s)
+  {
+    return s.size() * (sizeof(T) + TreeNodeOverhead);
+  }
+
+  template <typename K, typename V, typename H>
+  static std::size_t Bytes(std::unordered_map<K, V, H> const& m)
+  {
+    return m.size() *
+      (sizeof(typename std::unordered_map<K, V, H>::value_type) +
+       HashNodeOverhead) +
+      m.bucket_count() * sizeof(void*);
+  }
+
+  /** Heap bytes held by string keys and values of a map.  */
+  template <typename Map>
+  static std::size_t StringMapBytes(Map const& m)
+  {
+    std::size_t bytes = Bytes(m);
+    for (auto const& i : m) {
+      bytes += Bytes(i.first) + Bytes(i.second);
+    }
+    return bytes;
+  }
+
+  /** Footprint of the commands of a listfile or function body.  */
+  static cmMemoryFootprint Measure(
+    std::vector<cmListFileFunction> const& functions);
+
+private:
+  // Parent, children and color of a red-black tree node.
+  static std::size_t const TreeNodeOverhead = 4 * sizeof(void*);
+  // Next pointer and cached hash of a hash table node.
+  static std::size_t const HashNodeOverhead = 2 * sizeof(void*);
+
+  using TypeMap = std::map<std::string, cmMemoryFootprint>;
+  using SubsystemMap = std::map<std::string, TypeMap>;
+
+  struct SampleType
+  {
+    std::string Phase;
+    SubsystemMap Subsystems;
+  };
+  std::vector<SampleType> Samples;
+};
+
+#endif
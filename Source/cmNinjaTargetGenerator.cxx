@@ -1308,7 +1308,8 @@ void cmNinjaTargetGenerator::ExportObjectCompileCommand(
   std::string cmdLine =
     this->GetLocalGenerator()->BuildCommandLine(compileCmds);
 
-  this->GetGlobalGenerator()->AddCXXCompileCommand(cmdLine, sourceFileName);
+  this->GetGlobalGenerator()->AddCXXCompileCommand(
+    this->GeneratorTarget, cmdLine, sourceFileName);
 }
 
 void cmNinjaTargetGenerator::AdditionalCleanFiles()
@@ -61,11 +61,10 @@ public:
 
   void FindConflicts(unsigned int index)
   {
-    for (unsigned int i = 0; i < this->OD->OriginalDirectories.size(); ++i) {
+    for (int i : this->GetConflictingDirectories()) {
       // Check if this directory conflicts with the entry.
       std::string const& dir = this->OD->OriginalDirectories[i];
-      if (!this->OD->IsSameDirectory(dir, this->Directory) &&
-          this->FindConflict(dir)) {
+      if (!this->OD->IsSameDirectory(dir, this->Directory)) {
         // The library will be found in this directory but this is not
         // the directory named for it.  Add an entry to make sure the
         // desired directory comes before this one.
@@ -78,12 +77,12 @@ public:
   void FindImplicitConflicts(std::ostringstream& w)
   {
     bool first = true;
-    for (std::string const& dir : this->OD->OriginalDirectories) {
+    for (int i : this->GetConflictingDirectories()) {
       // Check if this directory conflicts with the entry.
+      std::string const& dir = this->OD->OriginalDirectories[i];
       if (dir != this->Directory &&
           cmSystemTools::GetRealPath(dir) !=
-            cmSystemTools::GetRealPath(this->Directory) &&
-          this->FindConflict(dir)) {
+            cmSystemTools::GetRealPath(this->Directory)) {
         // The library will be found in this directory but it is
         // supposed to be found in an implicit search directory.
         if (first) {
@@ -98,9 +97,11 @@ public:
   }
 
 protected:
-  virtual bool FindConflict(std::string const& dir) = 0;
+  // Append the indices of original directories in which the item may
+  // be found.  Duplicates are allowed.
+  virtual void FindConflictingDirectories(std::vector<int>& dirs) = 0;
 
-  bool FileMayConflict(std::string const& dir, std::string const& name);
+  void FindFileConflicts(std::string const& name, std::vector<int>& dirs);
 
   cmOrderDirectories* OD;
   cmGlobalGenerator* GlobalGenerator;
@@ -112,24 +113,41 @@ protected:
 
   // The index assigned to the directory.
   int DirectoryIndex;
+
+private:
+  std::vector<int> GetConflictingDirectories()
+  {
+    // Report the directories in their original order.
+    std::vector<int> dirs;
+    this->FindConflictingDirectories(dirs);
+    std::sort(dirs.begin(), dirs.end());
+    dirs.erase(std::unique(dirs.begin(), dirs.end()), dirs.end());
+    return dirs;
+  }
 };
 
-bool cmOrderDirectoriesConstraint::FileMayConflict(std::string const& dir,
-                                                   std::string const& name)
+void cmOrderDirectoriesConstraint::FindFileConflicts(std::string const& name,
+                                                     std::vector<int>& dirs)
 {
-  // Check if the file exists on disk.
-  std::string file = cmStrCat(dir, '/', name);
-  if (cmSystemTools::FileExists(file, true)) {
-    // The file conflicts only if it is not the same as the original
-    // file due to a symlink or hardlink.
-    return !cmSystemTools::SameFile(this->FullPath, file);
-  }
-
-  // Check if the file will be built by cmake.
-  std::set<std::string> const& files =
-    (this->GlobalGenerator->GetDirectoryContent(dir, false));
-  auto fi = files.find(name);
-  return fi != files.end();
+  // The directory content index lists files on disk and files that
+  // will be built by cmake.  Look up only the directories holding
+  // the name instead of checking each directory for it.
+  for (std::string const& dir :
+       this->GlobalGenerator->GetDirectoriesContaining(name)) {
+    auto i = this->OD->DirectoryIndex.find(dir);
+    if (i == this->OD->DirectoryIndex.end()) {
+      continue;
+    }
+
+    // A file on disk conflicts only if it is not the same as the
+    // original file due to a symlink or hardlink.
+    std::string file = cmStrCat(dir, '/', name);
+    if (cmSystemTools::FileExists(file, true) &&
+        cmSystemTools::SameFile(this->FullPath, file)) {
+      continue;
+    }
+    dirs.push_back(i->second);
+  }
 }
 
 class cmOrderDirectoriesConstraintSOName : public cmOrderDirectoriesConstraint
@@ -161,39 +179,38 @@ public:
     e << "]";
   }
 
-  bool FindConflict(std::string const& dir) override;
+  void FindConflictingDirectories(std::vector<int>& dirs) override;
 
 private:
   // The soname of the shared library if it is known.
   std::string SOName;
 };
 
-bool cmOrderDirectoriesConstraintSOName::FindConflict(std::string const& dir)
+void cmOrderDirectoriesConstraintSOName::FindConflictingDirectories(
+  std::vector<int>& dirs)
 {
   // Determine which type of check to do.
   if (!this->SOName.empty()) {
-    // We have the library soname.  Check if it will be found.
-    if (this->FileMayConflict(dir, this->SOName)) {
-      return true;
-    }
-  } else {
-    // We do not have the soname.  Look for files in the directory
-    // that may conflict.
+    // We have the library soname.  Check where it will be found.
+    this->FindFileConflicts(this->SOName, dirs);
+    return;
+  }
+
+  // We do not have the soname.  Look for files in each directory
+  // that may conflict.  Since we do not know the soname just look at
+  // all files that start with the file name.  Usually the soname
+  // starts with the library name.
+  std::string const& first = this->FileName;
+  std::string last = this->FileName;
+  ++last.back();
+  for (unsigned int i = 0; i < this->OD->OriginalDirectories.size(); ++i) {
     std::set<std::string> const& files =
-      (this->GlobalGenerator->GetDirectoryContent(dir, true));
-
-    // Get the set of files that might conflict.  Since we do not
-    // know the soname just look at all files that start with the
-    // file name.  Usually the soname starts with the library name.
-    std::string base = this->FileName;
-    auto first = files.lower_bound(base);
-    ++base.back();
-    auto last = files.upper_bound(base);
-    if (first != last) {
-      return true;
+      this->GlobalGenerator->GetDirectoryContent(
+        this->OD->OriginalDirectories[i], true);
+    if (files.lower_bound(first) != files.upper_bound(last)) {
+      dirs.push_back(static_cast<int>(i));
     }
   }
-  return false;
 }
 
 class cmOrderDirectoriesConstraintLibrary : public cmOrderDirectoriesConstraint
@@ -210,15 +227,14 @@ public:
     e << "link library [" << this->FileName << "]";
   }
 
-  bool FindConflict(std::string const& dir) override;
+  void FindConflictingDirectories(std::vector<int>& dirs) override;
 };
 
-bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
+void cmOrderDirectoriesConstraintLibrary::FindConflictingDirectories(
+  std::vector<int>& dirs)
 {
-  // We have the library file name.  Check if it will be found.
-  if (this->FileMayConflict(dir, this->FileName)) {
-    return true;
-  }
+  // We have the library file name.  Check where it will be found.
+  this->FindFileConflicts(this->FileName, dirs);
 
   // Now check if the file exists with other extensions the linker
   // might consider.
@@ -228,14 +244,10 @@ bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
     std::string ext = this->OD->RemoveLibraryExtension.match(2);
     for (std::string const& LinkExtension : this->OD->LinkExtensions) {
       if (LinkExtension != ext) {
-        std::string fname = cmStrCat(lib, LinkExtension);
-        if (this->FileMayConflict(dir, fname)) {
-          return true;
-        }
+        this->FindFileConflicts(cmStrCat(lib, LinkExtension), dirs);
       }
     }
   }
-  return false;
 }
 
 cmOrderDirectories::cmOrderDirectories(cmGlobalGenerator* gg,
@@ -429,6 +441,13 @@ void cmOrderDirectories::FindConflicts()
   this->ConflictGraph.resize(this->OriginalDirectories.size());
   this->DirectoryVisited.resize(this->OriginalDirectories.size(), 0);
 
+  // Load the content of every directory once.  Conflicts are then
+  // found through the index of directory content kept by the global
+  // generator instead of checking each directory for each entry.
+  for (std::string const& dir : this->OriginalDirectories) {
+    this->GlobalGenerator->GetDirectoryContent(dir, true);
+  }
+
   // Find directories conflicting with each entry.
   for (unsigned int i = 0; i < this->ConstraintEntries.size(); ++i) {
     this->ConstraintEntries[i]->FindConflicts(i);
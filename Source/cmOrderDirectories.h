@@ -91,6 +91,7 @@ private:
 
   friend class cmOrderDirectoriesConstraint;
   friend class cmOrderDirectoriesConstraintLibrary;
+  friend class cmOrderDirectoriesConstraintSOName;
 };
 
 #endif
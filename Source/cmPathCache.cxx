@@ -0,0 +1,103 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmPathCache.h"
+
+#include <ostream>
+#include <utility>
+
+#include "cmSystemTools.h"
+
+cmPathCache::cmPathCache() = default;
+
+cmPathCache::~cmPathCache() = default;
+
+cmPathCache::Id cmPathCache::Intern(std::string const& path)
+{
+  auto i = this->Ids.find(path);
+  if (i == this->Ids.end()) {
+    i = this->Ids.emplace(path, static_cast<Id>(this->Paths.size())).first;
+    // Keys of the node-based map do not move.
+    this->Paths.push_back(&i->first);
+  }
+  return i->second;
+}
+
+template <typename F>
+std::string const& cmPathCache::Memoize(Table& table,
+                                        std::string const& first,
+                                        std::string const& second,
+                                        F compute)
+{
+  ++table.Lookups;
+  std::uint64_t const key =
+    (static_cast<std::uint64_t>(this->Intern(first)) << 32) |
+    this->Intern(second);
+  auto i = table.Results.find(key);
+  if (i != table.Results.end()) {
+    ++table.Hits;
+    return *this->Paths[i->second];
+  }
+  bool store = true;
+  Id const result = this->Intern(compute(store));
+  if (store) {
+    table.Results.emplace(key, result);
+  }
+  return *this->Paths[result];
+}
+
+std::string const& cmPathCache::CollapseFullPath(std::string const& path)
+{
+  return this->CollapseFullPath(path, std::string());
+}
+
+std::string const& cmPathCache::CollapseFullPath(std::string const& path,
+                                                 std::string const& base)
+{
+  return this->Memoize(this->Collapse, path, base, [&](bool& store) {
+    store = !base.empty() || cmSystemTools::FileIsFullPath(path);
+    return cmSystemTools::CollapseFullPath(path, base);
+  });
+}
+
+std::string const& cmPathCache::ForceToRelativePath(
+  std::string const& local_path, std::string const& remote_path)
+{
+  return this->Memoize(this->Relative, local_path, remote_path,
+                       [&](bool& /*store*/) {
+                         return cmSystemTools::ForceToRelativePath(
+                           local_path, remote_path);
+                       });
+}
+
+std::string const& cmPathCache::GetRealPath(std::string const& path)
+{
+  return this->Memoize(this->RealPath, path, path, [&](bool& store) {
+    std::string error;
+    std::string real = cmSystemTools::GetRealPath(path, &error);
+    store = error.empty();
+    return real;
+  });
+}
+
+void cmPathCache::Clear()
+{
+  this->Collapse = Table();
+  this->Relative = Table();
+  this->RealPath = Table();
+  this->Paths.clear();
+  this->Ids.clear();
+}
+
+void cmPathCache::PrintStatistics(std::ostream& os) const
+{
+  auto print = [&os](const char* name, Table const& table) {
+    unsigned long const percent =
+      table.Lookups ? (table.Hits * 100 / table.Lookups) : 0;
+    os << "Path cache " << name << ": " << table.Lookups << " lookups, "
+       << table.Hits << " hits (" << percent << "%)\n";
+  };
+  print("collapse", this->Collapse);
+  print("relative", this->Relative);
+  print("realpath", this->RealPath);
+  os << "Path cache entries: " << this->Paths.size() << "\n";
+}
@@ -0,0 +1,75 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmPathCache_h
+#define cmPathCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** \class cmPathCache
+ * \brief Memoizes path computations repeated with the same inputs.
+ *
+ * Paths are interned in a table and the results of collapsing,
+ * relative path and real path computations are stored by the ids of
+ * their inputs.  The returned references stay valid until Clear is
+ * called.  The cache is not thread-safe.
+ */
+class cmPathCache
+{
+public:
+  cmPathCache();
+  ~cmPathCache();
+
+  cmPathCache(const cmPathCache&) = delete;
+  cmPathCache& operator=(const cmPathCache&) = delete;
+
+  /** Memoized cmSystemTools::CollapseFullPath.  Relative paths without
+      a base directory depend on the working directory and are not
+      memoized.  */
+  std::string const& CollapseFullPath(std::string const& path);
+  std::string const& CollapseFullPath(std::string const& path,
+                                      std::string const& base);
+
+  /** Memoized cmSystemTools::ForceToRelativePath.  */
+  std::string const& ForceToRelativePath(std::string const& local_path,
+                                         std::string const& remote_path);
+
+  /** Memoized cmSystemTools::GetRealPath.  Paths that cannot be
+      resolved are not memoized because they may be created later.  */
+  std::string const& GetRealPath(std::string const& path);
+
+  /** Drop all entries and statistics.  */
+  void Clear();
+
+  /** Print the number of lookups and the hit rate of each table.  */
+  void PrintStatistics(std::ostream& os) const;
+
+private:
+  using Id = std::uint32_t;
+
+  struct Table
+  {
+    std::unordered_map<std::uint64_t, Id> Results;
+    unsigned long Lookups = 0;
+    unsigned long Hits = 0;
+  };
+
+  Id Intern(std::string const& path);
+
+  template <typename F>
+  std::string const& Memoize(Table& table, std::string const& first,
+                             std::string const& second, F compute);
+
+  std::unordered_map<std::string, Id> Ids;
+  std::vector<std::string const*> Paths;
+  Table Collapse;
+  Table Relative;
+  Table RealPath;
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <utility>
 
+#include "cmMemoryReport.h"
+
 void cmPropertyMap::Clear()
 {
   Map_.clear();
@@ -78,3 +80,11 @@ std::vector<std::pair<std::string, std::string>> cmPropertyMap::GetList() const
             });
   return kvList;
 }
+
+cmMemoryFootprint cmPropertyMap::GetFootprint() const
+{
+  cmMemoryFootprint f;
+  f.Count = this->Map_.size();
+  f.Bytes = cmMemoryReport::StringMapBytes(this->Map_);
+  return f;
+}
@@ -10,6 +10,8 @@
 #include <utility>
 #include <vector>
 
+struct cmMemoryFootprint;
+
 /** \class cmPropertyMap
  * \brief String property map.
  */
@@ -44,6 +46,11 @@ public:
   //! Get a sorted by key list of property key,value pairs
   std::vector<std::pair<std::string, std::string>> GetList() const;
 
+  // -- Memory
+
+  //! Get the number of properties and the heap bytes they hold
+  cmMemoryFootprint GetFootprint() const;
+
 private:
   std::unordered_map<std::string, std::string> Map_;
 };
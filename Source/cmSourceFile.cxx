@@ -8,6 +8,7 @@
 #include "cmGlobalGenerator.h"
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
+#include "cmMemoryReport.h"
 #include "cmMessageType.h"
 #include "cmProperty.h"
 #include "cmState.h"
@@ -94,6 +95,33 @@ cmSourceFileLocation const& cmSourceFile::GetLocation() const
   return this->Location;
 }
 
+void cmSourceFile::ReportMemory(cmMemoryReport& report) const
+{
+  static std::string const sources = "sources";
+
+  std::size_t bytes = sizeof(cmSourceFile) +
+    cmMemoryReport::Bytes(this->Location.GetDirectory()) +
+    cmMemoryReport::Bytes(this->Location.GetName()) +
+    cmMemoryReport::Bytes(this->Extension) +
+    cmMemoryReport::Bytes(this->Language) +
+    cmMemoryReport::Bytes(this->FullPath) +
+    cmMemoryReport::Bytes(this->ObjectLibrary) +
+    cmMemoryReport::Bytes(this->Depends);
+  for (auto const* entries : { &this->CompileOptions,
+                               &this->CompileDefinitions,
+                               &this->IncludeDirectories }) {
+    bytes += cmMemoryReport::Bytes(*entries);
+    for (BT<std::string> const& e : *entries) {
+      bytes += cmMemoryReport::Bytes(e.Value);
+    }
+  }
+  report.Add(sources, "source-files", 1, bytes);
+  report.Add(sources, "properties", this->Properties.GetFootprint());
+  if (this->CustomCommand) {
+    report.Add(sources, "custom-commands", 1, sizeof(cmCustomCommand));
+  }
+}
+
 std::string const& cmSourceFile::ResolveFullPath(std::string* error)
 {
   if (this->FullPath.empty()) {
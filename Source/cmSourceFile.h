@@ -16,6 +16,7 @@
 #include <vector>
 
 class cmMakefile;
+class cmMemoryReport;
 
 /** \class cmSourceFile
  * \brief Represent a class loaded from a makefile.
@@ -92,6 +93,11 @@ public:
    */
   cmSourceFileLocation const& GetLocation() const;
 
+  /**
+   * Add the source file and its properties to a memory report.
+   */
+  void ReportMemory(cmMemoryReport& report) const;
+
   /**
    * Get the file extension of this source file.
    */
@@ -5,6 +5,7 @@
 #include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
+#include "cmPathCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmake.h"
@@ -31,7 +32,7 @@ cmSourceFileLocation::cmSourceFileLocation(cmMakefile const* mf,
   this->AmbiguousExtension = true;
   this->Directory = cmSystemTools::GetFilenamePath(name);
   if (cmSystemTools::FileIsFullPath(this->Directory)) {
-    this->Directory = cmSystemTools::CollapseFullPath(this->Directory);
+    this->Directory = this->GetPathCache()->CollapseFullPath(this->Directory);
   }
   this->Name = cmSystemTools::GetFilenameName(name);
   if (kind == cmSourceFileLocationKind::Known) {
@@ -68,7 +69,7 @@ void cmSourceFileLocation::DirectoryUseSource()
 {
   assert(this->Makefile);
   if (this->AmbiguousDirectory) {
-    this->Directory = cmSystemTools::CollapseFullPath(
+    this->Directory = this->GetPathCache()->CollapseFullPath(
       this->Directory, this->Makefile->GetCurrentSourceDirectory());
     this->AmbiguousDirectory = false;
   }
@@ -78,12 +79,17 @@ void cmSourceFileLocation::DirectoryUseBinary()
 {
   assert(this->Makefile);
   if (this->AmbiguousDirectory) {
-    this->Directory = cmSystemTools::CollapseFullPath(
+    this->Directory = this->GetPathCache()->CollapseFullPath(
       this->Directory, this->Makefile->GetCurrentBinaryDirectory());
     this->AmbiguousDirectory = false;
   }
 }
 
+cmPathCache* cmSourceFileLocation::GetPathCache() const
+{
+  return this->Makefile->GetCMakeInstance()->GetPathCache();
+}
+
 void cmSourceFileLocation::UpdateExtension(const std::string& name)
 {
   assert(this->Makefile);
@@ -209,18 +215,20 @@ bool cmSourceFileLocation::Matches(cmSourceFileLocation const& loc)
     }
   } else if (this->AmbiguousDirectory) {
     // Compare possible directory combinations.
-    std::string const srcDir = cmSystemTools::CollapseFullPath(
+    cmPathCache* pathCache = this->GetPathCache();
+    std::string const& srcDir = pathCache->CollapseFullPath(
       this->Directory, this->Makefile->GetCurrentSourceDirectory());
-    std::string const binDir = cmSystemTools::CollapseFullPath(
+    std::string const& binDir = pathCache->CollapseFullPath(
       this->Directory, this->Makefile->GetCurrentBinaryDirectory());
     if (srcDir != loc.Directory && binDir != loc.Directory) {
       return false;
     }
   } else if (loc.AmbiguousDirectory) {
     // Compare possible directory combinations.
-    std::string const srcDir = cmSystemTools::CollapseFullPath(
+    cmPathCache* pathCache = loc.GetPathCache();
+    std::string const& srcDir = pathCache->CollapseFullPath(
       loc.Directory, loc.Makefile->GetCurrentSourceDirectory());
-    std::string const binDir = cmSystemTools::CollapseFullPath(
+    std::string const& binDir = pathCache->CollapseFullPath(
       loc.Directory, loc.Makefile->GetCurrentBinaryDirectory());
     if (srcDir != this->Directory && binDir != this->Directory) {
       return false;
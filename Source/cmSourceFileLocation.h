@@ -10,6 +10,7 @@
 #include "cmSourceFileLocationKind.h"
 
 class cmMakefile;
+class cmPathCache;
 
 /** \class cmSourceFileLocation
  * \brief cmSourceFileLocation tracks knowledge about a source file location
@@ -98,6 +99,8 @@ private:
 
   bool MatchesAmbiguousExtension(cmSourceFileLocation const& loc) const;
 
+  cmPathCache* GetPathCache() const;
+
   // Update the location with additional knowledge.
   void Update(cmSourceFileLocation const& loc);
   void UpdateExtension(const std::string& name);
@@ -11,6 +11,7 @@
 
 #include <cm/memory>
 
+#include "cmAlgorithms.h"
 #include "cmCacheManager.h"
 #include "cmCommand.h"
 #include "cmDefinitions.h"
@@ -18,6 +19,7 @@
 #include "cmGlobVerificationManager.h"
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
+#include "cmMemoryReport.h"
 #include "cmMessageType.h"
 #include "cmStatePrivate.h"
 #include "cmStateSnapshot.h"
@@ -25,6 +27,10 @@
 #include "cmSystemTools.h"
 #include "cmake.h"
 
+#ifndef CMAKE_BOOTSTRAP
+#  include "cmListFilePrefetcher.h"
+#endif
+
 cmState::cmState()
 {
   this->CacheManager = cm::make_unique<cmCacheManager>();
@@ -268,6 +274,8 @@ cmStateSnapshot cmState::Reset()
   this->GlobalProperties.Clear();
   this->PropertyDefinitions.clear();
   this->GlobVerificationManager->Reset();
+  this->BacktraceStrings.clear();
+  this->LastBacktraceString = nullptr;
 
   cmStateDetail::PositionType pos = this->SnapshotData.Truncate();
   this->ExecutionListFiles.Truncate();
@@ -435,13 +443,14 @@ static bool InvokeBuiltinCommand(cmState::BuiltinCommand command,
                                  cmExecutionStatus& status)
 {
   cmMakefile& mf = status.GetMakefile();
-  std::vector<std::string> expandedArguments;
-  if (!mf.ExpandArguments(args, expandedArguments)) {
+  std::vector<std::string> const* expandedArguments =
+    mf.ExpandCommandArguments(args);
+  if (!expandedArguments) {
     // There was an error expanding arguments.  It was already
     // reported, so we can skip this command without error.
     return true;
   }
-  return command(expandedArguments, status);
+  return command(*expandedArguments, status);
 }
 
 void cmState::AddBuiltinCommand(std::string const& name,
@@ -498,16 +507,39 @@ void cmState::AddUnexpectedCommand(std::string const& name, const char* error)
     });
 }
 
-void cmState::AddScriptedCommand(std::string const& name, Command command)
+void cmState::AddScriptedCommand(std::string const& name, Command command,
+                                 cmMemoryFootprint const* body)
 {
   std::string sName = cmSystemTools::LowerCase(name);
+  auto* bodies = this->ScriptedCommandBodies.get();
 
   // if the command already exists, give a new name to the old command.
   if (Command oldCmd = this->GetCommandByExactName(sName)) {
     this->ScriptedCommands["_" + sName] = oldCmd;
+    if (bodies) {
+      (*bodies)["_" + sName] = (*bodies)[sName];
+    }
   }
 
   this->ScriptedCommands[sName] = std::move(command);
+  if (bodies) {
+    (*bodies)[sName] = body ? *body : cmMemoryFootprint();
+  }
+}
+
+void cmState::SetMeasureCommandBodies(bool measure)
+{
+  if (!measure) {
+    this->ScriptedCommandBodies.reset();
+  } else if (!this->ScriptedCommandBodies) {
+    this->ScriptedCommandBodies =
+      cm::make_unique<std::map<std::string, cmMemoryFootprint>>();
+  }
+}
+
+bool cmState::GetMeasureCommandBodies() const
+{
+  return this->ScriptedCommandBodies != nullptr;
 }
 
 cmState::Command cmState::GetCommand(std::string const& name) const
@@ -554,6 +586,9 @@ void cmState::RemoveBuiltinCommand(std::string const& name)
 void cmState::RemoveUserDefinedCommands()
 {
   this->ScriptedCommands.clear();
+  if (this->ScriptedCommandBodies) {
+    this->ScriptedCommandBodies->clear();
+  }
 }
 
 void cmState::SetGlobalProperty(const std::string& prop, const char* value)
@@ -755,6 +790,126 @@ std::string cmState::ModeToString(cmState::Mode mode)
   return "UNKNOWN";
 }
 
+std::string const* cmState::InternBacktraceString(std::string const& str)
+{
+  if (!this->LastBacktraceString || *this->LastBacktraceString != str) {
+    this->LastBacktraceString = &*this->BacktraceStrings.insert(str).first;
+  }
+  return this->LastBacktraceString;
+}
+
+void cmState::ReportMemory(cmMemoryReport& report) const
+{
+  static std::string const state = "state";
+
+  // The snapshot trees keep entries of popped scopes until a later
+  // scope takes their place, so all stored nodes are counted.
+  report.Add(state, "snapshots", this->SnapshotData.GetNodes().size(),
+             this->SnapshotData.GetCapacityBytes());
+  report.Add(state, "policy-scopes", this->PolicyStack.GetNodes().size(),
+             this->PolicyStack.GetCapacityBytes());
+
+  cmMemoryFootprint files;
+  files.Count = this->ExecutionListFiles.GetNodes().size();
+  files.Bytes = this->ExecutionListFiles.GetCapacityBytes();
+  for (std::string const& file : this->ExecutionListFiles.GetNodes()) {
+    files.Bytes += cmMemoryReport::Bytes(file);
+  }
+  report.Add(state, "execution-listfiles", files);
+
+  cmMemoryFootprint definitions;
+  for (cmDefinitions const& d : this->VarTree.GetNodes()) {
+    definitions += d.GetFootprint();
+  }
+  report.Add(state, "definition-scopes", this->VarTree.GetNodes().size(),
+             this->VarTree.GetCapacityBytes());
+  report.Add(state, "definitions", definitions);
+
+  cmMemoryFootprint directories;
+  cmMemoryFootprint properties = this->GlobalProperties.GetFootprint();
+  directories.Count = this->BuildsystemDirectory.GetNodes().size();
+  directories.Bytes = this->BuildsystemDirectory.GetCapacityBytes();
+  for (cmStateDetail::BuildsystemDirectoryStateType const& d :
+       this->BuildsystemDirectory.GetNodes()) {
+    directories.Bytes += cmMemoryReport::Bytes(d.Location) +
+      cmMemoryReport::Bytes(d.OutputLocation) +
+      cmMemoryReport::Bytes(d.RelativePathTopSource) +
+      cmMemoryReport::Bytes(d.RelativePathTopBinary) +
+      cmMemoryReport::Bytes(d.IncludeDirectories) +
+      cmMemoryReport::Bytes(d.IncludeDirectoryBacktraces) +
+      cmMemoryReport::Bytes(d.CompileDefinitions) +
+      cmMemoryReport::Bytes(d.CompileDefinitionsBacktraces) +
+      cmMemoryReport::Bytes(d.CompileOptions) +
+      cmMemoryReport::Bytes(d.CompileOptionsBacktraces) +
+      cmMemoryReport::Bytes(d.LinkOptions) +
+      cmMemoryReport::Bytes(d.LinkOptionsBacktraces) +
+      cmMemoryReport::Bytes(d.LinkDirectories) +
+      cmMemoryReport::Bytes(d.LinkDirectoriesBacktraces) +
+      cmMemoryReport::Bytes(d.NormalTargetNames) +
+      cmMemoryReport::Bytes(d.ProjectName) +
+      cmMemoryReport::Bytes(d.Children);
+    properties += d.Properties.GetFootprint();
+  }
+  report.Add(state, "directories", directories);
+  report.Add(state, "properties", properties);
+
+  if (this->ScriptedCommandBodies) {
+    cmMemoryFootprint bodies;
+    for (auto const& b : *this->ScriptedCommandBodies) {
+      bodies += b.second;
+    }
+    report.Add("listfiles", "command-bodies", bodies);
+  }
+  report.Add(state, "scripted-commands", this->ScriptedCommands.size(),
+             cmMemoryReport::Bytes(this->ScriptedCommands));
+}
+
+std::shared_ptr<cmListFile const> cmState::ParseListFile(
+  std::string const& path, cmMessenger* messenger,
+  cmListFileBacktrace const& lfbt)
+{
+  std::shared_ptr<cmListFile const> listFile;
+#ifndef CMAKE_BOOTSTRAP
+  if (cmListFilePrefetcher* prefetcher = this->GetListFilePrefetcher(path)) {
+    listFile = prefetcher->Take(path);
+  }
+#endif
+  if (!listFile) {
+    auto parsed = std::make_shared<cmListFile>();
+    if (!parsed->ParseFile(path.c_str(), messenger, lfbt)) {
+      return nullptr;
+    }
+    listFile = std::move(parsed);
+  }
+  return listFile;
+}
+
+void cmState::AddListFilePrefetcher(cmListFilePrefetcher* prefetcher)
+{
+  this->ListFilePrefetchers.push_back(prefetcher);
+}
+
+void cmState::RemoveListFilePrefetcher(cmListFilePrefetcher* prefetcher)
+{
+  cmEraseIf(this->ListFilePrefetchers,
+            [prefetcher](cmListFilePrefetcher* p) { return p == prefetcher; });
+}
+
+cmListFilePrefetcher* cmState::GetListFilePrefetcher(
+  std::string const& path) const
+{
+#ifndef CMAKE_BOOTSTRAP
+  for (cmListFilePrefetcher* prefetcher : this->ListFilePrefetchers) {
+    if (cmSystemTools::IsSubDirectory(path, prefetcher->GetDirectory())) {
+      return prefetcher;
+    }
+  }
+#else
+  static_cast<void>(path);
+#endif
+  return nullptr;
+}
+
 std::string const& cmState::GetBinaryDirectory() const
 {
   return this->BinaryDirectory;
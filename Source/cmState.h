@@ -10,6 +10,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "cmDefinitions.h"
@@ -25,6 +26,9 @@
 class cmCacheManager;
 class cmCommand;
 class cmGlobVerificationManager;
+class cmListFilePrefetcher;
+struct cmMemoryFootprint;
+class cmMemoryReport;
 class cmPropertyDefinition;
 class cmStateSnapshot;
 class cmMessenger;
@@ -160,7 +164,15 @@ public:
   void AddDisallowedCommand(std::string const& name, BuiltinCommand command,
                             cmPolicies::PolicyID policy, const char* message);
   void AddUnexpectedCommand(std::string const& name, const char* error);
-  void AddScriptedCommand(std::string const& name, Command command);
+  // The footprint of the listfile commands run by a scripted command
+  // is only used for memory reports.  It is kept only while measuring.
+  void AddScriptedCommand(std::string const& name, Command command,
+                          cmMemoryFootprint const* body = nullptr);
+  /** Keep the footprints of scripted command bodies for ReportMemory.
+      Measuring a body walks all its commands, so this is off unless a
+      memory report was requested.  */
+  void SetMeasureCommandBodies(bool measure);
+  bool GetMeasureCommandBodies() const;
   void RemoveBuiltinCommand(std::string const& name);
   void RemoveUserDefinedCommands();
   std::vector<std::string> GetCommandNames() const;
@@ -200,6 +212,25 @@ public:
 
   static std::string ModeToString(Mode mode);
 
+  /** Parse a listfile, or take it from a registered prefetcher.  */
+  std::shared_ptr<cmListFile const> ParseListFile(
+    std::string const& path, cmMessenger* messenger,
+    cmListFileBacktrace const& lfbt);
+  /** Take listfiles from a prefetcher while it is registered.  */
+  void AddListFilePrefetcher(cmListFilePrefetcher* prefetcher);
+  void RemoveListFilePrefetcher(cmListFilePrefetcher* prefetcher);
+  /** Get the registered prefetcher of the directory holding a file.  */
+  cmListFilePrefetcher* GetListFilePrefetcher(std::string const& path) const;
+
+  /** Get a string equal to the given one that stays valid until the
+      next Reset.  Backtrace frames refer to their file paths and command
+      names this way.  Like the rest of the state this may be used only
+      from the main thread.  */
+  std::string const* InternBacktraceString(std::string const& str);
+
+  /** Add the snapshots, variables and command bodies to a report.  */
+  void ReportMemory(cmMemoryReport& report) const;
+
 private:
   friend class cmake;
   void AddCacheEntry(const std::string& key, const char* value,
@@ -221,6 +252,12 @@ private:
   std::vector<std::string> EnabledLanguages;
   std::map<std::string, Command> BuiltinCommands;
   std::map<std::string, Command> ScriptedCommands;
+  std::unique_ptr<std::map<std::string, cmMemoryFootprint>>
+    ScriptedCommandBodies;
+  std::vector<cmListFilePrefetcher*> ListFilePrefetchers;
+  std::unordered_set<std::string> BacktraceStrings;
+  // Consecutive lookups are usually for the same file.
+  std::string const* LastBacktraceString = nullptr;
   cmPropertyMap GlobalProperties;
   std::unique_ptr<cmCacheManager> CacheManager;
   std::unique_ptr<cmGlobVerificationManager> GlobVerificationManager;
@@ -59,6 +59,9 @@ struct cmStateDetail::PolicyStackEntry : public cmPolicies::PolicyMap
   {
   }
   bool Weak;
+  // The settings of this entry combined with those of the entries below
+  // it in the same directory, so that a lookup does not walk the stack.
+  derived Resolved;
 };
 
 struct cmStateDetail::BuildsystemDirectoryStateType
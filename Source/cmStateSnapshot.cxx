@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cassert>
 #include <string>
+#include <vector>
 
 #include <cm/iterator>
 
@@ -52,7 +53,7 @@ void cmStateSnapshot::SetListFile(const std::string& listfile)
   *this->Position->ExecutionListFile = listfile;
 }
 
-std::string cmStateSnapshot::GetExecutionListFile() const
+std::string const& cmStateSnapshot::GetExecutionListFile() const
 {
   return *this->Position->ExecutionListFile;
 }
@@ -128,11 +129,36 @@ cmStateSnapshot cmStateSnapshot::GetCallStackBottom() const
   return { this->State, pos };
 }
 
+namespace {
+using PolicyStackIterator =
+  cmLinkedTree<cmStateDetail::PolicyStackEntry>::iterator;
+
+// Combine the settings of an entry with the resolved settings of the
+// entry below it, unless that is the root of the directory.
+void ResolvePolicies(PolicyStackIterator entry, PolicyStackIterator root)
+{
+  PolicyStackIterator below = entry;
+  ++below;
+  entry->Resolved =
+    below != root ? below->Resolved : cmPolicies::PolicyMap();
+  if (entry->IsEmpty()) {
+    return;
+  }
+  for (int i = 0; i < cmPolicies::CMPCOUNT; ++i) {
+    cmPolicies::PolicyID const id = static_cast<cmPolicies::PolicyID>(i);
+    if (entry->IsDefined(id)) {
+      entry->Resolved.Set(id, entry->Get(id));
+    }
+  }
+}
+}
+
 void cmStateSnapshot::PushPolicy(cmPolicies::PolicyMap const& entry, bool weak)
 {
   cmStateDetail::PositionType pos = this->Position;
   pos->Policies = this->State->PolicyStack.Push(
     pos->Policies, cmStateDetail::PolicyStackEntry(entry, weak));
+  ResolvePolicies(pos->Policies, pos->PolicyRoot);
 }
 
 bool cmStateSnapshot::PopPolicy()
@@ -154,12 +180,18 @@ void cmStateSnapshot::SetPolicy(cmPolicies::PolicyID id,
                                 cmPolicies::PolicyStatus status)
 {
   // Update the policy stack from the top to the top-most strong entry.
+  std::vector<PolicyStackIterator> updated;
   bool previous_was_weak = true;
-  for (cmLinkedTree<cmStateDetail::PolicyStackEntry>::iterator psi =
-         this->Position->Policies;
+  for (PolicyStackIterator psi = this->Position->Policies;
        previous_was_weak && psi != this->Position->PolicyRoot; ++psi) {
     psi->Set(id, status);
     previous_was_weak = psi->Weak;
+    updated.push_back(psi);
+  }
+
+  // Resolve the updated entries again, bottom-up.
+  for (auto i = updated.rbegin(); i != updated.rend(); ++i) {
+    ResolvePolicies(*i, this->Position->PolicyRoot);
   }
 }
 
@@ -178,19 +210,17 @@ cmPolicies::PolicyStatus cmStateSnapshot::GetPolicy(cmPolicies::PolicyID id,
 
   while (true) {
     assert(dir.IsValid());
-    cmLinkedTree<cmStateDetail::PolicyStackEntry>::iterator leaf =
-      dir->DirectoryEnd->Policies;
-    cmLinkedTree<cmStateDetail::PolicyStackEntry>::iterator root =
-      dir->DirectoryEnd->PolicyRoot;
-    for (; leaf != root; ++leaf) {
-      if (parent_scope) {
-        parent_scope = false;
-        continue;
-      }
-      if (leaf->IsDefined(id)) {
-        status = leaf->Get(id);
-        return status;
-      }
+    PolicyStackIterator leaf = dir->DirectoryEnd->Policies;
+    PolicyStackIterator root = dir->DirectoryEnd->PolicyRoot;
+    if (parent_scope && leaf != root) {
+      parent_scope = false;
+      ++leaf;
+    }
+    // The top entry of the directory knows the setting of all entries
+    // down to the directory root.
+    if (leaf != root && leaf->Resolved.IsDefined(id)) {
+      status = leaf->Resolved.Get(id);
+      return status;
     }
     cmStateDetail::PositionType e = dir->DirectoryEnd;
     cmStateDetail::PositionType p = e->DirectoryParent;
@@ -10,7 +10,6 @@
 #include <iterator>
 #include <set>
 #include <sstream>
-#include <unordered_set>
 
 #include <cm/memory>
 
@@ -21,6 +20,7 @@
 #include "cmGlobalGenerator.h"
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
+#include "cmMemoryReport.h"
 #include "cmMessageType.h"
 #include "cmMessenger.h"
 #include "cmProperty.h"
@@ -581,6 +581,57 @@ cmListFileBacktrace const& cmTarget::GetBacktrace() const
   return impl->Backtrace;
 }
 
+void cmTarget::ReportMemory(cmMemoryReport& report) const
+{
+  static std::string const targets = "targets";
+
+  report.Add(targets, "targets", 1,
+             sizeof(cmTarget) + sizeof(cmTargetInternals) +
+               cmMemoryReport::Bytes(impl->Name) +
+               cmMemoryReport::Bytes(impl->InstallPath) +
+               cmMemoryReport::Bytes(impl->RuntimeInstallPath) +
+               cmMemoryReport::Bytes(impl->InstallGenerators) +
+               cmMemoryReport::Bytes(impl->OriginalLinkLibraries) +
+               cmMemoryReport::Bytes(impl->TLLCommands));
+  report.Add(targets, "properties", impl->Properties.GetFootprint());
+
+  // Usage requirements and sources are stored as entries with the
+  // backtrace of the command that added them.
+  cmMemoryFootprint entries;
+  auto addEntries = [&entries](std::vector<std::string> const& e,
+                               std::vector<cmListFileBacktrace> const& bt) {
+    entries.Count += e.size();
+    entries.Bytes += cmMemoryReport::Bytes(e) + cmMemoryReport::Bytes(bt);
+  };
+  addEntries(impl->IncludeDirectoriesEntries,
+             impl->IncludeDirectoriesBacktraces);
+  addEntries(impl->CompileOptionsEntries, impl->CompileOptionsBacktraces);
+  addEntries(impl->CompileFeaturesEntries, impl->CompileFeaturesBacktraces);
+  addEntries(impl->CompileDefinitionsEntries,
+             impl->CompileDefinitionsBacktraces);
+  addEntries(impl->PrecompileHeadersEntries,
+             impl->PrecompileHeadersBacktraces);
+  addEntries(impl->SourceEntries, impl->SourceBacktraces);
+  addEntries(impl->LinkOptionsEntries, impl->LinkOptionsBacktraces);
+  addEntries(impl->LinkDirectoriesEntries, impl->LinkDirectoriesBacktraces);
+  addEntries(impl->LinkImplementationPropertyEntries,
+             impl->LinkImplementationPropertyBacktraces);
+  report.Add(targets, "property-entries", entries);
+
+  std::size_t const customCommands = impl->PreBuildCommands.size() +
+    impl->PreLinkCommands.size() + impl->PostBuildCommands.size();
+  report.Add(targets, "custom-commands", customCommands,
+             cmMemoryReport::Bytes(impl->PreBuildCommands) +
+               cmMemoryReport::Bytes(impl->PreLinkCommands) +
+               cmMemoryReport::Bytes(impl->PostBuildCommands));
+
+  std::size_t utilityBytes = cmMemoryReport::Bytes(impl->Utilities);
+  for (BT<std::string> const& u : impl->Utilities) {
+    utilityBytes += cmMemoryReport::Bytes(u.Value);
+  }
+  report.Add(targets, "utilities", impl->Utilities.size(), utilityBytes);
+}
+
 bool cmTarget::IsExecutableWithExports() const
 {
   return (this->GetType() == cmStateEnums::EXECUTABLE &&
@@ -1100,55 +1151,39 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
         impl->Makefile->GetBacktrace())) {
     return;
   }
-#define MAKE_STATIC_PROP(PROP) static const std::string prop##PROP = #PROP
-  MAKE_STATIC_PROP(COMPILE_DEFINITIONS);
-  MAKE_STATIC_PROP(COMPILE_FEATURES);
-  MAKE_STATIC_PROP(COMPILE_OPTIONS);
-  MAKE_STATIC_PROP(PRECOMPILE_HEADERS);
-  MAKE_STATIC_PROP(PRECOMPILE_HEADERS_REUSE_FROM);
-  MAKE_STATIC_PROP(CUDA_PTX_COMPILATION);
-  MAKE_STATIC_PROP(EXPORT_NAME);
-  MAKE_STATIC_PROP(IMPORTED_GLOBAL);
-  MAKE_STATIC_PROP(INCLUDE_DIRECTORIES);
-  MAKE_STATIC_PROP(LINK_OPTIONS);
-  MAKE_STATIC_PROP(LINK_DIRECTORIES);
-  MAKE_STATIC_PROP(LINK_LIBRARIES);
-  MAKE_STATIC_PROP(MANUALLY_ADDED_DEPENDENCIES);
-  MAKE_STATIC_PROP(NAME);
-  MAKE_STATIC_PROP(SOURCES);
-  MAKE_STATIC_PROP(TYPE);
-#undef MAKE_STATIC_PROP
-  if (prop == propMANUALLY_ADDED_DEPENDENCIES) {
+  cmTargetSpecialProperty const id =
+    cmTargetPropertyComputer::LookupSpecialProperty(prop);
+  if (id == cmTargetSpecialProperty::MANUALLY_ADDED_DEPENDENCIES) {
     impl->Makefile->IssueMessage(
       MessageType::FATAL_ERROR,
       "MANUALLY_ADDED_DEPENDENCIES property is read-only\n");
     return;
   }
-  if (prop == propNAME) {
+  if (id == cmTargetSpecialProperty::NAME) {
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR,
                                  "NAME property is read-only\n");
     return;
   }
-  if (prop == propTYPE) {
+  if (id == cmTargetSpecialProperty::TYPE) {
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR,
                                  "TYPE property is read-only\n");
     return;
   }
-  if (prop == propEXPORT_NAME && this->IsImported()) {
+  if (id == cmTargetSpecialProperty::EXPORT_NAME && this->IsImported()) {
     std::ostringstream e;
     e << "EXPORT_NAME property can't be set on imported targets (\""
       << impl->Name << "\")\n";
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
     return;
   }
-  if (prop == propSOURCES && this->IsImported()) {
+  if (id == cmTargetSpecialProperty::SOURCES && this->IsImported()) {
     std::ostringstream e;
     e << "SOURCES property can't be set on imported targets (\"" << impl->Name
       << "\")\n";
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
     return;
   }
-  if (prop == propIMPORTED_GLOBAL && !this->IsImported()) {
+  if (id == cmTargetSpecialProperty::IMPORTED_GLOBAL && !this->IsImported()) {
     std::ostringstream e;
     e << "IMPORTED_GLOBAL property can't be set on non-imported targets (\""
       << impl->Name << "\")\n";
@@ -1156,7 +1191,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
     return;
   }
 
-  if (prop == propINCLUDE_DIRECTORIES) {
+  if (id == cmTargetSpecialProperty::INCLUDE_DIRECTORIES) {
     impl->IncludeDirectoriesEntries.clear();
     impl->IncludeDirectoriesBacktraces.clear();
     if (value) {
@@ -1164,7 +1199,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->IncludeDirectoriesBacktraces.push_back(lfbt);
     }
-  } else if (prop == propCOMPILE_OPTIONS) {
+  } else if (id == cmTargetSpecialProperty::COMPILE_OPTIONS) {
     impl->CompileOptionsEntries.clear();
     impl->CompileOptionsBacktraces.clear();
     if (value) {
@@ -1172,7 +1207,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->CompileOptionsBacktraces.push_back(lfbt);
     }
-  } else if (prop == propCOMPILE_FEATURES) {
+  } else if (id == cmTargetSpecialProperty::COMPILE_FEATURES) {
     impl->CompileFeaturesEntries.clear();
     impl->CompileFeaturesBacktraces.clear();
     if (value) {
@@ -1180,7 +1215,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->CompileFeaturesBacktraces.push_back(lfbt);
     }
-  } else if (prop == propCOMPILE_DEFINITIONS) {
+  } else if (id == cmTargetSpecialProperty::COMPILE_DEFINITIONS) {
     impl->CompileDefinitionsEntries.clear();
     impl->CompileDefinitionsBacktraces.clear();
     if (value) {
@@ -1188,7 +1223,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->CompileDefinitionsBacktraces.push_back(lfbt);
     }
-  } else if (prop == propLINK_OPTIONS) {
+  } else if (id == cmTargetSpecialProperty::LINK_OPTIONS) {
     impl->LinkOptionsEntries.clear();
     impl->LinkOptionsBacktraces.clear();
     if (value) {
@@ -1196,7 +1231,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->LinkOptionsBacktraces.push_back(lfbt);
     }
-  } else if (prop == propLINK_DIRECTORIES) {
+  } else if (id == cmTargetSpecialProperty::LINK_DIRECTORIES) {
     impl->LinkDirectoriesEntries.clear();
     impl->LinkDirectoriesBacktraces.clear();
     if (value) {
@@ -1204,7 +1239,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->LinkDirectoriesBacktraces.push_back(lfbt);
     }
-  } else if (prop == propPRECOMPILE_HEADERS) {
+  } else if (id == cmTargetSpecialProperty::PRECOMPILE_HEADERS) {
     impl->PrecompileHeadersEntries.clear();
     impl->PrecompileHeadersBacktraces.clear();
     if (value) {
@@ -1212,7 +1247,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->PrecompileHeadersBacktraces.push_back(lfbt);
     }
-  } else if (prop == propLINK_LIBRARIES) {
+  } else if (id == cmTargetSpecialProperty::LINK_LIBRARIES) {
     impl->LinkImplementationPropertyEntries.clear();
     impl->LinkImplementationPropertyBacktraces.clear();
     if (value) {
@@ -1220,7 +1255,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       impl->LinkImplementationPropertyEntries.emplace_back(value);
       impl->LinkImplementationPropertyBacktraces.push_back(lfbt);
     }
-  } else if (prop == propSOURCES) {
+  } else if (id == cmTargetSpecialProperty::SOURCES) {
     impl->SourceEntries.clear();
     impl->SourceBacktraces.clear();
     if (value) {
@@ -1228,7 +1263,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       impl->SourceEntries.emplace_back(value);
       impl->SourceBacktraces.push_back(lfbt);
     }
-  } else if (prop == propIMPORTED_GLOBAL) {
+  } else if (id == cmTargetSpecialProperty::IMPORTED_GLOBAL) {
     if (!cmIsOn(value)) {
       std::ostringstream e;
       e << "IMPORTED_GLOBAL property can't be set to FALSE on targets (\""
@@ -1244,7 +1279,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
   } else if (cmHasLiteralPrefix(prop, "IMPORTED_LIBNAME") &&
              !impl->CheckImportedLibName(prop, value ? value : "")) {
     /* error was reported by check method */
-  } else if (prop == propCUDA_PTX_COMPILATION &&
+  } else if (id == cmTargetSpecialProperty::CUDA_PTX_COMPILATION &&
              this->GetType() != cmStateEnums::OBJECT_LIBRARY) {
     std::ostringstream e;
     e << "CUDA_PTX_COMPILATION property can only be applied to OBJECT "
@@ -1252,7 +1287,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
       << impl->Name << "\")\n";
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
     return;
-  } else if (prop == propPRECOMPILE_HEADERS_REUSE_FROM) {
+  } else if (id == cmTargetSpecialProperty::PRECOMPILE_HEADERS_REUSE_FROM) {
     if (this->GetProperty("PRECOMPILE_HEADERS")) {
       std::ostringstream e;
       e << "PRECOMPILE_HEADERS property is already set on target (\""
@@ -1300,26 +1335,28 @@ void cmTarget::AppendProperty(const std::string& prop, const char* value,
         impl->Makefile->GetBacktrace())) {
     return;
   }
-  if (prop == "NAME") {
+  cmTargetSpecialProperty const id =
+    cmTargetPropertyComputer::LookupSpecialProperty(prop);
+  if (id == cmTargetSpecialProperty::NAME) {
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR,
                                  "NAME property is read-only\n");
     return;
   }
-  if (prop == "EXPORT_NAME" && this->IsImported()) {
+  if (id == cmTargetSpecialProperty::EXPORT_NAME && this->IsImported()) {
     std::ostringstream e;
     e << "EXPORT_NAME property can't be set on imported targets (\""
       << impl->Name << "\")\n";
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
     return;
   }
-  if (prop == "SOURCES" && this->IsImported()) {
+  if (id == cmTargetSpecialProperty::SOURCES && this->IsImported()) {
     std::ostringstream e;
     e << "SOURCES property can't be set on imported targets (\"" << impl->Name
       << "\")\n";
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
     return;
   }
-  if (prop == "IMPORTED_GLOBAL") {
+  if (id == cmTargetSpecialProperty::IMPORTED_GLOBAL) {
     std::ostringstream e;
     e << "IMPORTED_GLOBAL property can't be appended, only set on imported "
          "targets (\""
@@ -1327,43 +1364,43 @@ void cmTarget::AppendProperty(const std::string& prop, const char* value,
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
     return;
   }
-  if (prop == "INCLUDE_DIRECTORIES") {
+  if (id == cmTargetSpecialProperty::INCLUDE_DIRECTORIES) {
     if (value && *value) {
       impl->IncludeDirectoriesEntries.emplace_back(value);
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->IncludeDirectoriesBacktraces.push_back(lfbt);
     }
-  } else if (prop == "COMPILE_OPTIONS") {
+  } else if (id == cmTargetSpecialProperty::COMPILE_OPTIONS) {
     if (value && *value) {
       impl->CompileOptionsEntries.emplace_back(value);
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->CompileOptionsBacktraces.push_back(lfbt);
     }
-  } else if (prop == "COMPILE_FEATURES") {
+  } else if (id == cmTargetSpecialProperty::COMPILE_FEATURES) {
     if (value && *value) {
       impl->CompileFeaturesEntries.emplace_back(value);
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->CompileFeaturesBacktraces.push_back(lfbt);
     }
-  } else if (prop == "COMPILE_DEFINITIONS") {
+  } else if (id == cmTargetSpecialProperty::COMPILE_DEFINITIONS) {
     if (value && *value) {
       impl->CompileDefinitionsEntries.emplace_back(value);
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->CompileDefinitionsBacktraces.push_back(lfbt);
     }
-  } else if (prop == "LINK_OPTIONS") {
+  } else if (id == cmTargetSpecialProperty::LINK_OPTIONS) {
     if (value && *value) {
       impl->LinkOptionsEntries.emplace_back(value);
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->LinkOptionsBacktraces.push_back(lfbt);
     }
-  } else if (prop == "LINK_DIRECTORIES") {
+  } else if (id == cmTargetSpecialProperty::LINK_DIRECTORIES) {
     if (value && *value) {
       impl->LinkDirectoriesEntries.emplace_back(value);
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->LinkDirectoriesBacktraces.push_back(lfbt);
     }
-  } else if (prop == "PRECOMPILE_HEADERS") {
+  } else if (id == cmTargetSpecialProperty::PRECOMPILE_HEADERS) {
     if (this->GetProperty("PRECOMPILE_HEADERS_REUSE_FROM")) {
       std::ostringstream e;
       e << "PRECOMPILE_HEADERS_REUSE_FROM property is already set on target "
@@ -1377,13 +1414,13 @@ void cmTarget::AppendProperty(const std::string& prop, const char* value,
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->PrecompileHeadersBacktraces.push_back(lfbt);
     }
-  } else if (prop == "LINK_LIBRARIES") {
+  } else if (id == cmTargetSpecialProperty::LINK_LIBRARIES) {
     if (value && *value) {
       cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
       impl->LinkImplementationPropertyEntries.emplace_back(value);
       impl->LinkImplementationPropertyBacktraces.push_back(lfbt);
     }
-  } else if (prop == "SOURCES") {
+  } else if (id == cmTargetSpecialProperty::SOURCES) {
     cmListFileBacktrace lfbt = impl->Makefile->GetBacktrace();
     impl->SourceEntries.emplace_back(value);
     impl->SourceBacktraces.push_back(lfbt);
@@ -1598,44 +1635,8 @@ const char* cmTarget::GetComputedProperty(
 
 const char* cmTarget::GetProperty(const std::string& prop) const
 {
-#define MAKE_STATIC_PROP(PROP) static const std::string prop##PROP = #PROP
-  MAKE_STATIC_PROP(LINK_LIBRARIES);
-  MAKE_STATIC_PROP(TYPE);
-  MAKE_STATIC_PROP(INCLUDE_DIRECTORIES);
-  MAKE_STATIC_PROP(COMPILE_FEATURES);
-  MAKE_STATIC_PROP(COMPILE_OPTIONS);
-  MAKE_STATIC_PROP(COMPILE_DEFINITIONS);
-  MAKE_STATIC_PROP(LINK_OPTIONS);
-  MAKE_STATIC_PROP(LINK_DIRECTORIES);
-  MAKE_STATIC_PROP(PRECOMPILE_HEADERS);
-  MAKE_STATIC_PROP(IMPORTED);
-  MAKE_STATIC_PROP(IMPORTED_GLOBAL);
-  MAKE_STATIC_PROP(MANUALLY_ADDED_DEPENDENCIES);
-  MAKE_STATIC_PROP(NAME);
-  MAKE_STATIC_PROP(BINARY_DIR);
-  MAKE_STATIC_PROP(SOURCE_DIR);
-  MAKE_STATIC_PROP(SOURCES);
-#undef MAKE_STATIC_PROP
-  static std::unordered_set<std::string> const specialProps{
-    propLINK_LIBRARIES,
-    propTYPE,
-    propINCLUDE_DIRECTORIES,
-    propCOMPILE_FEATURES,
-    propCOMPILE_OPTIONS,
-    propCOMPILE_DEFINITIONS,
-    propPRECOMPILE_HEADERS,
-    propLINK_OPTIONS,
-    propLINK_DIRECTORIES,
-    propIMPORTED,
-    propIMPORTED_GLOBAL,
-    propMANUALLY_ADDED_DEPENDENCIES,
-    propNAME,
-    propBINARY_DIR,
-    propSOURCE_DIR,
-    propSOURCES
-  };
-  if (specialProps.count(prop)) {
-    if (prop == propLINK_LIBRARIES) {
+  switch (cmTargetPropertyComputer::LookupSpecialProperty(prop)) {
+    case cmTargetSpecialProperty::LINK_LIBRARIES: {
       if (impl->LinkImplementationPropertyEntries.empty()) {
         return nullptr;
       }
@@ -1645,10 +1646,9 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       return output.c_str();
     }
     // the type property returns what type the target is
-    if (prop == propTYPE) {
+    case cmTargetSpecialProperty::TYPE:
       return cmState::GetTargetTypeName(this->GetType());
-    }
-    if (prop == propINCLUDE_DIRECTORIES) {
+    case cmTargetSpecialProperty::INCLUDE_DIRECTORIES: {
       if (impl->IncludeDirectoriesEntries.empty()) {
         return nullptr;
       }
@@ -1657,7 +1657,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->IncludeDirectoriesEntries, ";");
       return output.c_str();
     }
-    if (prop == propCOMPILE_FEATURES) {
+    case cmTargetSpecialProperty::COMPILE_FEATURES: {
       if (impl->CompileFeaturesEntries.empty()) {
         return nullptr;
       }
@@ -1666,7 +1666,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->CompileFeaturesEntries, ";");
       return output.c_str();
     }
-    if (prop == propCOMPILE_OPTIONS) {
+    case cmTargetSpecialProperty::COMPILE_OPTIONS: {
       if (impl->CompileOptionsEntries.empty()) {
         return nullptr;
       }
@@ -1675,7 +1675,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->CompileOptionsEntries, ";");
       return output.c_str();
     }
-    if (prop == propCOMPILE_DEFINITIONS) {
+    case cmTargetSpecialProperty::COMPILE_DEFINITIONS: {
       if (impl->CompileDefinitionsEntries.empty()) {
         return nullptr;
       }
@@ -1684,7 +1684,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->CompileDefinitionsEntries, ";");
       return output.c_str();
     }
-    if (prop == propLINK_OPTIONS) {
+    case cmTargetSpecialProperty::LINK_OPTIONS: {
       if (impl->LinkOptionsEntries.empty()) {
         return nullptr;
       }
@@ -1693,7 +1693,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->LinkOptionsEntries, ";");
       return output.c_str();
     }
-    if (prop == propLINK_DIRECTORIES) {
+    case cmTargetSpecialProperty::LINK_DIRECTORIES: {
       if (impl->LinkDirectoriesEntries.empty()) {
         return nullptr;
       }
@@ -1703,7 +1703,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
 
       return output.c_str();
     }
-    if (prop == propMANUALLY_ADDED_DEPENDENCIES) {
+    case cmTargetSpecialProperty::MANUALLY_ADDED_DEPENDENCIES: {
       if (impl->Utilities.empty()) {
         return nullptr;
       }
@@ -1712,7 +1712,7 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->Utilities, ";");
       return output.c_str();
     }
-    if (prop == propPRECOMPILE_HEADERS) {
+    case cmTargetSpecialProperty::PRECOMPILE_HEADERS: {
       if (impl->PrecompileHeadersEntries.empty()) {
         return nullptr;
       }
@@ -1721,27 +1721,24 @@ const char* cmTarget::GetProperty(const std::string& prop) const
       output = cmJoin(impl->PrecompileHeadersEntries, ";");
       return output.c_str();
     }
-    if (prop == propIMPORTED) {
+    case cmTargetSpecialProperty::IMPORTED:
       return this->IsImported() ? "TRUE" : "FALSE";
-    }
-    if (prop == propIMPORTED_GLOBAL) {
+    case cmTargetSpecialProperty::IMPORTED_GLOBAL:
       return this->IsImportedGloballyVisible() ? "TRUE" : "FALSE";
-    }
-    if (prop == propNAME) {
+    case cmTargetSpecialProperty::NAME:
       return this->GetName().c_str();
-    }
-    if (prop == propBINARY_DIR) {
+    case cmTargetSpecialProperty::BINARY_DIR:
       return impl->Makefile->GetStateSnapshot()
         .GetDirectory()
         .GetCurrentBinary()
         .c_str();
-    }
-    if (prop == propSOURCE_DIR) {
+    case cmTargetSpecialProperty::SOURCE_DIR:
       return impl->Makefile->GetStateSnapshot()
         .GetDirectory()
         .GetCurrentSource()
         .c_str();
-    }
+    default:
+      break;
   }
 
   const char* retVal = impl->Properties.GetPropertyValue(prop);
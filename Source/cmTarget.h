@@ -23,6 +23,7 @@ class cmCustomCommand;
 class cmGlobalGenerator;
 class cmInstallTargetGenerator;
 class cmMakefile;
+class cmMemoryReport;
 class cmMessenger;
 class cmPropertyMap;
 class cmSourceFile;
@@ -202,6 +203,9 @@ public:
   //! Get a backtrace from the creation of the target.
   cmListFileBacktrace const& GetBacktrace() const;
 
+  //! Add the target and its property storage to a memory report.
+  void ReportMemory(cmMemoryReport& report) const;
+
   void InsertInclude(std::string const& entry, cmListFileBacktrace const& bt,
                      bool before = false);
   void InsertCompileOption(std::string const& entry,
@@ -4,6 +4,7 @@
 #include "cmTargetPropertyComputer.h"
 
 #include <cctype>
+#include <cstddef>
 #include <sstream>
 #include <unordered_set>
 
@@ -13,6 +14,107 @@
 #include "cmStateSnapshot.h"
 #include "cmStringAlgorithms.h"
 
+namespace {
+// Names of the special properties indexed by cmTargetSpecialProperty.
+constexpr const char* SpecialPropertyNames[] = {
+  "",
+  "BINARY_DIR",
+  "COMPILE_DEFINITIONS",
+  "COMPILE_FEATURES",
+  "COMPILE_OPTIONS",
+  "CUDA_PTX_COMPILATION",
+  "EXPORT_NAME",
+  "IMPORTED",
+  "IMPORTED_GLOBAL",
+  "INCLUDE_DIRECTORIES",
+  "LINK_DIRECTORIES",
+  "LINK_LIBRARIES",
+  "LINK_OPTIONS",
+  "LOCATION",
+  "MANUALLY_ADDED_DEPENDENCIES",
+  "NAME",
+  "PRECOMPILE_HEADERS",
+  "PRECOMPILE_HEADERS_REUSE_FROM",
+  "SOURCE_DIR",
+  "SOURCES",
+  "TYPE",
+};
+constexpr std::size_t SpecialPropertyCount =
+  sizeof(SpecialPropertyNames) / sizeof(SpecialPropertyNames[0]);
+static_assert(SpecialPropertyCount ==
+                static_cast<std::size_t>(cmTargetSpecialProperty::TYPE) + 1,
+              "SpecialPropertyNames does not match cmTargetSpecialProperty");
+
+// The hash of a name combines its length with its first and last
+// characters.  The multipliers were chosen so that no two special
+// property names share a slot.
+constexpr std::size_t SpecialPropertySlots = 64;
+
+constexpr std::size_t SpecialPropertyHash(const char* name, std::size_t len)
+{
+  return (len + 2 * static_cast<unsigned char>(name[0]) +
+          7 * static_cast<unsigned char>(name[len - 1])) %
+    SpecialPropertySlots;
+}
+
+constexpr std::size_t NameLength(const char* name)
+{
+  return *name ? 1 + NameLength(name + 1) : 0;
+}
+
+constexpr std::size_t NameHash(std::size_t i)
+{
+  return SpecialPropertyHash(SpecialPropertyNames[i],
+                             NameLength(SpecialPropertyNames[i]));
+}
+
+// Find the property whose name hashes to the given slot.
+constexpr cmTargetSpecialProperty SlotProperty(std::size_t slot,
+                                               std::size_t i = 1)
+{
+  return i == SpecialPropertyCount
+    ? cmTargetSpecialProperty::None
+    : NameHash(i) == slot ? static_cast<cmTargetSpecialProperty>(i)
+                          : SlotProperty(slot, i + 1);
+}
+
+// Check that the names after i do not share a slot with name i.
+constexpr bool HashIsPerfect(std::size_t i = 1, std::size_t j = 2)
+{
+  return i == SpecialPropertyCount
+    ? true
+    : j == SpecialPropertyCount
+      ? HashIsPerfect(i + 1, i + 2)
+      : NameHash(i) != NameHash(j) && HashIsPerfect(i, j + 1);
+}
+static_assert(HashIsPerfect(),
+              "Special target property names must not share a slot");
+
+#define SLOTS4(n)                                                             \
+  SlotProperty(n), SlotProperty(n + 1), SlotProperty(n + 2),                  \
+    SlotProperty(n + 3)
+#define SLOTS16(n) SLOTS4(n), SLOTS4(n + 4), SLOTS4(n + 8), SLOTS4(n + 12)
+constexpr cmTargetSpecialProperty SpecialPropertyTable[SpecialPropertySlots] =
+  { SLOTS16(0), SLOTS16(16), SLOTS16(32), SLOTS16(48) };
+#undef SLOTS16
+#undef SLOTS4
+}
+
+cmTargetSpecialProperty cmTargetPropertyComputer::LookupSpecialProperty(
+  std::string const& prop)
+{
+  if (prop.empty()) {
+    return cmTargetSpecialProperty::None;
+  }
+  cmTargetSpecialProperty const id =
+    SpecialPropertyTable[SpecialPropertyHash(prop.data(), prop.size())];
+  if (id != cmTargetSpecialProperty::None &&
+      prop == SpecialPropertyNames[static_cast<std::size_t>(id)]) {
+    return id;
+  }
+  return cmTargetSpecialProperty::None;
+}
+
 bool cmTargetPropertyComputer::HandleLocationPropertyPolicy(
   std::string const& tgtName, cmMessenger* messenger,
   cmListFileBacktrace const& context)
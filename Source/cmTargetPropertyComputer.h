@@ -14,6 +14,33 @@
 
 class cmMessenger;
 
+/** Target properties that are not simply stored in the property map
+    of a target.  */
+enum class cmTargetSpecialProperty
+{
+  None,
+  BINARY_DIR,
+  COMPILE_DEFINITIONS,
+  COMPILE_FEATURES,
+  COMPILE_OPTIONS,
+  CUDA_PTX_COMPILATION,
+  EXPORT_NAME,
+  IMPORTED,
+  IMPORTED_GLOBAL,
+  INCLUDE_DIRECTORIES,
+  LINK_DIRECTORIES,
+  LINK_LIBRARIES,
+  LINK_OPTIONS,
+  LOCATION,
+  MANUALLY_ADDED_DEPENDENCIES,
+  NAME,
+  PRECOMPILE_HEADERS,
+  PRECOMPILE_HEADERS_REUSE_FROM,
+  SOURCE_DIR,
+  SOURCES,
+  TYPE
+};
+
 class cmTargetPropertyComputer
 {
 public:
@@ -22,18 +49,24 @@ public:
                                  cmMessenger* messenger,
                                  cmListFileBacktrace const& context)
   {
-    if (const char* loc = GetLocation(tgt, prop, messenger, context)) {
+    cmTargetSpecialProperty const id = LookupSpecialProperty(prop);
+    if (const char* loc = GetLocation(tgt, prop, id, messenger, context)) {
       return loc;
     }
     if (cmSystemTools::GetFatalErrorOccured()) {
       return nullptr;
     }
-    if (prop == "SOURCES") {
+    if (id == cmTargetSpecialProperty::SOURCES) {
       return GetSources(tgt, messenger, context);
     }
     return nullptr;
   }
 
+  /** Look up a property name in a compile-time perfect hash table of
+      the special properties.  Returns None for other properties.  */
+  static cmTargetSpecialProperty LookupSpecialProperty(
+    std::string const& prop);
+
   static bool WhiteListedInterfaceProperty(const std::string& prop);
 
   static bool PassesWhitelist(cmStateEnums::TargetType tgtType,
@@ -53,6 +86,7 @@ private:
 
   template <typename Target>
   static const char* GetLocation(Target const* tgt, std::string const& prop,
+                                 cmTargetSpecialProperty id,
                                  cmMessenger* messenger,
                                  cmListFileBacktrace const& context)
 
@@ -64,8 +98,7 @@ private:
         tgt->GetType() == cmStateEnums::SHARED_LIBRARY ||
         tgt->GetType() == cmStateEnums::MODULE_LIBRARY ||
         tgt->GetType() == cmStateEnums::UNKNOWN_LIBRARY) {
-      static const std::string propLOCATION = "LOCATION";
-      if (prop == propLOCATION) {
+      if (id == cmTargetSpecialProperty::LOCATION) {
         if (!tgt->IsImported() &&
             !HandleLocationPropertyPolicy(tgt->GetName(), messenger,
                                           context)) {
@@ -25,6 +25,7 @@
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
 #include "cmMessenger.h"
+#include "cmPathCache.h"
 #include "cmState.h"
 #include "cmStateDirectory.h"
 #include "cmStringAlgorithms.h"
@@ -40,6 +41,7 @@
 
 #  include "cmFileAPI.h"
 #  include "cmGraphVizWriter.h"
+#  include "cmMemoryReport.h"
 #  include "cmVariableWatch.h"
 #  include <unordered_map>
 #endif
@@ -138,6 +140,7 @@ static void cmWarnUnusedCliWarning(const std::string& variable, int /*unused*/,
 
 cmake::cmake(Role role, cmState::Mode mode)
   : FileTimeCache(cm::make_unique<cmFileTimeCache>())
+  , PathCache(cm::make_unique<cmPathCache>())
 #ifndef CMAKE_BOOTSTRAP
   , VariableWatch(cm::make_unique<cmVariableWatch>())
 #endif
@@ -717,6 +720,16 @@ void cmake::SetArgs(const std::vector<std::string>& args)
         cmSystemTools::Error("No file specified for --graphviz");
         return;
       }
+    } else if (arg.find("--memory-report=", 0) == 0) {
+      std::string path = arg.substr(strlen("--memory-report="));
+      if (path.empty()) {
+        cmSystemTools::Error("No file specified for --memory-report");
+        return;
+      }
+      path = cmSystemTools::CollapseFullPath(path);
+      cmSystemTools::ConvertToUnixSlashes(path);
+      this->MemoryReportFile = path;
+      this->State->SetMeasureCommandBodies(true);
     } else if (arg.find("--debug-trycompile", 0) == 0) {
       std::cout << "debug trycompile on\n";
       this->DebugTryCompileOn();
@@ -1386,6 +1399,7 @@ int cmake::Configure()
   this->Messenger->SetDevWarningsAsErrors(value && cmIsOff(value));
 
   int ret = this->ActualConfigure();
+  this->SampleMemory("configure");
   const char* delCacheVars =
     this->State->GetGlobalProperty("__CMAKE_DELETE_CACHE_CHANGE_VARS_");
   if (delCacheVars && delCacheVars[0] != 0) {
@@ -1776,7 +1790,12 @@ int cmake::Generate()
   if (!this->GlobalGenerator->Compute()) {
     return -1;
   }
+  this->SampleMemory("compute");
   this->GlobalGenerator->Generate();
+  this->SampleMemory("generate");
+  if (this->GetDebugOutput()) {
+    this->PathCache->PrintStatistics(std::cout);
+  }
   if (!this->GraphVizFile.empty()) {
     std::cout << "Generate graphviz: " << this->GraphVizFile << std::endl;
     this->GenerateGraphViz(this->GraphVizFile);
@@ -1799,6 +1818,27 @@ int cmake::Generate()
   return 0;
 }
 
+void cmake::SampleMemory(std::string const& phase)
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->MemoryReportFile.empty()) {
+    return;
+  }
+  if (!this->MemoryReport) {
+    this->MemoryReport = cm::make_unique<cmMemoryReport>();
+  }
+  this->MemoryReport->Sample(phase, *this);
+  // Rewrite the report after each sample so that it is available
+  // even if a later step fails.
+  if (!this->MemoryReport->Write(this->MemoryReportFile)) {
+    cmSystemTools::Error(
+      cmStrCat("Could not write memory report: ", this->MemoryReportFile));
+  }
+#else
+  static_cast<void>(phase);
+#endif
+}
+
 void cmake::AddCacheEntry(const std::string& key, const char* value,
                           const char* helpString, int type)
 {
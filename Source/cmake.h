@@ -31,7 +31,9 @@ class cmFileTimeCache;
 class cmGlobalGenerator;
 class cmGlobalGeneratorFactory;
 class cmMakefile;
+class cmMemoryReport;
 class cmMessenger;
+class cmPathCache;
 class cmVariableWatch;
 struct cmDocumentationEntry;
 
@@ -380,6 +382,11 @@ public:
    */
   cmFileTimeCache* GetFileTimeCache() { return this->FileTimeCache.get(); }
 
+  /**
+   * Get the memoized path computations
+   */
+  cmPathCache* GetPathCache() { return this->PathCache.get(); }
+
   //! Get the selected log level for `message()` commands during the cmake run.
   LogLevel GetLogLevel() const { return this->MessageLogLevel; }
   void SetLogLevel(LogLevel level) { this->MessageLogLevel = level; }
@@ -545,6 +552,9 @@ protected:
 
   void GenerateGraphViz(const std::string& fileName) const;
 
+  //! Add a sample to the memory report, if requested, and write it.
+  void SampleMemory(std::string const& phase);
+
 private:
   ProgressCallbackType ProgressCallback;
   WorkingMode CurrentWorkingMode = NORMAL_MODE;
@@ -572,12 +582,15 @@ private:
   bool ClearBuildSystem = false;
   bool DebugTryCompile = false;
   std::unique_ptr<cmFileTimeCache> FileTimeCache;
+  std::unique_ptr<cmPathCache> PathCache;
   std::string GraphVizFile;
+  std::string MemoryReportFile;
   InstalledFilesMap InstalledFiles;
 
 #if !defined(CMAKE_BOOTSTRAP)
   std::unique_ptr<cmVariableWatch> VariableWatch;
   std::unique_ptr<cmFileAPI> FileAPI;
+  std::unique_ptr<cmMemoryReport> MemoryReport;
 #endif
 
   std::unique_ptr<cmState> State;
@@ -88,6 +88,8 @@ const char* cmDocumentationOptions[][2] = {
   { "--check-system-vars",
     "Find problems with variable usage in system "
     "files." },
+  { "--memory-report=<file>",
+    "Write the memory held by each subsystem to a JSON file." },
   { nullptr, nullptr }
 };
 
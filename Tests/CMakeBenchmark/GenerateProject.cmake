@@ -0,0 +1,164 @@
+# Generate a synthetic project for measuring how CMake scales.
+#
+# Usage:
+#   cmake -DBENCHMARK_DIR=<dir> [-D<option>=<value>...]
+#         -P GenerateProject.cmake
+#
+# Options:
+#   DIRECTORIES  Number of subdirectories holding the targets (default 10).
+#   TARGETS      Number of static libraries (default 100).
+#   SHAPE        Shape of the link graph:
+#                  chain   - each library links to the next one
+#                  fanout  - each library links to the FANOUT next ones
+#                  cycles  - groups of CYCLE libraries link to each other
+#                            in a cycle and to the next group
+#                (default chain).
+#   FANOUT       Number of dependencies of each library for the fanout
+#                shape (default 8).
+#   CYCLE        Number of libraries in each cycle for the cycles shape
+#                (default 4).
+#   GENEX        Number of usage requirements with a generator expression
+#                added to each library (default 2).
+#   SOURCES      Number of source files of each library (default 2).
+#
+# Libraries are distributed over the directories round-robin.  An
+# executable in the top directory links to the first library so that
+# the link closure covers the whole graph.
+
+if(NOT BENCHMARK_DIR)
+  message(FATAL_ERROR "BENCHMARK_DIR must be set.")
+endif()
+
+foreach(option_default
+    DIRECTORIES:10 TARGETS:100 SHAPE:chain FANOUT:8 CYCLE:4 GENEX:2 SOURCES:2)
+  string(REPLACE ":" ";" option_default "${option_default}")
+  list(GET option_default 0 option)
+  list(GET option_default 1 default)
+  if(NOT DEFINED ${option} OR "${${option}}" STREQUAL "")
+    set(${option} "${default}")
+  endif()
+endforeach()
+
+if(NOT SHAPE MATCHES "^(chain|fanout|cycles)$")
+  message(FATAL_ERROR "Unknown SHAPE \"${SHAPE}\".")
+endif()
+foreach(option DIRECTORIES TARGETS FANOUT CYCLE)
+  if(NOT ${option} MATCHES "^[1-9][0-9]*$")
+    message(FATAL_ERROR "${option} must be a positive integer.")
+  endif()
+endforeach()
+foreach(option GENEX SOURCES)
+  if(NOT ${option} MATCHES "^[0-9]+$")
+    message(FATAL_ERROR "${option} must be a non-negative integer.")
+  endif()
+endforeach()
+if(DIRECTORIES GREATER TARGETS)
+  set(DIRECTORIES ${TARGETS})
+endif()
+
+file(REMOVE_RECURSE "${BENCHMARK_DIR}")
+math(EXPR last_target "${TARGETS} - 1")
+math(EXPR last_dir "${DIRECTORIES} - 1")
+
+# Compute the libraries each library links to.
+function(get_dependencies i out)
+  set(deps "")
+  if(SHAPE STREQUAL "chain")
+    math(EXPR n "${i} + 1")
+    if(n LESS TARGETS)
+      list(APPEND deps ${n})
+    endif()
+  elseif(SHAPE STREQUAL "fanout")
+    foreach(k RANGE 1 ${FANOUT})
+      math(EXPR n "${i} + ${k}")
+      if(n LESS TARGETS)
+        list(APPEND deps ${n})
+      endif()
+    endforeach()
+  else()
+    # The last member of each group closes the cycle and links to the
+    # first member of the next group.
+    math(EXPR first "${i} / ${CYCLE} * ${CYCLE}")
+    math(EXPR n "${i} + 1")
+    math(EXPR end "${first} + ${CYCLE}")
+    if(n LESS end AND n LESS TARGETS)
+      list(APPEND deps ${n})
+    else()
+      if(NOT i EQUAL first)
+        list(APPEND deps ${first})
+      endif()
+      if(n LESS TARGETS)
+        list(APPEND deps ${n})
+      endif()
+    endif()
+  endif()
+  set(${out} "${deps}" PARENT_SCOPE)
+endfunction()
+
+# Add usage requirements with generator expressions of different kinds.
+function(get_genex_requirements i out)
+  set(code "")
+  if(GENEX GREATER 0)
+    math(EXPR last "${GENEX} - 1")
+    foreach(k RANGE 0 ${last})
+      math(EXPR kind "${k} % 3")
+      if(kind EQUAL 0)
+        string(APPEND code "target_compile_definitions(t${i} PUBLIC "
+          "\"$<$<CONFIG:Debug>:T${i}_DEBUG_${k}>\")\n")
+      elseif(kind EQUAL 1)
+        string(APPEND code "target_include_directories(t${i} PUBLIC "
+          "\"$<BUILD_INTERFACE:\${CMAKE_CURRENT_SOURCE_DIR}/t${i}_${k}>\")\n")
+      else()
+        string(APPEND code "target_compile_options(t${i} INTERFACE "
+          "\"$<$<COMPILE_LANGUAGE:C>:-DT${i}_${k}>\")\n")
+      endif()
+    endforeach()
+  endif()
+  set(${out} "${code}" PARENT_SCOPE)
+endfunction()
+
+foreach(d RANGE 0 ${last_dir})
+  set(dir_code_${d} "")
+endforeach()
+
+foreach(i RANGE 0 ${last_target})
+  math(EXPR d "${i} % ${DIRECTORIES}")
+  set(dir "${BENCHMARK_DIR}/d${d}")
+
+  set(sources "")
+  if(SOURCES GREATER 0)
+    math(EXPR last_source "${SOURCES} - 1")
+    foreach(s RANGE 0 ${last_source})
+      file(WRITE "${dir}/t${i}_s${s}.c" "int t${i}_s${s}(void)\n{\n  return ${s};\n}\n")
+      list(APPEND sources "t${i}_s${s}.c")
+    endforeach()
+  else()
+    file(WRITE "${dir}/t${i}.c" "int t${i}(void)\n{\n  return 0;\n}\n")
+    set(sources "t${i}.c")
+  endif()
+  string(REPLACE ";" " " sources "${sources}")
+
+  get_dependencies(${i} deps)
+  list(TRANSFORM deps PREPEND t)
+  string(REPLACE ";" " " deps "${deps}")
+  get_genex_requirements(${i} genex)
+
+  string(APPEND dir_code_${d} "add_library(t${i} STATIC ${sources})\n")
+  if(deps)
+    string(APPEND dir_code_${d} "target_link_libraries(t${i} PUBLIC ${deps})\n")
+  endif()
+  string(APPEND dir_code_${d} "${genex}")
+endforeach()
+
+set(top_code "cmake_minimum_required(VERSION 3.15)
+project(Benchmark C)
+")
+foreach(d RANGE 0 ${last_dir})
+  file(WRITE "${BENCHMARK_DIR}/d${d}/CMakeLists.txt" "${dir_code_${d}}")
+  string(APPEND top_code "add_subdirectory(d${d})\n")
+endforeach()
+string(APPEND top_code "add_executable(main main.c)
+target_link_libraries(main PRIVATE t0)
+")
+file(WRITE "${BENCHMARK_DIR}/main.c" "int main(void)\n{\n  return 0;\n}\n")
+file(WRITE "${BENCHMARK_DIR}/CMakeLists.txt" "${top_code}")
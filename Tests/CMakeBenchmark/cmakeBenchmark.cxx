@@ -0,0 +1,426 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cmsys/Directory.hxx"
+#include "cmsys/FStream.hxx"
+
+#include "cm_jsoncpp_reader.h"
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+#if defined(_WIN32)
+#  include "cmDuration.h"
+#else
+#  include <fcntl.h>
+#  include <sys/resource.h>
+#  include <sys/time.h>
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+const char* const Usage =
+  "Usage: cmakeBenchmark --cmake=<exe> --suite=<file> --output=<file>\n"
+  "                      --work-dir=<dir> [--generator=<name>]...\n"
+  "                      [--script=<file>] [--repeat=<n>]\n"
+  "                      [--baseline=<file>]\n"
+  "\n"
+  "Generate the synthetic projects listed in the suite file, configure\n"
+  "and generate each of them with every generator, and write the wall\n"
+  "time, peak resident set size and size of the build tree as JSON.\n"
+  "A fresh build tree is measured once.  Running CMake again on the\n"
+  "existing build tree is measured <n> times (default 3).  If a\n"
+  "baseline written by an earlier run is given, print the changes.\n";
+
+struct Options
+{
+  std::string CMake;
+  std::string Suite;
+  std::string Script;
+  std::string Output;
+  std::string WorkDir;
+  std::string Baseline;
+  std::vector<std::string> Generators;
+  int Repeat = 3;
+};
+
+struct Measurement
+{
+  bool Okay = false;
+  double Seconds = 0;
+  // Peak resident set size in KiB or -1 if unknown.
+  long PeakRSS = -1;
+};
+
+/** Run a command with its output appended to a log file.  */
+Measurement Run(std::vector<std::string> const& command,
+                std::string const& logFile)
+{
+  Measurement m;
+  auto const start = std::chrono::steady_clock::now();
+#if defined(_WIN32)
+  std::string output;
+  int retVal = 0;
+  m.Okay = cmSystemTools::RunSingleCommand(command, &output, &output, &retVal,
+                                           nullptr, cmSystemTools::OUTPUT_NONE,
+                                           cmDuration::zero()) &&
+    retVal == 0;
+  cmsys::ofstream log(logFile.c_str(), std::ios::app);
+  log << output;
+#else
+  std::vector<char*> argv;
+  for (std::string const& arg : command) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  pid_t const pid = fork();
+  if (pid < 0) {
+    return m;
+  }
+  if (pid == 0) {
+    int const fd =
+      open(logFile.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+    if (fd >= 0) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+
+  // Unlike getrusage, wait4 reports the usage of this child alone.
+  int status = 0;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) != pid) {
+    return m;
+  }
+  m.Okay = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#  if defined(__APPLE__)
+  m.PeakRSS = static_cast<long>(usage.ru_maxrss / 1024);
+#  else
+  m.PeakRSS = static_cast<long>(usage.ru_maxrss);
+#  endif
+#endif
+  m.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start)
+                .count();
+  return m;
+}
+
+/** Count the files below a directory and their total size.  */
+void MeasureTree(std::string const& dir, Json::UInt64& files,
+                 Json::UInt64& bytes)
+{
+  cmsys::Directory d;
+  d.Load(dir);
+  for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
+    std::string const name = d.GetFile(i);
+    if (name == "." || name == "..") {
+      continue;
+    }
+    std::string const path = cmStrCat(dir, '/', name);
+    if (cmSystemTools::FileIsSymlink(path)) {
+      continue;
+    }
+    if (cmSystemTools::FileIsDirectory(path)) {
+      MeasureTree(path, files, bytes);
+    } else {
+      ++files;
+      bytes += cmSystemTools::FileLength(path);
+    }
+  }
+}
+
+Json::Value ToJson(Measurement const& m)
+{
+  Json::Value value = Json::objectValue;
+  value["seconds"] = m.Seconds;
+  if (m.PeakRSS >= 0) {
+    value["peakRSS"] = Json::Int64(m.PeakRSS);
+  } else {
+    value["peakRSS"] = Json::nullValue;
+  }
+  return value;
+}
+
+std::string MakeDirName(std::string const& name)
+{
+  std::string result = name;
+  std::replace_if(result.begin(), result.end(),
+                  [](char c) {
+                    return !(std::isalnum(static_cast<unsigned char>(c)) ||
+                             c == '-' || c == '_');
+                  },
+                  '_');
+  return result;
+}
+
+bool GenerateProject(Options const& options, Json::Value const& project,
+                     std::string const& sourceDir, std::string const& logFile)
+{
+  std::vector<std::string> command;
+  command.push_back(options.CMake);
+  command.push_back(cmStrCat("-DBENCHMARK_DIR=", sourceDir));
+  for (std::string const& key : project.getMemberNames()) {
+    if (key == "name") {
+      continue;
+    }
+    command.push_back(cmStrCat("-D", cmSystemTools::UpperCase(key), '=',
+                               project[key].asString()));
+  }
+  command.push_back("-P");
+  command.push_back(options.Script);
+  return Run(command, logFile).Okay;
+}
+
+bool RunSuite(Options const& options, Json::Value const& suite,
+              Json::Value& results)
+{
+  for (Json::Value const& project : suite["projects"]) {
+    std::string const name = project["name"].asString();
+    std::string const projectDir =
+      cmStrCat(options.WorkDir, '/', MakeDirName(name));
+    std::string const sourceDir = cmStrCat(projectDir, "/src");
+    std::string const logFile = cmStrCat(projectDir, "/benchmark.log");
+    cmSystemTools::RemoveADirectory(projectDir);
+    cmSystemTools::MakeDirectory(projectDir);
+
+    std::cout << "Generating project " << name << std::endl;
+    if (!GenerateProject(options, project, sourceDir, logFile)) {
+      std::cerr << "Failed to generate project " << name << ", see "
+                << logFile << std::endl;
+      return false;
+    }
+
+    for (std::string const& generator : options.Generators) {
+      std::string const buildDir =
+        cmStrCat(projectDir, "/build-", MakeDirName(generator));
+      std::vector<std::string> const command = {
+        options.CMake, "-G", generator, "-S", sourceDir, "-B", buildDir
+      };
+
+      std::cout << "  " << generator << ": fresh" << std::flush;
+      Measurement const fresh = Run(command, logFile);
+      if (!fresh.Okay) {
+        std::cout << std::endl;
+        std::cerr << "CMake failed for project " << name << " with "
+                  << generator << ", see " << logFile << std::endl;
+        return false;
+      }
+      std::cout << ' ' << fresh.Seconds << " s" << std::flush;
+
+      // Take the fastest of the repeated runs as the least disturbed one.
+      Measurement rerun;
+      for (int i = 0; i < options.Repeat; ++i) {
+        Measurement const m = Run(command, logFile);
+        if (!m.Okay) {
+          std::cout << std::endl;
+          std::cerr << "CMake failed for project " << name << " with "
+                    << generator << ", see " << logFile << std::endl;
+          return false;
+        }
+        if (!rerun.Okay || m.Seconds < rerun.Seconds) {
+          rerun.Seconds = m.Seconds;
+        }
+        rerun.PeakRSS = std::max(rerun.PeakRSS, m.PeakRSS);
+        rerun.Okay = true;
+      }
+      if (rerun.Okay) {
+        std::cout << ", rerun " << rerun.Seconds << " s";
+      }
+      std::cout << std::endl;
+
+      Json::UInt64 files = 0;
+      Json::UInt64 bytes = 0;
+      MeasureTree(buildDir, files, bytes);
+
+      Json::Value result = Json::objectValue;
+      result["project"] = name;
+      result["parameters"] = project;
+      result["generator"] = generator;
+      result["fresh"] = ToJson(fresh);
+      if (rerun.Okay) {
+        result["rerun"] = ToJson(rerun);
+      }
+      result["outputFiles"] = files;
+      result["outputBytes"] = bytes;
+      results.append(std::move(result));
+    }
+  }
+  return true;
+}
+
+std::string FormatChange(double before, double after)
+{
+  char buf[64];
+  if (before > 0) {
+    snprintf(buf, sizeof(buf), "%+.1f%%", (after - before) / before * 100);
+  } else {
+    snprintf(buf, sizeof(buf), "n/a");
+  }
+  return buf;
+}
+
+void CompareWithBaseline(Json::Value const& results,
+                         Json::Value const& baseline)
+{
+  std::cout << "\nChanges relative to the baseline:\n";
+  for (Json::Value const& result : results) {
+    Json::Value const* base = nullptr;
+    for (Json::Value const& b : baseline["results"]) {
+      if (b["project"] == result["project"] &&
+          b["generator"] == result["generator"]) {
+        base = &b;
+        break;
+      }
+    }
+    if (!base) {
+      continue;
+    }
+    for (const char* run : { "fresh", "rerun" }) {
+      Json::Value const& after = result[run];
+      Json::Value const& before = (*base)[run];
+      if (!after.isObject() || !before.isObject()) {
+        continue;
+      }
+      std::cout << "  " << result["project"].asString() << " / "
+                << result["generator"].asString() << " " << run << ": "
+                << FormatChange(before["seconds"].asDouble(),
+                                after["seconds"].asDouble())
+                << " time";
+      if (after["peakRSS"].isNumeric() && before["peakRSS"].isNumeric()) {
+        std::cout << ", "
+                  << FormatChange(before["peakRSS"].asDouble(),
+                                  after["peakRSS"].asDouble())
+                  << " peak RSS";
+      }
+      std::cout << "\n";
+    }
+    std::cout << "  " << result["project"].asString() << " / "
+              << result["generator"].asString() << " output: "
+              << FormatChange((*base)["outputBytes"].asDouble(),
+                              result["outputBytes"].asDouble())
+              << " bytes\n";
+  }
+}
+
+bool ReadJson(std::string const& file, Json::Value& value)
+{
+  cmsys::ifstream fin(file.c_str());
+  Json::CharReaderBuilder rbuilder;
+  std::string errors;
+  if (!fin || !Json::parseFromStream(rbuilder, fin, &value, &errors)) {
+    std::cerr << "Failed to read " << file << "\n" << errors;
+    return false;
+  }
+  return true;
+}
+
+bool ParseArguments(int argc, char* argv[], Options& options)
+{
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    auto value = [&arg](const char* prefix, std::string& out) -> bool {
+      size_t const n = strlen(prefix);
+      if (arg.compare(0, n, prefix) != 0) {
+        return false;
+      }
+      out = arg.substr(n);
+      return true;
+    };
+    std::string generator;
+    std::string repeat;
+    if (value("--cmake=", options.CMake) || value("--suite=", options.Suite) ||
+        value("--script=", options.Script) ||
+        value("--output=", options.Output) ||
+        value("--work-dir=", options.WorkDir) ||
+        value("--baseline=", options.Baseline)) {
+      continue;
+    }
+    if (value("--generator=", generator)) {
+      options.Generators.push_back(generator);
+    } else if (value("--repeat=", repeat)) {
+      options.Repeat = atoi(repeat.c_str());
+    } else {
+      std::cerr << "Unknown argument: " << arg << "\n";
+      return false;
+    }
+  }
+  if (options.CMake.empty() || options.Suite.empty() ||
+      options.Output.empty() || options.WorkDir.empty() ||
+      options.Repeat < 0) {
+    return false;
+  }
+  if (options.Script.empty()) {
+    options.Script = cmStrCat(
+      cmSystemTools::GetFilenamePath(options.Suite), "/GenerateProject.cmake");
+  }
+  if (options.Generators.empty()) {
+    options.Generators.emplace_back("Unix Makefiles");
+  }
+  options.CMake = cmSystemTools::CollapseFullPath(options.CMake);
+  options.WorkDir = cmSystemTools::CollapseFullPath(options.WorkDir);
+  return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << Usage;
+    return 1;
+  }
+
+  Json::Value suite;
+  if (!ReadJson(options.Suite, suite)) {
+    return 1;
+  }
+  Json::Value baseline;
+  if (!options.Baseline.empty() && !ReadJson(options.Baseline, baseline)) {
+    return 1;
+  }
+
+  Json::Value results = Json::arrayValue;
+  if (!RunSuite(options, suite, results)) {
+    return 1;
+  }
+
+  Json::Value root = Json::objectValue;
+  root["cmake"] = options.CMake;
+  root["results"] = results;
+  cmsys::ofstream fout(options.Output.c_str());
+  Json::StreamWriterBuilder wbuilder;
+  wbuilder["indentation"] = "  ";
+  std::unique_ptr<Json::StreamWriter> writer(wbuilder.newStreamWriter());
+  writer->write(root, &fout);
+  fout << "\n";
+  if (!fout) {
+    std::cerr << "Failed to write " << options.Output << "\n";
+    return 1;
+  }
+
+  if (!options.Baseline.empty()) {
+    CompareWithBaseline(results, baseline);
+  }
+  return 0;
+}
@@ -0,0 +1,449 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+// Time the primitives the configure and generate steps spend most of
+// their time in.  Each benchmark runs its body in batches large enough
+// to take a measurable time.  The median time per iteration over the
+// batches is reported, which is stable across runs on a quiet machine.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cmsys/FStream.hxx"
+#include "cmsys/RegularExpression.hxx"
+
+#include "cmDefinitions.h"
+#include "cmGeneratorExpression.h"
+#include "cmJsonStreamWriter.h"
+#include "cmLinkedTree.h"
+#include "cmListFileCache.h"
+#include "cmMessenger.h"
+#include "cmOutputConverter.h"
+#include "cmState.h"
+#include "cmStateSnapshot.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+namespace {
+
+// Results are accumulated here so the compiler cannot drop the work.
+std::size_t volatile Sink;
+
+struct Benchmark
+{
+  std::string Name;
+  // Run the measured operation the given number of times.
+  std::function<void(std::size_t)> Run;
+};
+
+struct Options
+{
+  std::string Filter;
+  double MinTime = 0.5;
+  std::size_t Samples = 7;
+};
+
+double TimeBatch(Benchmark const& b, std::size_t iterations)
+{
+  auto const start = std::chrono::steady_clock::now();
+  b.Run(iterations);
+  auto const stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+void Measure(Benchmark const& b, Options const& options)
+{
+  // Grow the batch until it takes long enough to time reliably.  This
+  // also warms up the caches and the allocator.
+  double const batchTime = options.MinTime / options.Samples;
+  std::size_t iterations = 1;
+  for (;;) {
+    double const t = TimeBatch(b, iterations);
+    if (t >= batchTime || iterations >= (std::size_t(1) << 30)) {
+      break;
+    }
+    std::size_t const factor = t > 0 ? std::size_t(batchTime / t * 1.2) : 10;
+    iterations *= std::min(std::max(factor, std::size_t(2)), std::size_t(10));
+  }
+
+  std::vector<double> perIteration;
+  for (std::size_t i = 0; i < options.Samples; ++i) {
+    perIteration.push_back(TimeBatch(b, iterations) / iterations * 1e9);
+  }
+  std::sort(perIteration.begin(), perIteration.end());
+  double const median = perIteration[perIteration.size() / 2];
+  double const spread = median > 0
+    ? (perIteration.back() - perIteration.front()) / median * 100
+    : 0;
+
+  std::cout << std::left << std::setw(40) << b.Name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(14) << median
+            << " ns" << std::setw(14) << perIteration.front() << " ns"
+            << std::setw(9) << spread << " %" << std::setw(12) << iterations
+            << std::endl;
+}
+
+std::vector<std::string> MakeList(std::size_t n)
+{
+  std::vector<std::string> list;
+  list.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    list.push_back(cmStrCat("element_", i));
+  }
+  return list;
+}
+
+void AddListBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  for (std::size_t n : { 8, 1000 }) {
+    auto const list = std::make_shared<std::string>(cmJoin(MakeList(n), ";"));
+    benchmarks.push_back(
+      { cmStrCat("cmExpandList/", n), [list](std::size_t iters) {
+         std::vector<std::string> out;
+         for (std::size_t i = 0; i < iters; ++i) {
+           out.clear();
+           cmExpandList(*list, out);
+           Sink = Sink + out.size();
+         }
+       } });
+
+    auto const elements =
+      std::make_shared<std::vector<std::string>>(MakeList(n));
+    benchmarks.push_back(
+      { cmStrCat("cmJoin/", n), [elements](std::size_t iters) {
+         for (std::size_t i = 0; i < iters; ++i) {
+           Sink = Sink + cmJoin(*elements, ";").size();
+         }
+       } });
+  }
+}
+
+// A stack of variable scopes like the one of nested function calls.
+struct DefinitionStack
+{
+  explicit DefinitionStack(std::size_t depth)
+  {
+    this->Top = this->Tree.Push(this->Tree.Root());
+    for (std::size_t i = 0; i < 100; ++i) {
+      this->Top->Set(cmStrCat("GLOBAL_", i), "value");
+    }
+    for (std::size_t d = 1; d < depth; ++d) {
+      this->Top = this->Tree.Push(this->Top);
+      for (std::size_t i = 0; i < 10; ++i) {
+        this->Top->Set(cmStrCat("LOCAL_", d, '_', i), "value");
+      }
+    }
+  }
+
+  cmLinkedTree<cmDefinitions> Tree;
+  cmLinkedTree<cmDefinitions>::iterator Top;
+};
+
+void AddDefinitionsBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  for (std::size_t depth : { 1, 8, 64 }) {
+    auto const stack = std::make_shared<DefinitionStack>(depth);
+    std::string const suffix = cmStrCat("/depth", depth);
+
+    // The variable is defined in the outermost scope.  Each lookup is
+    // made from a new innermost scope, like a function call makes it, so
+    // that no lookup can take what an earlier one left in a scope.
+    benchmarks.push_back(
+      { "cmDefinitions::Get" + suffix, [stack](std::size_t iters) {
+         std::string const key = "GLOBAL_42";
+         auto const end = stack->Tree.Root();
+         for (std::size_t i = 0; i < iters; ++i) {
+           auto const top = stack->Tree.Push(stack->Top);
+           Sink = Sink + cmDefinitions::Get(key, top, end)->size();
+           stack->Tree.Pop(top);
+         }
+       } });
+
+    benchmarks.push_back(
+      { "cmDefinitions::Get(undefined)" + suffix,
+        [stack](std::size_t iters) {
+          std::string const key = "UNDEFINED";
+          auto const end = stack->Tree.Root();
+          for (std::size_t i = 0; i < iters; ++i) {
+            auto const top = stack->Tree.Push(stack->Top);
+            Sink = Sink + (cmDefinitions::Get(key, top, end) ? 1 : 0);
+            stack->Tree.Pop(top);
+          }
+        } });
+
+    benchmarks.push_back(
+      { "cmDefinitions::Set" + suffix, [stack](std::size_t iters) {
+         std::string const key = "LOOP_VAR";
+         std::string value;
+         for (std::size_t i = 0; i < iters; ++i) {
+           value = (i & 1) ? "a" : "b";
+           stack->Top->Set(key, value);
+         }
+       } });
+  }
+}
+
+void AddRegularExpressionBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  static char const pattern[] = "^([A-Za-z_][A-Za-z0-9_]*)=(.*)$";
+  benchmarks.push_back(
+    { "RegularExpression::compile", [](std::size_t iters) {
+       for (std::size_t i = 0; i < iters; ++i) {
+         cmsys::RegularExpression regex;
+         Sink = Sink + (regex.compile(pattern) ? 1 : 0);
+       }
+     } });
+
+  auto const input =
+    std::make_shared<std::string>(std::string(1000, 'x') + "KEY=value");
+  benchmarks.push_back(
+    { "RegularExpression::find/1k", [input](std::size_t iters) {
+       cmsys::RegularExpression regex("[A-Z]+=([a-z]+)$");
+       for (std::size_t i = 0; i < iters; ++i) {
+         Sink = Sink + (regex.find(*input) ? regex.end() : 0);
+       }
+     } });
+}
+
+void AddGeneratorExpressionBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  static char const input[] =
+    "$<$<CONFIG:Debug>:DEBUG_MODE>;"
+    "$<$<BOOL:ON>:$<JOIN:a;b;c,->>;"
+    "$<IF:$<STREQUAL:x,y>,first,$<LOWER_CASE:SECOND>>;"
+    "$<$<NOT:$<CONFIG:Release>>:-O0>";
+
+  // Identical inputs share a cached parse tree.  Clear the cache after
+  // each iteration to measure the full parse.
+  benchmarks.push_back(
+    { "cmGeneratorExpression::Parse", [](std::size_t iters) {
+       cmGeneratorExpression ge;
+       for (std::size_t i = 0; i < iters; ++i) {
+         Sink = Sink + ge.Parse(input)->GetHadContextSensitiveCondition();
+         cmGeneratorExpression::ClearParseTreeCache();
+       }
+     } });
+
+  benchmarks.push_back(
+    { "cmGeneratorExpression::Parse(cached)", [](std::size_t iters) {
+       cmGeneratorExpression ge;
+       for (std::size_t i = 0; i < iters; ++i) {
+         Sink = Sink + ge.Parse(input)->GetHadContextSensitiveCondition();
+       }
+       cmGeneratorExpression::ClearParseTreeCache();
+     } });
+
+  // None of the expressions used need a local generator.
+  benchmarks.push_back(
+    { "cmCompiledGeneratorExpression::Evaluate", [](std::size_t iters) {
+       cmGeneratorExpression ge;
+       auto cge = ge.Parse(input);
+       std::string const config = "Debug";
+       for (std::size_t i = 0; i < iters; ++i) {
+         Sink = Sink + cge->Evaluate(nullptr, config).size();
+       }
+       cmGeneratorExpression::ClearParseTreeCache();
+     } });
+}
+
+void AddOutputConverterBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  auto const state = std::make_shared<cmState>();
+  auto const converter =
+    std::make_shared<cmOutputConverter>(state->CreateBaseSnapshot());
+
+  std::vector<std::pair<std::string, std::string>> const inputs = {
+    { "plain", "-DSOME_DEFINITION=1" },
+    { "quoted", "-DMESSAGE=\"Hello, World!\" with spaces & $specials" },
+    { "path", "/home/user/projects/some project/build/CMakeFiles/out.o" },
+  };
+  for (auto const& in : inputs) {
+    auto const arg = std::make_shared<std::string>(in.second);
+    benchmarks.push_back(
+      { "cmOutputConverter::EscapeForShell/" + in.first,
+        [state, converter, arg](std::size_t iters) {
+          for (std::size_t i = 0; i < iters; ++i) {
+            Sink = Sink + converter->EscapeForShell(*arg).size();
+          }
+        } });
+  }
+}
+
+void AddCollapseFullPathBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  benchmarks.push_back(
+    { "cmSystemTools::CollapseFullPath/absolute", [](std::size_t iters) {
+       std::string const path = "/home/user/src/./project/../project/a/b.c";
+       for (std::size_t i = 0; i < iters; ++i) {
+         Sink = Sink + cmSystemTools::CollapseFullPath(path).size();
+       }
+     } });
+
+  benchmarks.push_back(
+    { "cmSystemTools::CollapseFullPath/relative", [](std::size_t iters) {
+       std::string const path = "../../include/./detail/../header.h";
+       std::string const base = "/home/user/src/project/lib/sub";
+       for (std::size_t i = 0; i < iters; ++i) {
+         Sink = Sink + cmSystemTools::CollapseFullPath(path, base).size();
+       }
+     } });
+}
+
+void AddJsonWriterBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  // An array of source objects as found in a file API target reply.
+  std::size_t const sources = 1000;
+
+  benchmarks.push_back(
+    { "Json::StreamWriter/sources", [sources](std::size_t iters) {
+       Json::StreamWriterBuilder builder;
+       builder["indentation"] = "\t";
+       std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+       for (std::size_t i = 0; i < iters; ++i) {
+         Json::Value array = Json::arrayValue;
+         for (std::size_t j = 0; j < sources; ++j) {
+           Json::Value source = Json::objectValue;
+           source["path"] = "src/dir/source" + std::to_string(j) + ".cxx";
+           source["backtrace"] = static_cast<Json::ArrayIndex>(j);
+           source["compileGroupIndex"] = 0;
+           array.append(std::move(source)); // NOLINT(*)
+         }
+         std::ostringstream out;
+         writer->write(array, &out);
+         Sink = Sink + out.str().size();
+       }
+     } });
+
+  benchmarks.push_back(
+    { "cmJsonStreamWriter/sources", [sources](std::size_t iters) {
+       for (std::size_t i = 0; i < iters; ++i) {
+         std::ostringstream out;
+         cmJsonStreamWriter writer(out);
+         writer.BeginArray();
+         for (std::size_t j = 0; j < sources; ++j) {
+           writer.BeginObject();
+           writer.Key("backtrace");
+           writer.Value(static_cast<Json::ArrayIndex>(j));
+           writer.Key("compileGroupIndex");
+           writer.Value(0);
+           writer.Key("path");
+           writer.Value("src/dir/source" + std::to_string(j) + ".cxx");
+           writer.EndObject();
+         }
+         writer.EndArray();
+         Sink = Sink + out.str().size();
+       }
+     } });
+}
+
+bool AddListFileParserBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+  // A listfile with many commands of the kinds seen in real projects.
+  auto const path = std::make_shared<std::string>(
+    cmSystemTools::GetCurrentWorkingDirectory() + "/benchCMakeLib.cmake");
+  {
+    cmsys::ofstream fout(path->c_str());
+    for (std::size_t i = 0; i < 2000; ++i) {
+      fout << "# Library " << i << "\n"
+           << "add_library(lib" << i << " STATIC src/a" << i << ".c src/b"
+           << i << ".c)\n"
+           << "target_link_libraries(lib" << i << " PUBLIC lib" << i + 1
+           << " \"${OTHER_LIBS}\")\n"
+           << "if(ENABLE_" << i << " AND NOT DISABLE_ALL)\n"
+           << "  set_property(TARGET lib" << i << " PROPERTY FOLDER [[libs/"
+           << i << "]])\n"
+           << "endif()\n";
+    }
+    if (!fout) {
+      std::cerr << "Cannot write " << *path << "\n";
+      return false;
+    }
+  }
+
+  benchmarks.push_back(
+    { "cmListFileParser/12k-lines", [path](std::size_t iters) {
+       cmMessenger messenger;
+       for (std::size_t i = 0; i < iters; ++i) {
+         cmListFile listFile;
+         listFile.ParseFile(path->c_str(), &messenger, cmListFileBacktrace());
+         Sink = Sink + listFile.Functions.size();
+       }
+     } });
+  return true;
+}
+
+void Usage(char const* argv0)
+{
+  std::cerr << "Usage: " << argv0
+            << " [--filter=<regex>] [--min-time=<seconds>]"
+               " [--samples=<n>]\n";
+}
+}
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    if (cmHasLiteralPrefix(arg, "--filter=")) {
+      options.Filter = arg.substr(9);
+    } else if (cmHasLiteralPrefix(arg, "--min-time=")) {
+      options.MinTime = std::atof(arg.c_str() + 11);
+    } else if (cmHasLiteralPrefix(arg, "--samples=")) {
+      long const samples = std::atol(arg.c_str() + 10);
+      if (samples < 1) {
+        Usage(argv[0]);
+        return 1;
+      }
+      options.Samples = std::size_t(samples);
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+
+  cmsys::RegularExpression filter;
+  if (!options.Filter.empty() && !filter.compile(options.Filter)) {
+    std::cerr << "Invalid filter \"" << options.Filter << "\"\n";
+    return 1;
+  }
+
+  std::vector<Benchmark> benchmarks;
+  AddListBenchmarks(benchmarks);
+  AddDefinitionsBenchmarks(benchmarks);
+  AddRegularExpressionBenchmarks(benchmarks);
+  AddGeneratorExpressionBenchmarks(benchmarks);
+  AddOutputConverterBenchmarks(benchmarks);
+  AddCollapseFullPathBenchmarks(benchmarks);
+  AddJsonWriterBenchmarks(benchmarks);
+  if (!AddListFileParserBenchmarks(benchmarks)) {
+    return 1;
+  }
+
+  std::cout << std::left << std::setw(40) << "Benchmark" << std::right
+            << std::setw(17) << "Median" << std::setw(17) << "Min"
+            << std::setw(11) << "Spread" << std::setw(12) << "Iterations"
+            << std::endl;
+  for (Benchmark const& b : benchmarks) {
+    if (options.Filter.empty() || filter.find(b.Name)) {
+      Measure(b, options);
+    }
+  }
+
+  cmSystemTools::RemoveFile(
+    cmSystemTools::GetCurrentWorkingDirectory() + "/benchCMakeLib.cmake");
+  return 0;
+}
@@ -0,0 +1,75 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include "cmArena.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define ASSERT_TRUE(x)                                                        \
+  do {                                                                        \
+    if (!(x)) {                                                               \
+      std::cout << "ASSERT_TRUE(" #x ") failed on line " << __LINE__ << "\n"; \
+      return -1;                                                              \
+    }                                                                         \
+  } while (false)
+
+namespace {
+std::vector<int> destroyed;
+
+struct Tracked
+{
+  Tracked(int id, std::string name)
+    : Id(id)
+    , Name(std::move(name))
+  {
+  }
+  ~Tracked() { destroyed.push_back(this->Id); }
+
+  int Id;
+  std::string Name;
+};
+
+struct alignas(32) Aligned
+{
+  char Data[3];
+};
+
+bool IsAligned(void const* p, std::size_t align)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+}
+
+int testArena(int /*unused*/, char* /*unused*/ [])
+{
+  {
+    cmArena arena(64);
+    Tracked* a = arena.New<Tracked>(1, "first");
+    int* i = arena.New<int>(42);
+    Tracked* b = arena.New<Tracked>(2, std::string(100, 'x'));
+    // Larger than a block.
+    char* big = static_cast<char*>(arena.Allocate(1000, 1));
+    Tracked* c = arena.New<Tracked>(3, "third");
+    Aligned* d = arena.New<Aligned>();
+
+    ASSERT_TRUE(a->Id == 1 && a->Name == "first");
+    ASSERT_TRUE(*i == 42);
+    ASSERT_TRUE(b->Id == 2 && b->Name.size() == 100);
+    ASSERT_TRUE(c->Id == 3 && c->Name == "third");
+    ASSERT_TRUE(IsAligned(i, alignof(int)));
+    ASSERT_TRUE(IsAligned(a, alignof(Tracked)));
+    ASSERT_TRUE(IsAligned(d, 32));
+    big[0] = big[999] = 'y';
+    ASSERT_TRUE(destroyed.empty());
+  }
+
+  // Objects are destroyed in reverse order of creation.
+  std::vector<int> const expect = { 3, 2, 1 };
+  ASSERT_TRUE(destroyed == expect);
+
+  return 0;
+}
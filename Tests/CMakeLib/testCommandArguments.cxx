@@ -0,0 +1,163 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cmExecutionStatus.h"
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmMakefile.h"
+#include "cmState.h"
+#include "cmake.h"
+
+#define ASSERT_TRUE(x)                                                        \
+  do {                                                                        \
+    if (!(x)) {                                                               \
+      std::cout << "ASSERT_TRUE(" #x ") failed on line " << __LINE__ << "\n"; \
+      return -1;                                                              \
+    }                                                                         \
+  } while (false)
+
+// Count the allocations made through operator new.  This replaces the
+// global operator new, so this test is built as its own executable.
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t /*unused*/) noexcept
+{
+  std::free(p);
+}
+
+namespace {
+std::vector<std::string> const* received = nullptr;
+
+bool RecordArguments(std::vector<std::string> const& args,
+                     cmExecutionStatus& /*unused*/)
+{
+  received = &args;
+  return true;
+}
+
+cmListFileFunction MakeCall(std::vector<cmListFileArgument> args)
+{
+  cmListFileFunction lff;
+  lff.Name = "record_args";
+  lff.Line = 1;
+  lff.Arguments = std::move(args);
+  return lff;
+}
+
+// A call with the given number of literal arguments, all too long for
+// the small string optimization.
+cmListFileFunction MakeLiteralCall(
+  int n,
+  std::string const& value = "a-literal-argument-longer-than-a-small-string-")
+{
+  static cmListFileArgument::Delimiter const delims[] = {
+    cmListFileArgument::Unquoted, cmListFileArgument::Quoted,
+    cmListFileArgument::Bracket
+  };
+  std::vector<cmListFileArgument> args;
+  for (int i = 0; i < n; ++i) {
+    args.emplace_back(value + std::to_string(i), delims[i % 3], 1);
+  }
+  return MakeCall(std::move(args));
+}
+
+// Allocations made by executing a call after it has run before.
+std::size_t CountAllocations(cmMakefile& mf, cmListFileFunction const& lff)
+{
+  cmExecutionStatus warmup(mf);
+  mf.ExecuteCommand(lff, warmup);
+  cmExecutionStatus status(mf);
+  std::size_t const before = allocations;
+  mf.ExecuteCommand(lff, status);
+  return allocations - before;
+}
+}
+
+int main()
+{
+  cmake cm(cmake::RoleScript, cmState::Script);
+  cm.GetState()->AddBuiltinCommand("record_args", &RecordArguments);
+  cmGlobalGenerator gg(&cm);
+  cmMakefile mf(&gg, cm.GetCurrentSnapshot());
+  mf.AddDefinition("LIST", "first-list-element;second-list-element");
+
+  // Arguments are expanded as before.
+  {
+    cmListFileFunction const lff = MakeCall(
+      { { "a;b", cmListFileArgument::Unquoted, 1 },
+        { "x;y", cmListFileArgument::Quoted, 1 },
+        { "${LIST}", cmListFileArgument::Unquoted, 1 },
+        { "${LIST}", cmListFileArgument::Quoted, 1 },
+        { "", cmListFileArgument::Unquoted, 1 },
+        { "${LIST}", cmListFileArgument::Bracket, 1 },
+        { "", cmListFileArgument::Quoted, 1 } });
+    cmExecutionStatus status(mf);
+    ASSERT_TRUE(mf.ExecuteCommand(lff, status));
+    std::vector<std::string> const expect = {
+      "a",
+      "b",
+      "x;y",
+      "first-list-element",
+      "second-list-element",
+      "first-list-element;second-list-element",
+      "${LIST}",
+      ""
+    };
+    ASSERT_TRUE(received && *received == expect);
+  }
+
+  // Literal arguments do not cost allocations once the argument buffer
+  // has grown to hold them.  Allow for a few allocations made by the
+  // execution of a call, but far fewer than one per argument.
+  std::size_t const one = CountAllocations(mf, MakeLiteralCall(1));
+  std::size_t const many = CountAllocations(mf, MakeLiteralCall(60));
+  if (many > one + 10) {
+    std::cout << "Executing a call with 1 literal argument allocated " << one
+              << " times but one with 60 literal arguments allocated "
+              << many << " times.\n";
+    return -1;
+  }
+  ASSERT_TRUE(received && received->size() == 60);
+
+  // The memory of very long arguments is not kept after the call.
+  {
+    cmExecutionStatus status(mf);
+    ASSERT_TRUE(mf.ExecuteCommand(
+      MakeLiteralCall(3, std::string(100000, 'x')), status));
+    ASSERT_TRUE(received && received->size() == 3);
+    for (std::string const& arg : *received) {
+      ASSERT_TRUE(arg.capacity() < 100000);
+    }
+  }
+
+  // Nor is the memory of very many arguments.
+  {
+    cmExecutionStatus status(mf);
+    ASSERT_TRUE(mf.ExecuteCommand(MakeLiteralCall(10000), status));
+    ASSERT_TRUE(received && received->capacity() < 10000);
+  }
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include "cmCompileCommandsShards.h"
+
+#include "cm_jsoncpp_reader.h"
+#include "cm_jsoncpp_value.h"
+
+#include "cmsys/FStream.hxx"
+
+#include <iostream>
+#include <string>
+
+#include "cmSystemTools.h"
+
+#define ASSERT_TRUE(x)                                                        \
+  do {                                                                        \
+    if (!(x)) {                                                               \
+      std::cout << "ASSERT_TRUE(" #x ") failed on line " << __LINE__ << "\n"; \
+      return false;                                                           \
+    }                                                                         \
+  } while (false)
+
+namespace {
+bool ReadJson(std::string const& file, Json::Value& value)
+{
+  cmsys::ifstream fin(file.c_str());
+  Json::Reader reader;
+  return fin && reader.parse(fin, value, false);
+}
+
+bool testReturningShard()
+{
+  std::string const dir =
+    cmSystemTools::GetCurrentWorkingDirectory() + "/testCompileCommandsShards";
+  cmSystemTools::RemoveADirectory(dir);
+  ASSERT_TRUE(cmSystemTools::MakeDirectory(dir));
+  std::string const a = dir + "/a.json";
+  std::string const b = dir + "/b.json";
+
+  // The commands of shard "a" do not come in consecutively.
+  cmCompileCommandsShards shards;
+  shards.Add(a, dir, "cc -c a1.c", "a1.c");
+  shards.Add(a, dir, "cc -c a2.c", "a2.c");
+  shards.Add(b, dir, "cc -c b1.c", "b1.c");
+  shards.Add(a, dir, "cc -c a3.c", "a3.c");
+  shards.Write(dir, false);
+
+  Json::Value value;
+  ASSERT_TRUE(ReadJson(a, value));
+  ASSERT_TRUE(value.isArray() && value.size() == 3);
+  ASSERT_TRUE(value[0]["file"].asString() == "a1.c");
+  ASSERT_TRUE(value[1]["file"].asString() == "a2.c");
+  ASSERT_TRUE(value[2]["file"].asString() == "a3.c");
+  ASSERT_TRUE(ReadJson(b, value));
+  ASSERT_TRUE(value.isArray() && value.size() == 1);
+
+  // Each shard is listed once.
+  ASSERT_TRUE(ReadJson(dir + "/compile_commands_shards.json", value));
+  Json::Value const& list = value["shards"];
+  ASSERT_TRUE(list.isArray() && list.size() == 2);
+  ASSERT_TRUE(list[0].asString() == "a.json");
+  ASSERT_TRUE(list[1].asString() == "b.json");
+  return true;
+}
+}
+
+int testCompileCommandsShards(int /*unused*/, char* /*unused*/ [])
+{
+  if (!testReturningShard()) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,152 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include "cmJsonStreamWriter.h"
+
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#define ASSERT_TRUE(x)                                                        \
+  do {                                                                        \
+    if (!(x)) {                                                               \
+      std::cout << "ASSERT_TRUE(" #x ") failed on line " << __LINE__ << "\n"; \
+      return false;                                                           \
+    }                                                                         \
+  } while (false)
+
+namespace {
+std::string WriteJsonCpp(Json::Value const& value)
+{
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "\t";
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  std::ostringstream out;
+  writer->write(value, &out);
+  return out.str();
+}
+
+bool Check(Json::Value const& value, std::string const& streamed)
+{
+  std::string const expect = WriteJsonCpp(value);
+  if (streamed != expect) {
+    std::cout << "Expected:\n" << expect << "\nActual:\n" << streamed << "\n";
+    return false;
+  }
+  return true;
+}
+
+Json::Value BuildSample()
+{
+  Json::Value root = Json::objectValue;
+  root["name"] = "sample \"quoted\"\n\ttext";
+  root["count"] = 3;
+  root["index"] = Json::ArrayIndex(7);
+  root["ratio"] = 0.5;
+  root["enabled"] = true;
+  root["none"] = Json::Value();
+  root["emptyArray"] = Json::arrayValue;
+  root["emptyObject"] = Json::objectValue;
+  Json::Value& list = root["list"] = Json::arrayValue;
+  list.append(1);
+  list.append("two");
+  list.append(Json::arrayValue);
+  Json::Value& nested = list.append(Json::arrayValue);
+  nested.append(false);
+  Json::Value& object = list.append(Json::objectValue);
+  object["b"] = "second";
+  object["a"] = "first";
+  root["child"]["grandchild"]["leaf"] = "value";
+  return root;
+}
+
+bool testScalarRoot()
+{
+  std::ostringstream out;
+  cmJsonStreamWriter writer(out);
+  writer.Value("text");
+  ASSERT_TRUE(Check("text", out.str()));
+  return true;
+}
+
+bool testValue()
+{
+  Json::Value const sample = BuildSample();
+  std::ostringstream out;
+  cmJsonStreamWriter writer(out);
+  writer.Value(sample);
+  ASSERT_TRUE(Check(sample, out.str()));
+  return true;
+}
+
+bool testStreamed()
+{
+  // Write the sample member by member, in name order.
+  std::ostringstream out;
+  cmJsonStreamWriter writer(out);
+  writer.BeginObject();
+  writer.Key("child");
+  writer.BeginObject();
+  writer.Key("grandchild");
+  writer.BeginObject();
+  writer.Key("leaf");
+  writer.Value("value");
+  writer.EndObject();
+  writer.EndObject();
+  writer.Key("count");
+  writer.Value(3);
+  writer.Key("emptyArray");
+  writer.BeginArray();
+  writer.EndArray();
+  writer.Key("emptyObject");
+  writer.BeginObject();
+  writer.EndObject();
+  writer.Key("enabled");
+  writer.Value(true);
+  writer.Key("index");
+  writer.Value(7u);
+  writer.Key("list");
+  writer.BeginArray();
+  writer.Value(1);
+  writer.Value(std::string("two"));
+  writer.BeginArray();
+  writer.EndArray();
+  writer.BeginArray();
+  writer.Value(false);
+  writer.EndArray();
+  writer.BeginObject();
+  writer.Key("a");
+  writer.Value("first");
+  writer.Key("b");
+  writer.Value("second");
+  writer.EndObject();
+  writer.EndArray();
+  writer.Key("name");
+  writer.Value("sample \"quoted\"\n\ttext");
+  writer.Key("none");
+  writer.Value(Json::Value());
+  writer.Key("ratio");
+  writer.Value(Json::Value(0.5));
+  writer.EndObject();
+  ASSERT_TRUE(Check(BuildSample(), out.str()));
+  return true;
+}
+}
+
+int testJsonStreamWriter(int /*unused*/, char* /*unused*/ [])
+{
+  if (!testScalarRoot()) {
+    return 1;
+  }
+  if (!testValue()) {
+    return 1;
+  }
+  if (!testStreamed()) {
+    return 1;
+  }
+  return 0;
+}
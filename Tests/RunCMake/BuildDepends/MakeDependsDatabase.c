@@ -0,0 +1,5 @@
+#include "MakeDependsDatabase.h"
+int main(void)
+{
+  return MAKE_DEPENDS_DATABASE;
+}
@@ -0,0 +1,14 @@
+enable_language(C)
+set(CMAKE_DEPENDS_USE_DATABASE ON)
+
+include_directories(${CMAKE_CURRENT_BINARY_DIR}/include)
+add_executable(main ${CMAKE_CURRENT_SOURCE_DIR}/MakeDependsDatabase.c)
+
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+  \"$<TARGET_FILE:main>|${CMAKE_CURRENT_BINARY_DIR}/include/MakeDependsDatabase.h\"
+  )
+set(check_exes
+  \"$<TARGET_FILE:main>\"
+  )
+")
@@ -0,0 +1,3 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/MakeDependsDatabase.h" [[
+#define MAKE_DEPENDS_DATABASE 2
+]])
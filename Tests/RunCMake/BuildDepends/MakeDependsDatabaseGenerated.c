@@ -0,0 +1,5 @@
+#include "MakeDependsDatabaseGenerated.h"
+int main(void)
+{
+  return MAKE_DEPENDS_DATABASE_GENERATED;
+}
@@ -0,0 +1,33 @@
+enable_language(C)
+set(CMAKE_DEPENDS_USE_DATABASE ON)
+
+add_custom_command(
+  OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/include/MakeDependsDatabaseGenerated.h
+  COMMAND ${CMAKE_COMMAND} -E copy
+    ${CMAKE_CURRENT_BINARY_DIR}/MakeDependsDatabaseGenerated.h.in
+    ${CMAKE_CURRENT_BINARY_DIR}/include/MakeDependsDatabaseGenerated.h
+  DEPENDS ${CMAKE_CURRENT_BINARY_DIR}/MakeDependsDatabaseGenerated.h.in
+  )
+
+include_directories(${CMAKE_CURRENT_BINARY_DIR}/include)
+add_executable(main
+  ${CMAKE_CURRENT_SOURCE_DIR}/MakeDependsDatabaseGenerated.c
+  ${CMAKE_CURRENT_BINARY_DIR}/include/MakeDependsDatabaseGenerated.h
+  )
+
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+  \"$<TARGET_FILE:main>|${CMAKE_CURRENT_BINARY_DIR}/include/MakeDependsDatabaseGenerated.h\"
+  \"${CMAKE_CURRENT_BINARY_DIR}/include/MakeDependsDatabaseGenerated.h|${CMAKE_CURRENT_BINARY_DIR}/MakeDependsDatabaseGenerated.h.in\"
+  )
+set(check_exes
+  \"$<TARGET_FILE:main>\"
+  )
+file(STRINGS \"${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/main.dir/depend.make\" rules
+  REGEX \"MakeDependsDatabaseGenerated[.]h\")
+if(NOT rules)
+  string(APPEND RunCMake_TEST_FAILED \"
+ depend.make does not name the generated header
+\")
+endif()
+")
@@ -0,0 +1,3 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeDependsDatabaseGenerated.h.in" [[
+#define MAKE_DEPENDS_DATABASE_GENERATED 2
+]])
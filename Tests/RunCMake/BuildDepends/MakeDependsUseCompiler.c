@@ -0,0 +1,5 @@
+#include "MakeDependsUseCompiler.h"
+int main(void)
+{
+  return MAKE_DEPENDS_USE_COMPILER;
+}
@@ -0,0 +1,3 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/MakeDependsUseCompiler.h" [[
+#define MAKE_DEPENDS_USE_COMPILER 2
+]])
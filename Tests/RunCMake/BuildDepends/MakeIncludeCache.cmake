@@ -0,0 +1,17 @@
+enable_language(C)
+
+include_directories(${CMAKE_CURRENT_BINARY_DIR}/include)
+add_executable(main1 ${CMAKE_CURRENT_SOURCE_DIR}/MakeIncludeCache1.c)
+add_executable(main2 ${CMAKE_CURRENT_SOURCE_DIR}/MakeIncludeCache2.c)
+
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+  \"$<TARGET_FILE:main1>|${CMAKE_CURRENT_BINARY_DIR}/include/MakeIncludeCache.h\"
+  \"$<TARGET_FILE:main2>|${CMAKE_CURRENT_BINARY_DIR}/include/MakeIncludeCache.h\"
+  )
+set(check_exes
+  \"$<TARGET_FILE:main1>\"
+  \"$<TARGET_FILE:main2>\"
+  )
+include(\"${CMAKE_CURRENT_SOURCE_DIR}/check-include-cache.cmake\")
+")
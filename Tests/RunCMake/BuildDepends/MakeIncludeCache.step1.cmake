@@ -0,0 +1,6 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/MakeIncludeCache.h" [[
+#include "MakeIncludeCacheOld.h"
+]])
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/MakeIncludeCacheOld.h" [[
+#define MAKE_INCLUDE_CACHE 1
+]])
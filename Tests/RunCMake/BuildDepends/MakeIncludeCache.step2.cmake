@@ -0,0 +1,4 @@
+file(REMOVE "${RunCMake_TEST_BINARY_DIR}/include/MakeIncludeCacheOld.h")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/MakeIncludeCache.h" [[
+#define MAKE_INCLUDE_CACHE 2
+]])
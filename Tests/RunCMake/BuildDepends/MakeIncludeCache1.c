@@ -0,0 +1,5 @@
+#include "MakeIncludeCache.h"
+int main(void)
+{
+  return MAKE_INCLUDE_CACHE;
+}
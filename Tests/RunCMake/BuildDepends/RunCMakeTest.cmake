@@ -60,6 +60,10 @@ unset(RunCMake_TEST_SOURCE_DIR)
 
 if(RunCMake_GENERATOR MATCHES "Make")
   run_BuildDepends(MakeCustomIncludes)
+  run_BuildDepends(MakeDependsDatabase)
+  run_BuildDepends(MakeDependsDatabaseGenerated)
+  run_BuildDepends(MakeDependsUseCompiler)
+  run_BuildDepends(MakeIncludeCache)
   if(NOT "${RunCMake_BINARY_DIR}" STREQUAL "${RunCMake_SOURCE_DIR}")
     run_BuildDepends(MakeInProjectOnly)
   endif()
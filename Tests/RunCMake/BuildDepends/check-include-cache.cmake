@@ -0,0 +1,29 @@
+# The targets share one include cache.  It must hold the entries of
+# both, and the entry of a header that changed must be replaced.
+set(cache "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/C.includecache")
+if(NOT EXISTS "${cache}")
+  string(APPEND RunCMake_TEST_FAILED "
+ '${cache}' missing
+")
+  return()
+endif()
+file(STRINGS "${cache}" entries)
+foreach(f MakeIncludeCache1.c MakeIncludeCache2.c include/MakeIncludeCache.h)
+  if(NOT ";${entries};" MATCHES "[;/]${f};")
+    string(APPEND RunCMake_TEST_FAILED "
+ '${cache}' has no entry for '${f}'
+")
+  endif()
+endforeach()
+# The header includes MakeIncludeCacheOld.h only in the first step.
+if(check_step EQUAL 1)
+  if(NOT ";${entries};" MATCHES ";MakeIncludeCacheOld.h;")
+    string(APPEND RunCMake_TEST_FAILED "
+ '${cache}' has no include of 'MakeIncludeCacheOld.h'
+")
+  endif()
+elseif(";${entries};" MATCHES ";MakeIncludeCacheOld.h;")
+  string(APPEND RunCMake_TEST_FAILED "
+ '${cache}' still has the include of the removed 'MakeIncludeCacheOld.h'
+")
+endif()
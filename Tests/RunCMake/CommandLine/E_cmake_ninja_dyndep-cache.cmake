@@ -0,0 +1,67 @@
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/dyndep")
+file(REMOVE_RECURSE "${dir}")
+file(MAKE_DIRECTORY "${dir}")
+file(WRITE "${dir}/Fortran.tdi" "{
+  \"dir-cur-bld\": \"${dir}\",
+  \"dir-cur-src\": \"${dir}\",
+  \"dir-top-bld\": \"${dir}\",
+  \"dir-top-src\": \"${dir}\",
+  \"module-dir\": \"\",
+  \"linked-target-dirs\": []
+}")
+file(WRITE "${dir}/a.ddi"
+  "{\"object\": \"a.o\", \"provides\": [\"m1.mod\"], \"requires\": []}")
+file(WRITE "${dir}/b.ddi"
+  "{\"object\": \"b.o\", \"provides\": [], \"requires\": [\"m1.mod\"]}")
+
+function(dyndep)
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} -E cmake_ninja_dyndep
+      --tdi=Fortran.tdi --lang=Fortran --dd=${dir}/Fortran.dd ${ARGN}
+    WORKING_DIRECTORY "${dir}"
+    RESULT_VARIABLE result
+    )
+  if(result)
+    message(FATAL_ERROR "cmake_ninja_dyndep failed: ${result}")
+  endif()
+endfunction()
+
+function(expect file regex)
+  file(READ "${dir}/${file}" content)
+  if(NOT content MATCHES "${regex}")
+    message(FATAL_ERROR "${file} does not match\n  ${regex}\n${content}")
+  endif()
+endfunction()
+
+set(cache "${dir}/FortranDyndepCache.txt")
+
+# The first run parses both ddi files and caches what they contain.
+dyndep(a.ddi b.ddi)
+expect(Fortran.dd "build a.o \\| m1\\.mod: dyndep")
+expect(FortranDyndepCache.txt "a\\.ddi\n[0-9]+\na\\.o\n1\nm1\\.mod\n0\n")
+
+# An unchanged ddi file is taken from the cache without being parsed, and
+# the cache is not rewritten when nothing changed.
+file(READ "${cache}" content)
+string(REPLACE "\na.o\n" "\ncached.o\n" content "${content}")
+file(WRITE "${cache}" "${content}")
+dyndep(a.ddi b.ddi)
+expect(Fortran.dd "build cached\\.o \\| m1\\.mod: dyndep")
+file(READ "${cache}" unchanged)
+if(NOT unchanged STREQUAL content)
+  message(FATAL_ERROR "Cache was rewritten although no ddi changed.")
+endif()
+
+# A changed ddi file is parsed again.
+file(WRITE "${dir}/b.ddi"
+  "{\"object\": \"c.o\", \"provides\": [], \"requires\": [\"m1.mod\"]}")
+dyndep(a.ddi b.ddi)
+expect(Fortran.dd "build c\\.o: dyndep \\| m1\\.mod")
+expect(FortranDyndepCache.txt "b\\.ddi\n[0-9]+\nc\\.o\n")
+
+# Entries of ddi files that are no longer used are dropped.
+dyndep(a.ddi)
+file(READ "${cache}" content)
+if(content MATCHES "b\\.ddi")
+  message(FATAL_ERROR "Cache still has an entry for b.ddi:\n${content}")
+endif()
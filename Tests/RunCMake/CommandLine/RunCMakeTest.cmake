@@ -400,6 +400,8 @@ run_cmake_command(E_sleep-bad-arg1 ${CMAKE_COMMAND} -E sleep x)
 run_cmake_command(E_sleep-bad-arg2 ${CMAKE_COMMAND} -E sleep 1 -1)
 run_cmake_command(E_sleep-one-tenth ${CMAKE_COMMAND} -E sleep 0.1)
 
+run_cmake_command(E_cmake_ninja_dyndep-cache ${CMAKE_COMMAND} -P ${RunCMake_SOURCE_DIR}/E_cmake_ninja_dyndep-cache.cmake)
+
 run_cmake_command(P_directory ${CMAKE_COMMAND} -P ${RunCMake_SOURCE_DIR})
 run_cmake_command(P_working-dir ${CMAKE_COMMAND} -DEXPECTED_WORKING_DIR=${RunCMake_BINARY_DIR}/P_working-dir-build -P ${RunCMake_SOURCE_DIR}/P_working-dir.cmake)
 # Documented to return the same result as above even if -S and -B are set to something else.
@@ -522,6 +524,11 @@ set(RunCMake_TEST_OPTIONS --debug-trycompile)
 run_cmake(debug-trycompile)
 unset(RunCMake_TEST_OPTIONS)
 
+set(RunCMake_TEST_OPTIONS --memory-report=memory.json)
+run_cmake(memory-report)
+unset(RunCMake_TEST_OPTIONS)
+run_cmake_command(memory-report-empty ${CMAKE_COMMAND} --memory-report=)
+
 function(run_cmake_depends)
   set(RunCMake_TEST_SOURCE_DIR "${RunCMake_SOURCE_DIR}/cmake_depends")
   set(RunCMake_TEST_BINARY_DIR "${RunCMake_BINARY_DIR}/cmake_depends-build")
@@ -0,0 +1,26 @@
+set(report "${RunCMake_TEST_BINARY_DIR}/memory.json")
+if(NOT EXISTS "${report}")
+  set(RunCMake_TEST_FAILED "Memory report not written:\n  ${report}")
+  return()
+endif()
+file(READ "${report}" content)
+
+set(expected
+  "\"phase\" : \"configure\""
+  "\"phase\" : \"compute\""
+  "\"phase\" : \"generate\""
+  "\"definitions\" :"
+  "\"snapshots\" :"
+  "\"command-bodies\" :"
+  "\"source-files\" :"
+  "\"generator-targets\" :"
+  "\"link-caches\" :"
+  "\"parse-trees\" :"
+  )
+foreach(e IN LISTS expected)
+  string(FIND "${content}" "${e}" pos)
+  if(pos EQUAL -1)
+    set(RunCMake_TEST_FAILED "Memory report does not contain\n  ${e}\n")
+    return()
+  endif()
+endforeach()
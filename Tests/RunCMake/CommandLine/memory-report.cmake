@@ -0,0 +1,10 @@
+function(add_echo_target name)
+  add_custom_target(${name}
+    COMMAND ${CMAKE_COMMAND} -E echo "$<TARGET_PROPERTY:${name},NAME>"
+    SOURCES memory-report.cmake
+    )
+endfunction()
+
+add_echo_target(foo)
+add_echo_target(bar)
+add_dependencies(bar foo)
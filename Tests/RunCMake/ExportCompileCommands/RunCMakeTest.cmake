@@ -0,0 +1,14 @@
+include(RunCMake)
+
+run_cmake(ShardsTarget)
+
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ShardsDirectory-build)
+run_cmake(ShardsDirectory)
+set(RunCMake_TEST_NO_CLEAN 1)
+# Let the time stamp of a rewritten shard differ.
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.1)
+run_cmake(ShardsDirectory-rerun)
+run_cmake(ShardsDirectory-off)
+run_cmake(ShardsDirectory-on)
+unset(RunCMake_TEST_NO_CLEAN)
+unset(RunCMake_TEST_BINARY_DIR)
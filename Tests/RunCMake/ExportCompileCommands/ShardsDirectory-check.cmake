@@ -0,0 +1,16 @@
+include(${CMAKE_CURRENT_LIST_DIR}/check-shards.cmake)
+check_shards(
+  CMakeFiles/compile_commands.json top.c
+  sub/CMakeFiles/compile_commands.json sub.c
+  )
+if(RunCMake_TEST_FAILED)
+  return()
+endif()
+
+# Record the shard times to compare after regenerating.
+foreach(shard CMakeFiles sub/CMakeFiles)
+  file(TIMESTAMP "${RunCMake_TEST_BINARY_DIR}/${shard}/compile_commands.json"
+    time "%s")
+  list(APPEND times "${time}")
+endforeach()
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/shard-times.txt" "${times}")
@@ -0,0 +1,5 @@
+if(EXISTS "${RunCMake_TEST_BINARY_DIR}/compile_commands_shards.json")
+  set(RunCMake_TEST_FAILED "The index of the earlier shards was not removed.")
+elseif(NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/compile_commands.json")
+  set(RunCMake_TEST_FAILED "No top-level compile_commands.json was written.")
+endif()
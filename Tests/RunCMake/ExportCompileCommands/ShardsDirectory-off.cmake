@@ -0,0 +1,3 @@
+set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
+add_library(top STATIC top.c)
+add_subdirectory(sub)
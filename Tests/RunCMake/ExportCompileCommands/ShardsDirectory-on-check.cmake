@@ -0,0 +1,6 @@
+# The top-level compile_commands.json of the previous run must be gone.
+include(${CMAKE_CURRENT_LIST_DIR}/check-shards.cmake)
+check_shards(
+  CMakeFiles/compile_commands.json top.c
+  sub/CMakeFiles/compile_commands.json sub.c
+  )
@@ -0,0 +1 @@
+include(ShardsDirectory.cmake)
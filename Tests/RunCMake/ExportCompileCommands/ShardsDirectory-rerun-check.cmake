@@ -0,0 +1,23 @@
+include(${CMAKE_CURRENT_LIST_DIR}/check-shards.cmake)
+check_shards(
+  CMakeFiles/compile_commands.json top.c
+  sub/CMakeFiles/compile_commands.json sub.c
+  )
+if(RunCMake_TEST_FAILED)
+  return()
+endif()
+
+file(READ "${RunCMake_TEST_BINARY_DIR}/shard-times.txt" times)
+list(GET times 0 top_time)
+list(GET times 1 sub_time)
+file(TIMESTAMP "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/compile_commands.json"
+  time "%s")
+if(NOT time STREQUAL top_time)
+  set(RunCMake_TEST_FAILED "The unchanged top-level shard was rewritten.")
+  return()
+endif()
+file(READ "${RunCMake_TEST_BINARY_DIR}/sub/CMakeFiles/compile_commands.json"
+  content)
+if(NOT content MATCHES "-DCHANGE_SUB")
+  set(RunCMake_TEST_FAILED "The changed shard was not rewritten:\n${content}")
+endif()
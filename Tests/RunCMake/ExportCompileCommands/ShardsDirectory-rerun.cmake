@@ -0,0 +1,2 @@
+set(CHANGE_SUB 1)
+include(ShardsDirectory.cmake)
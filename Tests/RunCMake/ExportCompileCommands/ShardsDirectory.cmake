@@ -0,0 +1,4 @@
+set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
+set(CMAKE_EXPORT_COMPILE_COMMANDS_SHARDS DIRECTORY)
+add_library(top STATIC top.c)
+add_subdirectory(sub)
@@ -0,0 +1,5 @@
+include(${CMAKE_CURRENT_LIST_DIR}/check-shards.cmake)
+check_shards(
+  CMakeFiles/top.dir/compile_commands.json top.c
+  CMakeFiles/other.dir/compile_commands.json sub.c
+  )
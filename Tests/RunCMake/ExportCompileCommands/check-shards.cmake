@@ -0,0 +1,37 @@
+# Check that the index lists the given shards and that each of them holds
+# the compile command of the given source.  Arguments are pairs of a shard
+# relative to the build tree and the name of a source file.
+function(check_shards)
+  set(index "${RunCMake_TEST_BINARY_DIR}/compile_commands_shards.json")
+  if(NOT EXISTS "${index}")
+    set(RunCMake_TEST_FAILED "Index is missing:\n  ${index}" PARENT_SCOPE)
+    return()
+  endif()
+  if(EXISTS "${RunCMake_TEST_BINARY_DIR}/compile_commands.json")
+    set(RunCMake_TEST_FAILED "Unsharded compile_commands.json was written."
+      PARENT_SCOPE)
+    return()
+  endif()
+  file(READ "${index}" index_content)
+  while(ARGN)
+    list(GET ARGN 0 shard)
+    list(GET ARGN 1 source)
+    list(REMOVE_AT ARGN 0 1)
+    if(NOT index_content MATCHES "\n    \"${shard}\"")
+      set(RunCMake_TEST_FAILED
+        "Index does not list ${shard}:\n${index_content}" PARENT_SCOPE)
+      return()
+    endif()
+    set(file "${RunCMake_TEST_BINARY_DIR}/${shard}")
+    if(NOT EXISTS "${file}")
+      set(RunCMake_TEST_FAILED "Shard is missing:\n  ${file}" PARENT_SCOPE)
+      return()
+    endif()
+    file(READ "${file}" content)
+    if(NOT content MATCHES "^\\[\n{\n  \"directory\": \"[^\"]*\",\n  \"command\": \"[^\"]*\",\n  \"file\": \"[^\"]*/${source}\"\n}\n\\]\n$")
+      set(RunCMake_TEST_FAILED "Shard ${shard} does not match:\n${content}"
+        PARENT_SCOPE)
+      return()
+    endif()
+  endwhile()
+endfunction()
@@ -0,0 +1 @@
+int sub(void) { return 0; }
@@ -0,0 +1 @@
+int top(void) { return 0; }
@@ -0,0 +1,13 @@
+enable_language(C)
+
+string(TOLOWER ${CMAKE_C_COMPILER_ID} lc_test)
+if (lc_test STREQUAL CMAKE_C_COMPILER_ID)
+  string(TOUPPER ${CMAKE_C_COMPILER_ID} lc_test)
+endif()
+
+# The policy warning is issued each time the interface of the dependency
+# is evaluated for the consumer.
+add_library(iface INTERFACE)
+target_compile_definitions(iface INTERFACE Result=$<C_COMPILER_ID:${lc_test}>)
+add_library(consumer empty.c)
+target_link_libraries(consumer PRIVATE iface)
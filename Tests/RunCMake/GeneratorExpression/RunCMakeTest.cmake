@@ -13,6 +13,7 @@ run_cmake(BadTargetTypeObject)
 run_cmake(BadInstallPrefix)
 run_cmake(BadSHELL_PATH)
 run_cmake(CMP0044-WARN)
+run_cmake(CMP0044-WARN-interface)
 run_cmake(NonValidTarget-C_COMPILER_ID)
 run_cmake(NonValidTarget-CXX_COMPILER_ID)
 run_cmake(NonValidTarget-Fortran_COMPILER_ID)
@@ -107,3 +108,12 @@ run_cmake(CMP0085-WARN)
 set(RunCMake_TEST_OPTIONS -DCMAKE_POLICY_DEFAULT_CMP0085:STRING=NEW)
 run_cmake(CMP0085-NEW)
 unset(RunCMake_TEST_OPTIONS)
+
+function(run_GeneratorExpression_build case)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/${case}-build)
+  run_cmake(${case})
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(${case}-build ${CMAKE_COMMAND} --build . --config Debug)
+endfunction()
+
+run_GeneratorExpression_build(TARGET_PROPERTY-interface-directory)
@@ -0,0 +1,11 @@
+enable_language(C)
+
+# The interface of a target is evaluated in the directory of each
+# consumer, so the name of the imported target refers to a different
+# target in each directory.
+add_library(common INTERFACE)
+set_property(TARGET common PROPERTY INTERFACE_COMPILE_DEFINITIONS
+  "$<TARGET_PROPERTY:dep,INTERFACE_COMPILE_DEFINITIONS>")
+
+add_subdirectory(TARGET_PROPERTY-interface-directory/a)
+add_subdirectory(TARGET_PROPERTY-interface-directory/b)
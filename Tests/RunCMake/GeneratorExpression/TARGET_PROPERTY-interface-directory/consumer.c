@@ -0,0 +1,14 @@
+#if defined(EXPECT_A) && !defined(DIR_A)
+#  error "DIR_A is not defined"
+#endif
+#if defined(EXPECT_B) && !defined(DIR_B)
+#  error "DIR_B is not defined"
+#endif
+#if defined(DIR_A) && defined(DIR_B)
+#  error "DIR_A and DIR_B are both defined"
+#endif
+
+int main(void)
+{
+  return 0;
+}
@@ -1,3 +1,4 @@
 include(RunCMake)
 
 run_cmake(RelativeIncludeDir)
+run_cmake(SourceLookup)
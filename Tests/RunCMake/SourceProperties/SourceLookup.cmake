@@ -0,0 +1,29 @@
+# Check that looking up the given source gives the given label.
+function(check_label source expect)
+  get_property(label SOURCE "${source}" PROPERTY TEST_LABEL)
+  if(NOT label STREQUAL "${expect}")
+    message(SEND_ERROR
+      "Source '${source}' has label '${label}', not '${expect}'.")
+  endif()
+endfunction()
+
+# Sources with the same name in different directories are told apart by
+# their full paths, however they are named.
+foreach(d RANGE 1 20)
+  set_property(SOURCE dir${d}/same.c PROPERTY TEST_LABEL "dir${d}")
+endforeach()
+foreach(d RANGE 1 20)
+  check_label(dir${d}/same.c "dir${d}")
+  check_label(${CMAKE_CURRENT_SOURCE_DIR}/dir${d}/same.c "dir${d}")
+endforeach()
+
+# A source named without its extension matches one named with it.
+set_property(SOURCE ext/known.c PROPERTY TEST_LABEL "known")
+check_label(ext/known "known")
+
+# A source first named without its extension is found by its full name,
+# and then by its full path.
+set_property(SOURCE ext/unknown PROPERTY TEST_LABEL "unknown")
+check_label(ext/unknown.c "unknown")
+check_label(${CMAKE_CURRENT_SOURCE_DIR}/ext/unknown.c "unknown")
+check_label(ext/unknown "unknown")
@@ -0,0 +1,6 @@
+add_subdirectory(Prefetch)
+if(NOT TARGET prefetch_tgt OR NOT TARGET nested_tgt)
+  message(FATAL_ERROR "Targets of the subdirectory are missing.")
+endif()
+get_property(nested_cache CACHE NESTED_CACHE PROPERTY VALUE)
+message(STATUS "NESTED_CACHE='${nested_cache}'")
@@ -0,0 +1,4 @@
+function(helper_set_var)
+  set(HELPER_VAR 1 PARENT_SCOPE)
+endfunction()
+helper_set_var()
@@ -0,0 +1,6 @@
+extern int lib(void);
+
+int main(void)
+{
+  return lib();
+}
@@ -0,0 +1,14 @@
+enable_language(C)
+
+# The linker file of the library has a different name in every
+# configuration, so the link line of the executable must be evaluated
+# for each configuration separately.
+add_library(lib STATIC ConfigLinkerFile-lib.c)
+set_target_properties(lib PROPERTIES
+  OUTPUT_NAME_DEBUG lib_debug
+  OUTPUT_NAME_RELEASE lib_release
+  )
+
+add_executable(app ConfigLinkerFile-main.c)
+target_link_libraries(app PRIVATE $<TARGET_LINKER_FILE:lib>)
+add_dependencies(app lib)
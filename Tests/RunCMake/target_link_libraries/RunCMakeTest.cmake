@@ -20,3 +20,20 @@ run_cmake(StaticPrivateDepNotExported)
 run_cmake(StaticPrivateDepNotTarget)
 run_cmake(UNKNOWN-IMPORTED-GLOBAL)
 run_cmake(empty_keyword_args)
+run_cmake(StaticLibraryCycles)
+
+# Build each configuration in a fresh tree so that a library left behind
+# by another configuration cannot satisfy a wrong link line.
+function(run_ConfigLinkerFile config)
+  set(RunCMake_TEST_BINARY_DIR
+    ${RunCMake_BINARY_DIR}/ConfigLinkerFile-${config}-build)
+  if(NOT RunCMake_GENERATOR_IS_MULTI_CONFIG)
+    set(RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=${config})
+  endif()
+  run_cmake(ConfigLinkerFile)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(ConfigLinkerFile-${config}-build
+    ${CMAKE_COMMAND} --build . --config ${config})
+endfunction()
+run_ConfigLinkerFile(Debug)
+run_ConfigLinkerFile(Release)
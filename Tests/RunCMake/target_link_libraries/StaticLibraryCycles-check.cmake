@@ -0,0 +1,33 @@
+# Extract the final link line of the executable.
+string(FIND "${actual_stderr}" "target [main] links to:\n" pos)
+if(pos EQUAL -1)
+  set(RunCMake_TEST_FAILED "No link line reported for target main.")
+  return()
+endif()
+string(SUBSTRING "${actual_stderr}" ${pos} -1 block)
+string(FIND "${block}" "\n\n" end)
+string(SUBSTRING "${block}" 0 ${end} block)
+string(REGEX MATCHALL "  (target|item) \\[[^]\n]*\\]" lines "${block}")
+set(items "")
+foreach(line IN LISTS lines)
+  string(REGEX REPLACE "^  (target|item) \\[(.*)\\]$" "\\2" item "${line}")
+  list(APPEND items "${item}")
+endforeach()
+
+# Every library must appear and be followed by the library it links to.
+foreach(i RANGE 1 120)
+  list(FIND items lib${i} first)
+  if(first EQUAL -1)
+    set(RunCMake_TEST_FAILED "lib${i} is missing from the link line:\n${items}")
+    return()
+  endif()
+  math(EXPR next "${i} + 1")
+  if(next LESS_EQUAL 120)
+    list(SUBLIST items ${first} -1 rest)
+    list(FIND rest lib${next} found)
+    if(found EQUAL -1)
+      set(RunCMake_TEST_FAILED "lib${next} does not follow lib${i}:\n${items}")
+      return()
+    endif()
+  endif()
+endforeach()
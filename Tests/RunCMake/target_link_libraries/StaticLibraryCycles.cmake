@@ -0,0 +1,29 @@
+enable_language(C)
+
+# A deep stack of static libraries.  Every fifth library also links to
+# the one before it, which makes the pair a strongly connected
+# component.  All libraries link to plain items whose dependencies
+# have to be inferred.
+set(n 120)
+foreach(i RANGE 1 ${n})
+  add_library(lib${i} STATIC empty.c)
+endforeach()
+foreach(i RANGE 1 ${n})
+  math(EXPR next "${i} + 1")
+  math(EXPR prev "${i} - 1")
+  math(EXPR mod5 "${i} % 5")
+  math(EXPR mod7 "${i} % 7")
+  if(next LESS_EQUAL n)
+    target_link_libraries(lib${i} PUBLIC lib${next})
+  endif()
+  if(mod5 EQUAL 0)
+    target_link_libraries(lib${i} PUBLIC lib${prev})
+  endif()
+  target_link_libraries(lib${i} PUBLIC ext${mod7} ext${mod5})
+endforeach()
+
+add_executable(main empty.c)
+target_link_libraries(main PRIVATE lib1)
+
+# Report the final link line on stderr for the check script.
+set(CMAKE_LINK_DEPENDS_DEBUG_MODE 1)